@@ -0,0 +1,79 @@
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Eigen/Dense"
+
+#include "cell.h"
+#include "element.h"
+#include "factory.h"
+#include "node.h"
+
+namespace {
+// Create a cell of side 2 with nodes of a quadrilateral (ED2Q4) or a
+// hexahedron (ED3H8), a distorted cell moves its third node outwards so
+// points are mapped by Newton iterations instead of an affine transform
+template <unsigned Tdim>
+std::shared_ptr<mpm::Cell<Tdim>> cell(bool distorted) {
+  const std::vector<std::vector<double>> corners =
+      (Tdim == 2) ? std::vector<std::vector<double>>{{0, 0},
+                                                     {2, 0},
+                                                     {2, 2},
+                                                     {0, 2}}
+                  : std::vector<std::vector<double>>{
+                        {0, 0, 0}, {2, 0, 0}, {2, 2, 0}, {0, 2, 0},
+                        {0, 0, 2}, {2, 0, 2}, {2, 2, 2}, {0, 2, 2}};
+  const auto element = Factory<mpm::Element<Tdim>>::instance()->create(
+      (Tdim == 2) ? "ED2Q4" : "ED3H8");
+  auto cell = std::make_shared<mpm::Cell<Tdim>>(0, corners.size(), element);
+  for (unsigned n = 0; n < corners.size(); ++n) {
+    Eigen::Matrix<double, Tdim, 1> coords;
+    for (unsigned i = 0; i < Tdim; ++i) coords(i) = corners[n][i];
+    if (distorted && n == 2) coords.array() += 0.5;
+    cell->add_node(n, std::make_shared<mpm::Node<Tdim, Tdim, 1>>(n, coords));
+  }
+  cell->initialise();
+  return cell;
+}
+
+// Local coordinates of a point in a cell
+template <unsigned Tdim>
+void cell_transform_real_to_unit_cell(benchmark::State& state,
+                                      bool distorted) {
+  auto cell = ::cell<Tdim>(distorted);
+  Eigen::Matrix<double, Tdim, 1> point;
+  point.setConstant(0.75);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(cell->transform_real_to_unit_cell(point));
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Check if a point is in a cell
+template <unsigned Tdim>
+void cell_is_point_in_cell(benchmark::State& state, bool distorted) {
+  auto cell = ::cell<Tdim>(distorted);
+  Eigen::Matrix<double, Tdim, 1> point;
+  point.setConstant(0.75);
+  for (auto _ : state) benchmark::DoNotOptimize(cell->is_point_in_cell(point));
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Benchmarks of regular and distorted cells, named <kernel>/<dim>/<cell>
+const bool cell_benchmarks = []() {
+  for (const bool distorted : {false, true}) {
+    const std::string cell = distorted ? "distorted" : "regular";
+    benchmark::RegisterBenchmark(
+        ("cell_transform_real_to_unit_cell/2D/" + cell).c_str(),
+        cell_transform_real_to_unit_cell<2>, distorted);
+    benchmark::RegisterBenchmark(
+        ("cell_transform_real_to_unit_cell/3D/" + cell).c_str(),
+        cell_transform_real_to_unit_cell<3>, distorted);
+    benchmark::RegisterBenchmark(("cell_is_point_in_cell/2D/" + cell).c_str(),
+                                 cell_is_point_in_cell<2>, distorted);
+    benchmark::RegisterBenchmark(("cell_is_point_in_cell/3D/" + cell).c_str(),
+                                 cell_is_point_in_cell<3>, distorted);
+  }
+  return true;
+}();
+}  // namespace
@@ -0,0 +1,66 @@
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "Eigen/Dense"
+
+#include "element.h"
+#include "factory.h"
+
+namespace {
+// Local coordinates inside the unit cell
+template <unsigned Tdim>
+Eigen::Matrix<double, Tdim, 1> local_coordinates() {
+  Eigen::Matrix<double, Tdim, 1> xi;
+  xi.setConstant(0.25);
+  return xi;
+}
+
+// Shape functions of an element
+template <unsigned Tdim>
+void element_shapefn(benchmark::State& state, const std::string& type) {
+  const auto element = Factory<mpm::Element<Tdim>>::instance()->create(type);
+  const auto xi = local_coordinates<Tdim>();
+  for (auto _ : state) benchmark::DoNotOptimize(element->shapefn(xi));
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Gradient of shape functions of an element
+template <unsigned Tdim>
+void element_grad_shapefn(benchmark::State& state, const std::string& type) {
+  const auto element = Factory<mpm::Element<Tdim>>::instance()->create(type);
+  const auto xi = local_coordinates<Tdim>();
+  for (auto _ : state) benchmark::DoNotOptimize(element->grad_shapefn(xi));
+  state.SetItemsProcessed(state.iterations());
+}
+
+// B-matrix of an element
+template <unsigned Tdim>
+void element_bmatrix(benchmark::State& state, const std::string& type) {
+  const auto element = Factory<mpm::Element<Tdim>>::instance()->create(type);
+  const auto xi = local_coordinates<Tdim>();
+  for (auto _ : state) benchmark::DoNotOptimize(element->bmatrix(xi));
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Benchmarks of each element type, named <kernel>/<element>
+const bool element_benchmarks = []() {
+  for (const std::string type : {"ED2Q4", "ED2Q8", "ED2Q9"}) {
+    benchmark::RegisterBenchmark(("element_shapefn/" + type).c_str(),
+                                 element_shapefn<2>, type);
+    benchmark::RegisterBenchmark(("element_grad_shapefn/" + type).c_str(),
+                                 element_grad_shapefn<2>, type);
+    benchmark::RegisterBenchmark(("element_bmatrix/" + type).c_str(),
+                                 element_bmatrix<2>, type);
+  }
+  for (const std::string type : {"ED3H8", "ED3H20"}) {
+    benchmark::RegisterBenchmark(("element_shapefn/" + type).c_str(),
+                                 element_shapefn<3>, type);
+    benchmark::RegisterBenchmark(("element_grad_shapefn/" + type).c_str(),
+                                 element_grad_shapefn<3>, type);
+    benchmark::RegisterBenchmark(("element_bmatrix/" + type).c_str(),
+                                 element_bmatrix<3>, type);
+  }
+  return true;
+}();
+}  // namespace
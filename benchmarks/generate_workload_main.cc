@@ -0,0 +1,88 @@
+#include <string>
+
+#include <boost/filesystem.hpp>
+
+#include "spdlog/sinks/stdout_color_sinks.h"
+#include "spdlog/spdlog.h"
+#include "tclap/CmdLine.h"
+
+#include "workload.h"
+
+int main(int argc, char** argv) {
+  // Initialise logger
+  auto console = spdlog::stdout_color_mt("main");
+
+  try {
+    TCLAP::CmdLine cmd("Generate a synthetic MPM workload (CB-Geo)", ' ',
+                       "Alpha V1.0");
+
+    // Output directory
+    TCLAP::ValueArg<std::string> dir_arg(
+        "f", "working_dir", "Folder to write the input files in", true, "",
+        "working_dir");
+    cmd.add(dir_arg);
+
+    // Problem
+    TCLAP::ValueArg<std::string> type_arg(
+        "w", "workload", "Workload: column_collapse or dam_break", false,
+        "column_collapse", "workload");
+    cmd.add(type_arg);
+
+    // Dimension
+    TCLAP::ValueArg<unsigned> dim_arg("d", "dimension", "Dimension (2 or 3)",
+                                      false, 2, "dimension");
+    cmd.add(dim_arg);
+
+    // Size
+    TCLAP::ValueArg<unsigned> cells_arg(
+        "c", "cells", "Number of cells along each direction of a block", false,
+        32, "cells");
+    cmd.add(cells_arg);
+
+    TCLAP::ValueArg<unsigned> blocks_arg(
+        "b", "blocks", "Number of copies of the problem along x", false, 1,
+        "blocks");
+    cmd.add(blocks_arg);
+
+    TCLAP::ValueArg<unsigned> particles_arg(
+        "p", "particles", "Number of particles in each direction of a cell",
+        false, 2, "particles");
+    cmd.add(particles_arg);
+
+    // Analysis
+    TCLAP::ValueArg<std::string> analysis_arg(
+        "a", "analysis", "Analysis: MPMExplicitUSF or MPMExplicitUSL", false,
+        "MPMExplicitUSF", "analysis");
+    cmd.add(analysis_arg);
+
+    TCLAP::ValueArg<unsigned> steps_arg("s", "nsteps", "Number of steps",
+                                        false, 100, "nsteps");
+    cmd.add(steps_arg);
+
+    cmd.parse(argc, argv);
+
+    mpm_benchmark::Workload workload;
+    workload.type = type_arg.getValue();
+    workload.dim = dim_arg.getValue();
+    workload.ncells = cells_arg.getValue();
+    workload.nblocks = blocks_arg.getValue();
+    workload.nparticles = particles_arg.getValue();
+    workload.analysis = analysis_arg.getValue();
+    workload.nsteps = steps_arg.getValue();
+
+    boost::filesystem::create_directories(dir_arg.getValue());
+    const auto nparticles =
+        mpm_benchmark::write_workload(workload, dir_arg.getValue());
+    console->info("Wrote {} with {} particles, run with -f {} -a {}",
+                  workload.type, nparticles, dir_arg.getValue(),
+                  workload.analysis_type());
+
+  } catch (TCLAP::ArgException& except) {
+    console->error("error: {}  for arg {}", except.error(), except.argId());
+    return 1;
+  } catch (std::exception& exception) {
+    console->error("Generate workload: {}", exception.what());
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,78 @@
+#ifndef MPM_BENCHMARK_UNIFORM_MESH_H_
+#define MPM_BENCHMARK_UNIFORM_MESH_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Eigen/Dense"
+
+#include "element.h"
+#include "factory.h"
+#include "mesh.h"
+
+namespace mpm_benchmark {
+
+// Create a uniform mesh of unit cube cells with particles in a regular grid
+// \param[in] ncells Number of cells in each direction
+// \param[in] nparticles Number of particles in each direction of a cell
+template <unsigned Tdim>
+std::shared_ptr<mpm::Mesh<Tdim>> uniform_mesh(unsigned ncells,
+                                              unsigned nparticles) {
+  using VectorDim = Eigen::Matrix<double, Tdim, 1>;
+  const std::string suffix = std::to_string(Tdim) + "D";
+  auto mesh = std::make_shared<mpm::Mesh<Tdim>>(0);
+
+  // Nodes in lexicographic order
+  const unsigned nnodes_side = ncells + 1;
+  unsigned nnodes = 1, ncells_total = 1;
+  for (unsigned i = 0; i < Tdim; ++i) {
+    nnodes *= nnodes_side;
+    ncells_total *= ncells;
+  }
+  std::vector<VectorDim> nodes(nnodes);
+  for (unsigned n = 0; n < nnodes; ++n)
+    for (unsigned i = 0, index = n; i < Tdim; ++i, index /= nnodes_side)
+      nodes[n](i) = static_cast<double>(index % nnodes_side);
+  mesh->create_nodes(0, "N" + suffix, nodes);
+
+  // Nodes of a quadrilateral (ED2Q4) or hexahedron (ED3H8) counterclockwise
+  const std::vector<std::vector<unsigned>> offsets =
+      (Tdim == 2) ? std::vector<std::vector<unsigned>>{{0, 0},
+                                                       {1, 0},
+                                                       {1, 1},
+                                                       {0, 1}}
+                  : std::vector<std::vector<unsigned>>{
+                        {0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0},
+                        {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}};
+  std::vector<std::vector<mpm::Index>> cells(ncells_total);
+  for (unsigned c = 0; c < ncells_total; ++c) {
+    for (const auto& offset : offsets) {
+      mpm::Index node = 0, stride = 1;
+      for (unsigned i = 0, index = c; i < Tdim; ++i, index /= ncells) {
+        node += (index % ncells + offset[i]) * stride;
+        stride *= nnodes_side;
+      }
+      cells[c].emplace_back(node);
+    }
+  }
+  const auto element = Factory<mpm::Element<Tdim>>::instance()->create(
+      (Tdim == 2) ? "ED2Q4" : "ED3H8");
+  mesh->create_cells(0, element, cells);
+
+  // Particles at the centres of a regular grid in each cell
+  const unsigned nparticles_side = ncells * nparticles;
+  unsigned nparticles_total = 1;
+  for (unsigned i = 0; i < Tdim; ++i) nparticles_total *= nparticles_side;
+  std::vector<VectorDim> particles(nparticles_total);
+  for (unsigned p = 0; p < nparticles_total; ++p)
+    for (unsigned i = 0, index = p; i < Tdim; ++i, index /= nparticles_side)
+      particles[p](i) = (index % nparticles_side + 0.5) / nparticles;
+  mesh->create_particles(0, "P" + suffix, particles);
+
+  return mesh;
+}
+
+}  // namespace mpm_benchmark
+
+#endif  // MPM_BENCHMARK_UNIFORM_MESH_H_
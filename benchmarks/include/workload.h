@@ -0,0 +1,58 @@
+#ifndef MPM_BENCHMARK_WORKLOAD_H_
+#define MPM_BENCHMARK_WORKLOAD_H_
+
+#include <string>
+
+namespace mpm_benchmark {
+
+//! Synthetic workload of a uniform mesh
+//! \brief A box of square cells with particles of a column collapse or a dam
+//! break, nblocks copies of the problem are placed next to each other along
+//! x to scale the work at a constant aspect ratio of each copy
+struct Workload {
+  //! Problem, column_collapse (linear elastic) or dam_break (Bingham)
+  std::string type{"column_collapse"};
+  //! Dimension
+  unsigned dim{2};
+  //! Number of cells along each direction of a block
+  unsigned ncells{32};
+  //! Number of blocks along x
+  unsigned nblocks{1};
+  //! Number of particles in each direction of a cell
+  unsigned nparticles{2};
+  //! Cell size
+  double cell_size{0.1};
+  //! Analysis without dimension, MPMExplicitUSF or MPMExplicitUSL
+  std::string analysis{"MPMExplicitUSF"};
+  //! Number of steps
+  unsigned nsteps{100};
+  //! Output steps, output is written at step 0 and every output_steps
+  unsigned output_steps{1000};
+  //! Write a summary of the profiled stages, needs MPM_PROFILING
+  bool profile{false};
+  //! Heap allocations allowed in a steady state step, negative to not check,
+  //! needs MPM_ALLOCATION_TRACKING
+  long long max_step_allocations{-1};
+
+  //! Return the analysis with its dimension (eg. MPMExplicitUSF2D)
+  std::string analysis_type() const {
+    return analysis + std::to_string(dim) + "D";
+  }
+
+  //! Return the id of the analysis, its results are in results/<uuid>/
+  std::string uuid() const { return type + "-" + std::to_string(dim) + "d"; }
+
+  //! Return the number of particles
+  unsigned long long nparticles_total() const;
+};
+
+//! Write mesh, particles, velocity constraints and an mpm.json input file
+//! \param[in] workload Workload to generate
+//! \param[in] directory Existing directory to write the files in
+//! \retval nparticles Number of particles written
+unsigned long long write_workload(const Workload& workload,
+                                  const std::string& directory);
+
+}  // namespace mpm_benchmark
+
+#endif  // MPM_BENCHMARK_WORKLOAD_H_
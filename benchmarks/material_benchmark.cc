@@ -0,0 +1,68 @@
+#include <memory>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "Eigen/Dense"
+#include "json.hpp"
+
+#include "factory.h"
+#include "material/material.h"
+#include "mesh.h"
+#include "uniform_mesh.h"
+
+namespace {
+// Create a material with properties of a soil and a Bingham fluid
+template <unsigned Tdim>
+std::shared_ptr<mpm::Material<Tdim>> material(const std::string& type) {
+  auto material = Factory<mpm::Material<Tdim>, unsigned>::instance()->create(
+      type + std::to_string(Tdim) + "D", 0);
+  Json properties = {{"density", 1000.},     {"youngs_modulus", 1.0E+7},
+                     {"poisson_ratio", 0.3}, {"tau0", 771.8},
+                     {"mu", 0.0451},         {"critical_shear_rate", 0.2}};
+  material->properties(properties);
+  return material;
+}
+
+// Stress update of a material, materials with a particle handle use a
+// particle in a cell
+template <unsigned Tdim>
+void material_compute_stress(benchmark::State& state, const std::string& type) {
+  auto material = ::material<Tdim>(type);
+  auto mesh = mpm_benchmark::uniform_mesh<Tdim>(1, 1);
+  mesh->locate_particles_mesh();
+  std::shared_ptr<mpm::ParticleBase<Tdim>> particle;
+  mesh->iterate_over_particles(
+      [&particle](std::shared_ptr<mpm::ParticleBase<Tdim>> ptr) {
+        particle = ptr;
+      });
+  particle->assign_material(material);
+  particle->compute_shapefn();
+
+  Eigen::Matrix<double, 6, 1> stress = Eigen::Matrix<double, 6, 1>::Zero();
+  Eigen::Matrix<double, 6, 1> dstrain;
+  dstrain << 1.E-6, -2.E-6, 1.E-6, 5.E-7, 0., 0.;
+  if (material->property_handle()) {
+    for (auto _ : state)
+      benchmark::DoNotOptimize(
+          stress = material->compute_stress(stress, dstrain, particle.get()));
+  } else {
+    for (auto _ : state)
+      benchmark::DoNotOptimize(
+          stress = material->compute_stress(stress, dstrain));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Benchmarks of materials, named <kernel>/<material><dim>D
+const bool material_benchmarks = []() {
+  for (const std::string type : {"LinearElastic", "Bingham"}) {
+    const std::string name = "material_compute_stress/" + type;
+    benchmark::RegisterBenchmark((name + "2D").c_str(),
+                                 material_compute_stress<2>, type);
+    benchmark::RegisterBenchmark((name + "3D").c_str(),
+                                 material_compute_stress<3>, type);
+  }
+  return true;
+}();
+}  // namespace
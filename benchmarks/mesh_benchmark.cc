@@ -0,0 +1,48 @@
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include "Eigen/Dense"
+
+#include "mesh.h"
+#include "uniform_mesh.h"
+
+namespace {
+// Locate particles which remain in their cells
+template <unsigned Tdim>
+void mesh_locate_particles(benchmark::State& state) {
+  auto mesh = mpm_benchmark::uniform_mesh<Tdim>(state.range(0), 2);
+  for (auto _ : state) benchmark::DoNotOptimize(mesh->locate_particles_mesh());
+  state.SetItemsProcessed(state.iterations() * mesh->nparticles());
+}
+
+// Locate particles of which half move to the next cell, particles are moved
+// by half a cell along x and back in turns
+template <unsigned Tdim>
+void mesh_relocate_particles(benchmark::State& state) {
+  const unsigned ncells = state.range(0);
+  auto mesh = mpm_benchmark::uniform_mesh<Tdim>(ncells, 2);
+  double shift = 0.5;
+  for (auto _ : state) {
+    state.PauseTiming();
+    // Particles of the last column of cells stay in the mesh
+    mesh->iterate_over_particles(
+        [=](std::shared_ptr<mpm::ParticleBase<Tdim>> particle) {
+          Eigen::Matrix<double, Tdim, 1> coordinates = particle->coordinates();
+          if (coordinates(0) + shift < ncells) {
+            coordinates(0) += shift;
+            particle->assign_coordinates(coordinates);
+          }
+        });
+    shift = -shift;
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(mesh->locate_particles_mesh());
+  }
+  state.SetItemsProcessed(state.iterations() * mesh->nparticles());
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(mesh_locate_particles, 2)->Arg(32)->Arg(128);
+BENCHMARK_TEMPLATE(mesh_locate_particles, 3)->Arg(8)->Arg(24);
+BENCHMARK_TEMPLATE(mesh_relocate_particles, 2)->Arg(32)->Arg(128);
+BENCHMARK_TEMPLATE(mesh_relocate_particles, 3)->Arg(8)->Arg(24);
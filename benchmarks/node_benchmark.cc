@@ -0,0 +1,69 @@
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Eigen/Dense"
+
+#include "node.h"
+
+namespace {
+// Nodes of the threads of a benchmark, one per thread or a single node all
+// threads contend for
+const std::vector<std::shared_ptr<mpm::NodeBase<3>>>& nodes(bool contended) {
+  static const auto separate = []() {
+    std::vector<std::shared_ptr<mpm::NodeBase<3>>> nodes;
+    for (unsigned i = 0; i < 64; ++i)
+      nodes.emplace_back(std::make_shared<mpm::Node<3, 3, 1>>(
+          i, Eigen::Matrix<double, 3, 1>::Zero()));
+    return nodes;
+  }();
+  static const std::vector<std::shared_ptr<mpm::NodeBase<3>>> shared(
+      separate.size(), separate.front());
+  return contended ? shared : separate;
+}
+
+// Update mass of a node from each thread
+void node_update_mass(benchmark::State& state, bool contended) {
+  const auto& node = nodes(contended).at(state.thread_index() % 64);
+  for (auto _ : state) node->update_mass(true, 0, 1.);
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Update momentum of a node from each thread
+void node_update_momentum(benchmark::State& state, bool contended) {
+  const auto& node = nodes(contended).at(state.thread_index() % 64);
+  const Eigen::VectorXd momentum = Eigen::VectorXd::Ones(3);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(node->update_momentum(true, 0, momentum));
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Update internal force of a node from each thread
+void node_update_internal_force(benchmark::State& state, bool contended) {
+  const auto& node = nodes(contended).at(state.thread_index() % 64);
+  const Eigen::VectorXd force = Eigen::VectorXd::Ones(3);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(node->update_internal_force(true, 0, force));
+  state.SetItemsProcessed(state.iterations());
+}
+}  // namespace
+
+BENCHMARK_CAPTURE(node_update_mass, separate, false)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(node_update_mass, contended, true)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(node_update_momentum, separate, false)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(node_update_momentum, contended, true)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(node_update_internal_force, separate, false)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(node_update_internal_force, contended, true)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
@@ -0,0 +1,366 @@
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <tbb/global_control.h>
+
+#include "spdlog/sinks/stdout_color_sinks.h"
+#include "spdlog/spdlog.h"
+#include "tclap/CmdLine.h"
+
+#include "allocation_tracker.h"
+#include "io.h"
+#include "mpm.h"
+#include "workload.h"
+
+namespace {
+//! Problem of the performance tests
+struct Problem {
+  //! Name of the problem in the baseline
+  std::string name;
+  //! Workload of the problem
+  mpm_benchmark::Workload workload;
+};
+
+//! Tolerances of a comparison to the baseline
+struct Tolerances {
+  //! Relative increase of durations
+  double time{0.25};
+  //! Relative increase of the number of allocations
+  double allocations{0.02};
+  //! Durations of stages shorter than this in the baseline are not compared
+  double min_ms{1.};
+};
+
+//! Return the fixed set of medium sized problems
+//! \param[in] nsteps Number of steps of each problem
+//! \param[in] max_step_allocations Heap allocations allowed in a steady state
+//! step, negative to not check
+std::vector<Problem> problems(unsigned nsteps, long long max_step_allocations) {
+  const auto problem = [=](const std::string& type, unsigned dim,
+                           unsigned ncells, const std::string& analysis) {
+    Problem problem;
+    problem.workload.type = type;
+    problem.workload.dim = dim;
+    problem.workload.ncells = ncells;
+    problem.workload.nparticles = 2;
+    problem.workload.analysis = analysis;
+    problem.workload.nsteps = nsteps;
+    // Output at step 0 only
+    problem.workload.output_steps = nsteps + 1;
+    problem.workload.max_step_allocations = max_step_allocations;
+#ifdef MPM_PROFILING
+    problem.workload.profile = true;
+#endif
+    problem.name = problem.workload.uuid() + "-" +
+                   ((analysis == "MPMExplicitUSF") ? "usf" : "usl");
+    return problem;
+  };
+  return {problem("column_collapse", 2, 96, "MPMExplicitUSF"),
+          problem("dam_break", 2, 96, "MPMExplicitUSL"),
+          problem("column_collapse", 3, 24, "MPMExplicitUSF"),
+          problem("dam_break", 3, 16, "MPMExplicitUSL")};
+}
+
+//! Solve the analysis of a working directory
+//! \param[in] directory Working directory, ending with a separator
+//! \param[in] analysis Analysis type
+//! \retval duration Wall time of the time loop in milliseconds
+double solve(const std::string& directory, const std::string& analysis) {
+  std::vector<std::string> args = {"mpm", "-f", directory, "-a", analysis};
+  std::vector<char*> argv;
+  for (auto& arg : args) argv.emplace_back(&arg[0]);
+  auto io = std::make_unique<mpm::IO>(argv.size(), argv.data());
+  auto mpm = Factory<mpm::MPM, std::unique_ptr<mpm::IO>&&>::instance()->create(
+      analysis, std::move(io));
+  if (!mpm->solve())
+    throw std::runtime_error("Solving " + analysis + " failed");
+  return mpm->time_loop_duration() * 1000.;
+}
+
+//! Measure durations of a problem, the shortest of the repeats is kept, and
+//! heap allocations of a run, which are the same for each run
+//! \param[in] problem Problem to measure
+//! \param[in] directory Working directory of the problem
+//! \param[in] repeats Number of timed runs
+Json measure(const Problem& problem, const std::string& directory,
+             unsigned repeats) {
+  const auto& workload = problem.workload;
+  boost::filesystem::create_directories(directory);
+  const auto nparticles = mpm_benchmark::write_workload(workload, directory);
+
+  Json measured = {{"particles", nparticles}};
+  Json stages = Json::object();
+  Json stage_allocations = Json::object();
+  double time_loop = 0.;
+  for (unsigned i = 0; i < std::max(repeats, 1u); ++i) {
+    const auto start = mpm::heap_allocations();
+    const double duration = solve(directory, workload.analysis_type());
+    time_loop = (i == 0) ? duration : std::min(time_loop, duration);
+    if (mpm::allocation_tracking()) {
+      const auto allocations = mpm::heap_allocations() - start;
+      measured["allocations"] = allocations.calls;
+      measured["allocated_bytes"] = allocations.bytes;
+    }
+
+    // Totals of profiled stages
+    if (workload.profile) {
+      std::ifstream file(directory + "results/" + workload.uuid() +
+                         "/profile.json");
+      if (!file.is_open())
+        throw std::runtime_error("Profile of " + problem.name + " not found");
+      const Json profile = Json::parse(file);
+      for (const auto& stage : profile.at("stages")) {
+        const auto name = stage.at("stage").template get<std::string>();
+        const double total = stage.at("total_ms").template get<double>();
+        if (stages.find(name) == stages.end() || total < stages[name])
+          stages[name] = total;
+        if (stage.find("allocations") != stage.end())
+          stage_allocations[name] = stage.at("allocations");
+      }
+    }
+  }
+  measured["time_loop_ms"] = time_loop;
+  measured["stages"] = stages;
+  measured["stage_allocations"] = stage_allocations;
+  return measured;
+}
+
+//! Compare measurements of a problem to its baseline
+//! \param[in] name Name of the problem
+//! \param[in] measured Measurements of the problem
+//! \param[in] baseline Baseline of the problem
+//! \param[in] tolerances Tolerances of the comparison
+//! \retval nregressions Number of values beyond their tolerance
+unsigned compare(const std::string& name, const Json& measured,
+                 const Json& baseline, const Tolerances& tolerances) {
+  auto console = spdlog::get("main");
+  unsigned nregressions = 0;
+
+  // Compare a duration in milliseconds
+  const auto compare_time = [&](const std::string& what, double value,
+                                double reference) {
+    if (reference < tolerances.min_ms) return;
+    const double ratio = value / reference;
+    if (ratio > 1. + tolerances.time) {
+      ++nregressions;
+      console->error("{} {}: {:.3f} ms, baseline {:.3f} ms (+{:.0f}%)", name,
+                     what, value, reference, (ratio - 1.) * 100.);
+    } else if (ratio < 1. - tolerances.time)
+      console->info("{} {}: {:.3f} ms, baseline {:.3f} ms, consider updating "
+                    "the baseline",
+                    name, what, value, reference);
+  };
+
+  // Durations are optional in a baseline, they depend on the machine
+  if (baseline.find("time_loop_ms") != baseline.end())
+    compare_time("time loop", measured.at("time_loop_ms"),
+                 baseline.at("time_loop_ms"));
+  const auto stages = baseline.value("stages", Json::object());
+  for (auto stage = stages.begin(); stage != stages.end(); ++stage) {
+    const auto& measured_stages = measured.at("stages");
+    if (measured_stages.find(stage.key()) == measured_stages.end()) {
+      ++nregressions;
+      console->error("{} stage {} is not profiled", name, stage.key());
+      continue;
+    }
+    compare_time("stage " + stage.key(), measured_stages.at(stage.key()),
+                 stage.value());
+  }
+
+  // Compare a number of heap allocations
+  const auto compare_allocations = [&](const std::string& what, double value,
+                                       double reference) {
+    if (value > reference * (1. + tolerances.allocations)) {
+      ++nregressions;
+      console->error("{} {}: {} allocations, baseline {} (+{})", name, what,
+                     value, reference, value - reference);
+    }
+  };
+
+  if (baseline.find("allocations") != baseline.end()) {
+    if (measured.find("allocations") == measured.end()) {
+      ++nregressions;
+      console->error("{} allocations are not counted", name);
+    } else
+      compare_allocations("solve", measured.at("allocations"),
+                          baseline.at("allocations"));
+  }
+  const auto allocations = baseline.value("stage_allocations", Json::object());
+  for (auto stage = allocations.begin(); stage != allocations.end(); ++stage) {
+    const auto& measured_allocations = measured.at("stage_allocations");
+    if (measured_allocations.find(stage.key()) != measured_allocations.end())
+      compare_allocations("stage " + stage.key(),
+                          measured_allocations.at(stage.key()), stage.value());
+  }
+  return nregressions;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  // Initialise logger
+  auto console = spdlog::stdout_color_mt("main");
+
+  try {
+    TCLAP::CmdLine cmd("Performance regression tests of MPM (CB-Geo)", ' ',
+                       "Alpha V1.0");
+
+    TCLAP::ValueArg<std::string> dir_arg(
+        "f", "working_dir", "Folder to generate the problems in", true, "",
+        "working_dir");
+    cmd.add(dir_arg);
+
+    TCLAP::ValueArg<std::string> baseline_arg(
+        "b", "baseline", "Baseline JSON file", true, "", "baseline");
+    cmd.add(baseline_arg);
+
+    TCLAP::SwitchArg update_arg("u", "update",
+                                "Record the baseline instead of comparing",
+                                false);
+    cmd.add(update_arg);
+
+    TCLAP::SwitchArg allocations_only_arg(
+        "", "allocations_only",
+        "Record only heap allocations in the baseline, without the durations "
+        "which depend on the machine",
+        false);
+    cmd.add(allocations_only_arg);
+
+    TCLAP::ValueArg<unsigned> threads_arg("t", "threads", "Number of threads",
+                                          false, 4, "threads");
+    cmd.add(threads_arg);
+
+    TCLAP::ValueArg<unsigned> steps_arg("s", "nsteps", "Number of steps",
+                                        false, 20, "nsteps");
+    cmd.add(steps_arg);
+
+    TCLAP::ValueArg<unsigned> repeats_arg(
+        "r", "repeats", "Timed runs of each problem, the fastest is compared",
+        false, 3, "repeats");
+    cmd.add(repeats_arg);
+
+    TCLAP::ValueArg<int> steady_arg(
+        "", "max_step_allocations",
+        "Heap allocations allowed in a steady state step, fails the problem "
+        "beyond, negative to not check",
+        false, -1, "allocations");
+    cmd.add(steady_arg);
+
+    TCLAP::ValueArg<double> time_arg(
+        "", "time_tolerance", "Relative increase of durations to fail on",
+        false, 0.25, "tolerance");
+    cmd.add(time_arg);
+
+    TCLAP::ValueArg<double> allocations_arg(
+        "", "allocation_tolerance",
+        "Relative increase of allocations to fail on", false, 0.02,
+        "tolerance");
+    cmd.add(allocations_arg);
+
+    TCLAP::ValueArg<double> min_arg(
+        "", "min_ms", "Shortest duration of a baseline stage to compare",
+        false, 1., "milliseconds");
+    cmd.add(min_arg);
+
+    cmd.parse(argc, argv);
+
+    Tolerances tolerances;
+    tolerances.time = time_arg.getValue();
+    tolerances.allocations = allocations_arg.getValue();
+    tolerances.min_ms = min_arg.getValue();
+
+    // Logs of the solver would be timed with the analyses
+    spdlog::set_level(spdlog::level::warn);
+    console->set_level(spdlog::level::info);
+    tbb::global_control threads(tbb::global_control::max_allowed_parallelism,
+                                threads_arg.getValue());
+
+#ifdef MPM_PROFILING
+    const bool profiling = true;
+#else
+    const bool profiling = false;
+    console->warn("Stages are not profiled, build with MPM_PROFILING");
+#endif
+    if (!mpm::allocation_tracking())
+      console->warn("Allocations are not counted, build with "
+                    "MPM_ALLOCATION_TRACKING");
+
+    // Measurements are comparable for the same settings only
+    Json results = {{"threads", threads_arg.getValue()},
+                    {"nsteps", steps_arg.getValue()},
+                    {"profiling", profiling},
+                    {"allocation_tracking", mpm::allocation_tracking()},
+                    {"problems", Json::object()}};
+
+    const boost::filesystem::path root(dir_arg.getValue());
+    for (const auto& problem :
+         problems(steps_arg.getValue(), steady_arg.getValue())) {
+      const std::string directory = (root / problem.name).string() + "/";
+      results["problems"][problem.name] =
+          measure(problem, directory, repeats_arg.getValue());
+      console->info("{}: time loop {:.3f} ms", problem.name,
+                    results["problems"][problem.name]["time_loop_ms"]
+                        .template get<double>());
+    }
+
+    const std::string baseline_file = baseline_arg.getValue();
+    if (update_arg.getValue()) {
+      if (allocations_only_arg.getValue())
+        for (auto& problem : results["problems"]) {
+          problem.erase("time_loop_ms");
+          problem.erase("stages");
+        }
+      std::ofstream file(baseline_file);
+      file << results.dump(2) << "\n";
+      if (!file) throw std::runtime_error("Writing " + baseline_file);
+      console->warn("Recorded the baseline {}", baseline_file);
+      return 0;
+    }
+
+    // A missing baseline is an error, a run only records it with --update
+    std::ifstream file(baseline_file);
+    if (!file.is_open())
+      throw std::runtime_error("Baseline " + baseline_file +
+                               " is not found, record it with --update");
+    const Json baseline = Json::parse(file);
+    for (const auto& setting :
+         {"threads", "nsteps", "profiling", "allocation_tracking"})
+      if (baseline.at(setting) != results.at(setting))
+        throw std::runtime_error(
+            std::string("Baseline is recorded with different ") + setting +
+            ", update it with --update");
+
+    unsigned nregressions = 0;
+    const auto& problems = baseline.at("problems");
+    for (auto problem = problems.begin(); problem != problems.end();
+         ++problem) {
+      if (results["problems"].find(problem.key()) ==
+          results["problems"].end()) {
+        ++nregressions;
+        console->error("Problem {} of the baseline is not measured",
+                       problem.key());
+        continue;
+      }
+      nregressions += compare(problem.key(),
+                              results["problems"].at(problem.key()),
+                              problem.value(), tolerances);
+    }
+
+    if (nregressions > 0) {
+      console->error("{} performance regressions", nregressions);
+      return 1;
+    }
+    console->info("No performance regressions");
+
+  } catch (TCLAP::ArgException& except) {
+    console->error("error: {}  for arg {}", except.error(), except.argId());
+    return 1;
+  } catch (std::exception& exception) {
+    console->error("Performance tests: {}", exception.what());
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,257 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <boost/filesystem.hpp>
+#include <tbb/global_control.h>
+
+#include "spdlog/sinks/stdout_color_sinks.h"
+#include "spdlog/spdlog.h"
+#include "tclap/CmdLine.h"
+
+#include "io.h"
+#include "mpm.h"
+#include "workload.h"
+
+namespace {
+//! Measurements of a run of an analysis
+struct Run {
+  //! Wall time of the analysis in seconds, negative if it failed
+  double solve_time{-1.};
+  //! Wall time of the time loop in seconds
+  double loop_time{-1.};
+  //! Peak resident memory in bytes
+  long long max_rss{0};
+};
+
+//! Solve an analysis in a child process limited to a number of threads
+//! \details A process per run isolates the peak memory and thread pool of
+//! each run
+//! \param[in] directory Working directory of the analysis
+//! \param[in] analysis Analysis type
+//! \param[in] nthreads Maximum number of threads
+Run run(const std::string& directory, const std::string& analysis,
+        unsigned nthreads) {
+  Run result;
+  int fds[2];
+  if (pipe(fds) != 0) throw std::runtime_error("Creating a pipe failed");
+
+  const pid_t pid = fork();
+  if (pid < 0) throw std::runtime_error("Creating a process failed");
+  if (pid == 0) {
+    close(fds[0]);
+    double times[2] = {-1., -1.};
+    try {
+      // Step logs would be timed with the analysis
+      spdlog::set_level(spdlog::level::warn);
+      tbb::global_control threads(
+          tbb::global_control::max_allowed_parallelism, nthreads);
+
+      std::vector<std::string> args = {"mpm", "-f", directory, "-a",
+                                       analysis};
+      std::vector<char*> argv;
+      for (auto& arg : args) argv.emplace_back(&arg[0]);
+      auto io = std::make_unique<mpm::IO>(argv.size(), argv.data());
+      auto mpm =
+          Factory<mpm::MPM, std::unique_ptr<mpm::IO>&&>::instance()->create(
+              analysis, std::move(io));
+
+      const auto start = std::chrono::steady_clock::now();
+      if (mpm->solve()) {
+        times[0] = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+        times[1] = mpm->time_loop_duration();
+      }
+    } catch (std::exception& exception) {
+      spdlog::get("main")->error("Scaling run: {}", exception.what());
+    }
+    const bool written = (write(fds[1], times, sizeof(times)) == sizeof(times));
+    close(fds[1]);
+    _exit(written ? 0 : 1);
+  }
+
+  close(fds[1]);
+  double times[2] = {-1., -1.};
+  if (read(fds[0], times, sizeof(times)) != sizeof(times)) times[0] = -1.;
+  close(fds[0]);
+
+  int status = 0;
+  struct rusage usage;
+  if (wait4(pid, &status, 0, &usage) != pid || !WIFEXITED(status) ||
+      WEXITSTATUS(status) != 0)
+    return result;
+  result.solve_time = times[0];
+  result.loop_time = times[1];
+  // Linux reports the peak resident set size in kilobytes
+  result.max_rss = static_cast<long long>(usage.ru_maxrss) * 1024;
+  return result;
+}
+
+//! Return thread counts doubling from 1 to and including a maximum
+//! \param[in] max_threads Maximum number of threads
+std::vector<unsigned> thread_counts(unsigned max_threads) {
+  std::vector<unsigned> counts;
+  for (unsigned n = 1; n < max_threads; n *= 2) counts.emplace_back(n);
+  counts.emplace_back(max_threads);
+  return counts;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  // Initialise logger
+  auto console = spdlog::stdout_color_mt("main");
+
+  try {
+    TCLAP::CmdLine cmd("Strong and weak scaling of MPM analyses (CB-Geo)", ' ',
+                       "Alpha V1.0");
+
+    // Working directory of the generated inputs
+    TCLAP::ValueArg<std::string> dir_arg(
+        "f", "working_dir", "Folder to generate the workloads in", true, "",
+        "working_dir");
+    cmd.add(dir_arg);
+
+    TCLAP::ValueArg<std::string> type_arg(
+        "w", "workload", "Workload: column_collapse or dam_break", false,
+        "column_collapse", "workload");
+    cmd.add(type_arg);
+
+    TCLAP::ValueArg<unsigned> dim_arg("d", "dimension", "Dimension (2 or 3)",
+                                      false, 2, "dimension");
+    cmd.add(dim_arg);
+
+    TCLAP::ValueArg<unsigned> cells_arg(
+        "c", "cells",
+        "Number of cells along each direction of the workload of one thread",
+        false, 64, "cells");
+    cmd.add(cells_arg);
+
+    TCLAP::ValueArg<unsigned> particles_arg(
+        "p", "particles", "Number of particles in each direction of a cell",
+        false, 2, "particles");
+    cmd.add(particles_arg);
+
+    TCLAP::ValueArg<std::string> analysis_arg(
+        "a", "analysis", "Analysis: MPMExplicitUSF or MPMExplicitUSL", false,
+        "MPMExplicitUSF", "analysis");
+    cmd.add(analysis_arg);
+
+    TCLAP::ValueArg<unsigned> steps_arg("s", "nsteps", "Number of steps",
+                                        false, 20, "nsteps");
+    cmd.add(steps_arg);
+
+    TCLAP::ValueArg<unsigned> threads_arg(
+        "t", "threads", "Maximum number of threads, runs double from 1", false,
+        std::max(std::thread::hardware_concurrency(), 1u), "threads");
+    cmd.add(threads_arg);
+
+    // Strong scaling keeps the total work, weak scaling the work per thread
+    TCLAP::ValueArg<std::string> mode_arg(
+        "m", "mode", "Scaling: strong, weak or both", false, "both", "mode");
+    cmd.add(mode_arg);
+
+    TCLAP::ValueArg<std::string> output_arg(
+        "o", "output", "JSON file of the results", false, "scaling.json",
+        "output");
+    cmd.add(output_arg);
+
+    cmd.parse(argc, argv);
+
+    const std::string mode = mode_arg.getValue();
+    if (mode != "strong" && mode != "weak" && mode != "both")
+      throw std::runtime_error("Invalid scaling mode: " + mode);
+    std::vector<std::string> modes;
+    if (mode != "weak") modes.emplace_back("strong");
+    if (mode != "strong") modes.emplace_back("weak");
+
+    mpm_benchmark::Workload workload;
+    workload.type = type_arg.getValue();
+    workload.dim = dim_arg.getValue();
+    workload.ncells = cells_arg.getValue();
+    workload.nparticles = particles_arg.getValue();
+    workload.analysis = analysis_arg.getValue();
+    workload.nsteps = steps_arg.getValue();
+    // Output at step 0 only
+    workload.output_steps = workload.nsteps + 1;
+
+    Json results = {{"workload", workload.type},
+                    {"dimension", workload.dim},
+                    {"analysis", workload.analysis_type()},
+                    {"cells", workload.ncells},
+                    {"particles_per_direction", workload.nparticles},
+                    {"nsteps", workload.nsteps},
+                    {"runs", Json::array()}};
+
+    const boost::filesystem::path root(dir_arg.getValue());
+    for (const auto& scaling : modes) {
+      // Particle updates per second of a single thread
+      double single_thread_rate = 0.;
+      for (const unsigned nthreads : thread_counts(threads_arg.getValue())) {
+        // Weak scaling adds a copy of the problem per thread
+        workload.nblocks = (scaling == "weak") ? nthreads : 1;
+        const auto directory =
+            root / (scaling + "-" + std::to_string(workload.nblocks));
+        // Strong scaling reuses the inputs of the first run
+        const auto nparticles = workload.nparticles_total();
+        if (scaling == "weak" || nthreads == 1) {
+          boost::filesystem::create_directories(directory);
+          mpm_benchmark::write_workload(workload, directory.string());
+        }
+
+        // Working directories are prefixed to file names
+        const Run measured =
+            run(directory.string() + "/", workload.analysis_type(), nthreads);
+        if (measured.solve_time < 0. || measured.loop_time <= 0.) {
+          console->error("{} scaling with {} threads failed", scaling,
+                         nthreads);
+          continue;
+        }
+
+        const double rate =
+            static_cast<double>(nparticles) * workload.nsteps /
+            measured.loop_time;
+        if (nthreads == 1) single_thread_rate = rate;
+        // Equal to T1 / (n Tn) for strong and T1 / Tn for weak scaling
+        const double efficiency =
+            (single_thread_rate > 0.) ? rate / (nthreads * single_thread_rate)
+                                      : 0.;
+
+        console->info(
+            "{} scaling, {} threads, {} particles: {:.3e} particle updates/s, "
+            "efficiency {:.2f}, time loop {:.3f} s, peak memory {} MB",
+            scaling, nthreads, nparticles, rate, efficiency,
+            measured.loop_time, measured.max_rss / (1024 * 1024));
+
+        results["runs"].push_back({{"mode", scaling},
+                                   {"threads", nthreads},
+                                   {"nparticles", nparticles},
+                                   {"solve_time", measured.solve_time},
+                                   {"loop_time", measured.loop_time},
+                                   {"particle_updates_per_second", rate},
+                                   {"parallel_efficiency", efficiency},
+                                   {"max_rss_bytes", measured.max_rss}});
+      }
+    }
+
+    std::ofstream file(output_arg.getValue());
+    file << results.dump(2) << "\n";
+    if (!file) throw std::runtime_error("Writing " + output_arg.getValue());
+
+  } catch (TCLAP::ArgException& except) {
+    console->error("error: {}  for arg {}", except.error(), except.argId());
+    return 1;
+  } catch (std::exception& exception) {
+    console->error("Scaling: {}", exception.what());
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,231 @@
+#include "workload.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "json.hpp"
+using Json = nlohmann::json;
+
+namespace {
+//! Range of cells [first, last) along an axis
+using CellRange = std::pair<unsigned, unsigned>;
+
+//! Return a range of a fraction of the cells of a block, at least one cell
+//! \param[in] ncells Number of cells of the block
+//! \param[in] first Fraction of the block at the start of the range
+//! \param[in] last Fraction of the block at the end of the range
+CellRange fraction(unsigned ncells, double first, double last) {
+  const unsigned begin = static_cast<unsigned>(std::floor(first * ncells));
+  const unsigned end = static_cast<unsigned>(std::floor(last * ncells));
+  return {begin, std::max(end, begin + 1)};
+}
+
+//! Return cells with particles of a block along each axis, the last axis is
+//! vertical
+//! \param[in] workload Workload
+std::array<CellRange, 3> particle_cells(
+    const mpm_benchmark::Workload& workload) {
+  const unsigned n = workload.ncells;
+  std::array<CellRange, 3> cells;
+  if (workload.type == "column_collapse") {
+    // Column of a quarter of the width and three quarters of the height
+    cells = {fraction(n, 0.375, 0.625), fraction(n, 0.375, 0.625),
+             fraction(n, 0., 0.75)};
+  } else if (workload.type == "dam_break") {
+    // Reservoir of half the width and half the height against the left wall
+    cells = {fraction(n, 0., 0.5), fraction(n, 0., 1.), fraction(n, 0., 0.5)};
+  } else
+    throw std::runtime_error("Invalid workload type: " + workload.type);
+  // The vertical axis is the last one
+  if (workload.dim == 2) cells[1] = cells[2];
+  return cells;
+}
+
+//! Return material properties of a workload
+//! \param[in] workload Workload
+Json material(const mpm_benchmark::Workload& workload) {
+  const std::string dim = std::to_string(workload.dim) + "D";
+  if (workload.type == "dam_break")
+    return {{"id", 0},
+            {"type", "Bingham" + dim},
+            {"density", 1000.},
+            {"youngs_modulus", 1.0E+6},
+            {"poisson_ratio", 0.3},
+            {"tau0", 1.},
+            {"mu", 1.0E-3},
+            {"critical_shear_rate", 0.2}};
+  return {{"id", 0},
+          {"type", "LinearElastic" + dim},
+          {"density", 1800.},
+          {"youngs_modulus", 1.0E+6},
+          {"poisson_ratio", 0.3}};
+}
+}  // namespace
+
+//! Return the number of particles
+unsigned long long mpm_benchmark::Workload::nparticles_total() const {
+  const auto cells = particle_cells(*this);
+  unsigned long long nparticles_cells = nblocks;
+  for (unsigned i = 0; i < dim; ++i)
+    nparticles_cells *= (cells[i].second - cells[i].first) * nparticles;
+  return nparticles_cells;
+}
+
+//! Write mesh, particles, velocity constraints and an mpm.json input file
+unsigned long long mpm_benchmark::write_workload(
+    const Workload& workload, const std::string& directory) {
+  if (workload.dim != 2 && workload.dim != 3)
+    throw std::runtime_error("Dimension should be 2 or 3");
+  if (workload.ncells == 0 || workload.nblocks == 0 ||
+      workload.nparticles == 0)
+    throw std::runtime_error("Workload has no cells or particles");
+
+  const unsigned dim = workload.dim;
+  const double h = workload.cell_size;
+  const std::string suffix = std::to_string(dim) + "d";
+  const boost::filesystem::path path(directory);
+
+  // Cells along each axis of the mesh, blocks are placed along x
+  std::array<unsigned, 3> ncells = {workload.ncells * workload.nblocks,
+                                    workload.ncells, 1};
+  if (dim == 3) ncells[2] = workload.ncells;
+  std::array<unsigned, 3> nnodes_side = {ncells[0] + 1, ncells[1] + 1,
+                                         (dim == 3) ? ncells[2] + 1 : 1};
+  const unsigned long long nnodes = static_cast<unsigned long long>(
+                                        nnodes_side[0]) *
+                                    nnodes_side[1] * nnodes_side[2];
+  const unsigned long long ncells_total =
+      static_cast<unsigned long long>(ncells[0]) * ncells[1] * ncells[2];
+
+  // Mesh, nodes in lexicographic order and cells counterclockwise
+  {
+    std::ofstream file((path / ("mesh-" + suffix + ".txt")).string());
+    file << std::setprecision(12);
+    file << "! elementShape " << ((dim == 2) ? "quadrilateral" : "hexahedron")
+         << "\n";
+    file << "! elementNumPoints " << ((dim == 2) ? 4 : 8) << "\n";
+    file << nnodes << "\t" << ncells_total << "\n";
+    for (unsigned k = 0; k < nnodes_side[2]; ++k)
+      for (unsigned j = 0; j < nnodes_side[1]; ++j)
+        for (unsigned i = 0; i < nnodes_side[0]; ++i) {
+          file << i * h << "\t" << j * h;
+          if (dim == 3) file << "\t" << k * h;
+          file << "\n";
+        }
+
+    const std::vector<std::array<unsigned, 3>> offsets =
+        (dim == 2) ? std::vector<std::array<unsigned, 3>>{{0, 0, 0},
+                                                          {1, 0, 0},
+                                                          {1, 1, 0},
+                                                          {0, 1, 0}}
+                   : std::vector<std::array<unsigned, 3>>{
+                         {0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0},
+                         {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}};
+    for (unsigned k = 0; k < ncells[2]; ++k)
+      for (unsigned j = 0; j < ncells[1]; ++j)
+        for (unsigned i = 0; i < ncells[0]; ++i) {
+          for (const auto& offset : offsets)
+            file << ((k + offset[2]) * nnodes_side[1] + j + offset[1]) *
+                            nnodes_side[0] +
+                        i + offset[0]
+                 << "\t";
+          file << "\n";
+        }
+    if (!file) throw std::runtime_error("Writing the workload mesh failed");
+  }
+
+  // Velocity constraints of the walls normal to each axis except the top
+  {
+    std::ofstream file(
+        (path / ("velocity-constraints-" + suffix + ".txt")).string());
+    for (unsigned long long node = 0; node < nnodes; ++node) {
+      const std::array<unsigned, 3> index = {
+          static_cast<unsigned>(node % nnodes_side[0]),
+          static_cast<unsigned>(node / nnodes_side[0] % nnodes_side[1]),
+          static_cast<unsigned>(node / nnodes_side[0] / nnodes_side[1])};
+      for (unsigned i = 0; i < dim; ++i) {
+        const bool top = (i == dim - 1);
+        if (index[i] == 0 || (!top && index[i] == ncells[i]))
+          file << node << "\t" << i << "\t" << 0. << "\n";
+      }
+    }
+    if (!file)
+      throw std::runtime_error("Writing the workload constraints failed");
+  }
+
+  // Particles in a regular grid of each cell of the region of each block
+  unsigned long long nparticles = 0;
+  {
+    std::ofstream file((path / ("particles-" + suffix + ".txt")).string());
+    file << std::setprecision(12);
+    const auto cells = particle_cells(workload);
+    const unsigned np = workload.nparticles;
+    const double spacing = h / np;
+    // Particles along each axis of a block, the third axis of 2D has one
+    std::array<unsigned, 3> first, count;
+    for (unsigned i = 0; i < 3; ++i) {
+      first[i] = (i < dim) ? cells[i].first * np : 0;
+      count[i] = (i < dim) ? (cells[i].second - cells[i].first) * np : 1;
+    }
+    for (unsigned k = 0; k < count[2]; ++k)
+      for (unsigned j = 0; j < count[1]; ++j)
+        for (unsigned b = 0; b < workload.nblocks; ++b)
+          for (unsigned i = 0; i < count[0]; ++i) {
+            const double x =
+                b * workload.ncells * h + (first[0] + i + 0.5) * spacing;
+            file << x << "\t" << (first[1] + j + 0.5) * spacing;
+            if (dim == 3) file << "\t" << (first[2] + k + 0.5) * spacing;
+            file << "\n";
+            ++nparticles;
+          }
+    if (!file)
+      throw std::runtime_error("Writing the workload particles failed");
+  }
+
+  // Time step of a tenth of the time of a pressure wave to cross a cell
+  const Json material = ::material(workload);
+  const double wave_speed =
+      std::sqrt(material.at("youngs_modulus").template get<double>() /
+                material.at("density").template get<double>());
+  std::vector<double> gravity(dim, 0.);
+  gravity.back() = -9.81;
+
+  Json json_file = {
+      {"title", "Synthetic " + workload.type + " workload"},
+      {"input_files",
+       {{"mesh", "mesh-" + suffix + ".txt"},
+        {"velocity_constraints", "velocity-constraints-" + suffix + ".txt"},
+        {"particles", "particles-" + suffix + ".txt"}}},
+      {"mesh",
+       {{"mesh_reader", "Ascii" + std::to_string(dim) + "D"},
+        {"node_type", "N" + std::to_string(dim) + "D"},
+        {"material_id", 0},
+        {"cell_type", (dim == 2) ? "ED2Q4" : "ED3H8"},
+        {"particle_type", "P" + std::to_string(dim) + "D"}}},
+      {"materials", {material}},
+      {"analysis",
+       {{"dt", 0.1 * h / wave_speed},
+        {"uuid", workload.uuid()},
+        {"nsteps", workload.nsteps},
+        {"gravity", gravity}}},
+      {"post_processing",
+       {{"path", "results/"}, {"output_steps", workload.output_steps}}}};
+
+  if (workload.profile) json_file["post_processing"]["profile"] = true;
+  if (workload.max_step_allocations >= 0)
+    json_file["post_processing"]["allocations"] = {
+        {"max_per_step", workload.max_step_allocations}};
+
+  std::ofstream file((path / "mpm.json").string());
+  file << json_file.dump(2);
+  if (!file) throw std::runtime_error("Writing the workload input failed");
+
+  return nparticles;
+}
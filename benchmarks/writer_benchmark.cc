@@ -0,0 +1,108 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "hdf5.h"
+#include "mesh.h"
+#include "uniform_mesh.h"
+#include "vtk_writer.h"
+
+namespace {
+// Gather particle fields into the staging buffer of the writers
+void write_gather_particles(benchmark::State& state) {
+  auto mesh = mpm_benchmark::uniform_mesh<3>(state.range(0), 2);
+  mpm::HDF5ParticleColumns columns;
+  for (auto _ : state) mesh->gather_particles_hdf5(0, &columns);
+  state.SetItemsProcessed(state.iterations() * mesh->nparticles());
+}
+
+// Write particles to HDF5 as a table or one dataset per field
+void write_particles_hdf5(benchmark::State& state, bool columns) {
+  auto mesh = mpm_benchmark::uniform_mesh<3>(state.range(0), 2);
+  mpm::HDF5Options options;
+  options.columns = columns;
+  const std::string filename = "mpmbench-particles.h5";
+  for (auto _ : state)
+    benchmark::DoNotOptimize(mesh->write_particles_hdf5(0, filename, options));
+  std::remove(filename.c_str());
+  state.SetItemsProcessed(state.iterations() * mesh->nparticles());
+}
+
+// Write compressed partitions of particles to HDF5 with a number of writer
+// threads, chunks are compressed by the writers in parallel
+void write_particles_hdf5_partitions(benchmark::State& state,
+                                     unsigned nwriters) {
+  auto mesh = mpm_benchmark::uniform_mesh<3>(state.range(0), 2);
+  mpm::HDF5Options options;
+  options.columns = true;
+  options.chunk_size = 4096;
+  options.compression = 6;
+  options.shuffle = true;
+  options.partitions = 8;
+  options.writers = nwriters;
+  const std::string filename = "mpmbench-partitions.h5";
+  for (auto _ : state)
+    benchmark::DoNotOptimize(mesh->write_particles_hdf5(0, filename, options));
+  std::remove(filename.c_str());
+  for (unsigned i = 0; i < options.partitions; ++i)
+    std::remove(("mpmbench-partitions.p" + std::to_string(i) + ".h5").c_str());
+  state.SetItemsProcessed(state.iterations() * mesh->nparticles());
+}
+
+// Write particles to VTK in a single file or in pieces
+void write_particles_vtk(benchmark::State& state, unsigned npieces) {
+  auto mesh = mpm_benchmark::uniform_mesh<3>(state.range(0), 2);
+  mpm::HDF5ParticleColumns columns;
+  mesh->gather_particles_hdf5(0, &columns);
+
+  VtkWriter writer(columns.coordinates.data(), columns.size());
+  const std::vector<VtkPointArray> arrays = {
+      {"mass", 1, columns.masses.data()},
+      {"velocities", 3, columns.velocities.data()},
+      {"stresses", 6, columns.stresses.data()}};
+  const std::string filename =
+      (npieces > 1) ? "mpmbench-particles.pvtp" : "mpmbench-particles.vtp";
+  for (auto _ : state) {
+    if (npieces > 1)
+      writer.write_parallel_point_data(filename, arrays, npieces);
+    else
+      writer.write_point_data(filename, arrays);
+  }
+  std::remove(filename.c_str());
+  for (unsigned i = 0; npieces > 1 && i < npieces; ++i)
+    std::remove(("mpmbench-particles_" + std::to_string(i) + ".vtp").c_str());
+  state.SetItemsProcessed(state.iterations() * mesh->nparticles());
+}
+}  // namespace
+
+BENCHMARK(write_gather_particles)->Arg(16)->Arg(32);
+BENCHMARK_CAPTURE(write_particles_hdf5, table, false)
+    ->Arg(16)
+    ->Arg(32)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(write_particles_hdf5, columns, true)
+    ->Arg(16)
+    ->Arg(32)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(write_particles_hdf5_partitions, writers_1, 1)
+    ->Arg(32)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(write_particles_hdf5_partitions, writers_4, 4)
+    ->Arg(32)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(write_particles_vtk, single, 1)
+    ->Arg(16)
+    ->Arg(32)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(write_particles_vtk, pieces, 4)
+    ->Arg(16)
+    ->Arg(32)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
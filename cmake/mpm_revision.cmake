@@ -0,0 +1,37 @@
+# - Write the source revision of mpm to a header, run with cmake -P
+#
+# Run at every build so the revision follows commits and uncommitted changes
+# without reconfiguring. The header is only rewritten when the revision
+# changes, so unchanged sources are not recompiled.
+#
+# Variables:
+#  GIT_EXECUTABLE - git, the revision is "unknown" if it is not set
+#  SOURCE_DIR     - Source directory of mpm
+#  OUTPUT         - Header defining MPM_REVISION
+#
+# The revision is the commit, with "-dirty-" and a hash of the differences to
+# the commit when tracked files are modified.
+
+set(revision "unknown")
+if (GIT_EXECUTABLE)
+  execute_process(COMMAND ${GIT_EXECUTABLE} rev-parse HEAD
+    WORKING_DIRECTORY ${SOURCE_DIR}
+    OUTPUT_VARIABLE commit
+    OUTPUT_STRIP_TRAILING_WHITESPACE ERROR_QUIET)
+  if (commit)
+    set(revision ${commit})
+    execute_process(COMMAND ${GIT_EXECUTABLE} diff HEAD
+      WORKING_DIRECTORY ${SOURCE_DIR}
+      OUTPUT_VARIABLE changes
+      ERROR_QUIET)
+    if (changes)
+      string(SHA1 changes_hash "${changes}")
+      string(SUBSTRING ${changes_hash} 0 12 changes_hash)
+      set(revision "${revision}-dirty-${changes_hash}")
+    endif()
+  endif()
+endif()
+
+file(WRITE ${OUTPUT}.tmp "#define MPM_REVISION \"${revision}\"\n")
+configure_file(${OUTPUT}.tmp ${OUTPUT} COPYONLY)
+file(REMOVE ${OUTPUT}.tmp)
@@ -0,0 +1,51 @@
+#ifndef MPM_ALLOCATION_TRACKER_H_
+#define MPM_ALLOCATION_TRACKER_H_
+
+//! MPM namespace
+namespace mpm {
+
+//! Heap allocations
+struct Allocations {
+  //! Number of calls of the allocation functions
+  unsigned long long calls{0};
+  //! Requested bytes
+  unsigned long long bytes{0};
+
+  //! Return the allocations since an earlier count
+  //! \param[in] earlier Allocations counted earlier
+  Allocations operator-(const Allocations& earlier) const {
+    return Allocations{calls - earlier.calls, bytes - earlier.bytes};
+  }
+};
+
+//! Return if heap allocations are tracked
+//! \details Allocations are tracked in builds with MPM_ALLOCATION_TRACKING on
+//! glibc, by replacing malloc, calloc, realloc and the aligned allocation
+//! functions for the whole process. This also counts operator new and the
+//! dynamic temporaries of Eigen.
+bool allocation_tracking();
+
+//! Return heap allocations of all tracked threads since the process started
+Allocations heap_allocations();
+
+//! UntrackedAllocations class
+//! \brief Allocations of the calling thread are not counted during the
+//! lifetime of the object, for bookkeeping of the profiler or output written
+//! on a background thread
+class UntrackedAllocations {
+ public:
+  //! Constructor stops counting allocations of the calling thread
+  UntrackedAllocations();
+
+  //! Destructor resumes counting, unless an enclosing object remains
+  ~UntrackedAllocations();
+
+  //! Delete copy constructor
+  UntrackedAllocations(const UntrackedAllocations&) = delete;
+
+  //! Delete assignement operator
+  UntrackedAllocations& operator=(const UntrackedAllocations&) = delete;
+};  // UntrackedAllocations class
+}  // namespace mpm
+
+#endif  // MPM_ALLOCATION_TRACKER_H_
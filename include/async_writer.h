@@ -0,0 +1,67 @@
+#ifndef MPM_ASYNC_WRITER_H_
+#define MPM_ASYNC_WRITER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+//! MPM namespace
+namespace mpm {
+
+//! AsyncWriter class
+//! \brief Runs output tasks in order on a background thread
+//! \details Tasks are held in a bounded queue, submitting a task blocks while
+//! the queue is full so the producer cannot run ahead of the writer by more
+//! than the queue size. Exceptions thrown by a task are counted and reported
+//! by wait.
+class AsyncWriter {
+ public:
+  //! Constructor starts the writer thread
+  //! \param[in] queue_size Maximum number of tasks waiting to be run
+  explicit AsyncWriter(unsigned queue_size = 1);
+
+  //! Destructor completes pending tasks and stops the writer thread
+  ~AsyncWriter();
+
+  //! Delete copy constructor
+  AsyncWriter(const AsyncWriter&) = delete;
+
+  //! Delete assignement operator
+  AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+  //! Add a task to the queue, blocks while the queue is full
+  //! \param[in] task Output task
+  void submit(std::function<void()> task);
+
+  //! Wait for all submitted tasks to complete
+  //! \retval status False if a task failed since the last wait
+  bool wait();
+
+ private:
+  //! Run tasks until stopped
+  void run();
+
+  //! Maximum number of queued tasks
+  std::size_t queue_size_{1};
+  //! Queued tasks
+  std::deque<std::function<void()>> tasks_;
+  //! Number of tasks submitted and not completed
+  std::size_t pending_{0};
+  //! Number of failed tasks since the last wait
+  std::size_t failed_{0};
+  //! Stop the writer thread
+  bool stop_{false};
+  //! Mutex of the queue
+  std::mutex mutex_;
+  //! Signals a queued task or a stop to the writer thread
+  std::condition_variable task_added_;
+  //! Signals a dequeued or completed task to producers
+  std::condition_variable task_done_;
+  //! Writer thread
+  std::thread thread_;
+};  // AsyncWriter class
+}  // namespace mpm
+
+#endif  // MPM_ASYNC_WRITER_H_
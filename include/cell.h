@@ -1,8 +1,10 @@
 #ifndef MPM_CELL_H_
 #define MPM_CELL_H_
 
+#include <atomic>
 #include <limits>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "Eigen/Dense"
@@ -58,15 +60,18 @@ class Cell {
   bool is_initialised() const;
 
   //! Return the number of particles
-  unsigned nparticles() const { return particles_.size(); }
+  unsigned nparticles() const {
+    return nparticles_.load(std::memory_order_relaxed);
+  }
 
   //! Return the status of a cell: active (if a particle is present)
-  bool status() const { return particles_.size(); }
+  bool status() const { return this->nparticles() > 0; }
 
   //! Number of nodes
   unsigned nnodes() const { return nodes_.size(); }
 
   //! Activate nodes if particle is present
+  //! \retval status Returns false for an empty cell
   bool activate_nodes();
 
   //! Return a pointer to element type of a cell
@@ -94,14 +99,15 @@ class Cell {
   //! Number of neighbours
   unsigned nneighbours() const { return neighbour_cells_.size(); }
 
-  //! Add an id of a particle in the cell
-  //! \param[in] id Global id of a particle
-  //! \retval status Return the successful addition of a particle id
-  bool add_particle_id(Index id);
+  //! Add a particle to the cell
+  //! \details Particles are counted without a lock, ids of particles in cells
+  //! are listed by Mesh::build_cell_particles
+  void add_particle() { nparticles_.fetch_add(1, std::memory_order_relaxed); }
 
-  //! Remove a particle id from the cell (moved to a different cell / killed)
-  //! \param[in] id Global id of a particle
-  void remove_particle_id(Index id);
+  //! Remove a particle from the cell (moved to a different cell / killed)
+  void remove_particle() {
+    nparticles_.fetch_sub(1, std::memory_order_relaxed);
+  }
 
   //! Compute the volume of the cell
   void compute_volume();
@@ -124,6 +130,15 @@ class Cell {
   //! Return nodal coordinates
   Eigen::MatrixXd nodal_coordinates();
 
+  //! Return global coordinates and volumes of quadrature points in the cell
+  //! The volume of a point is its weight times the determinant of the
+  //! Jacobian at the point
+  //! \param[in] quadratures Local coordinates of quadrature points (row-wise)
+  //! \param[in] weights Weights of quadrature points
+  //! \retval points Global coordinates and volume of each quadrature point
+  std::vector<std::pair<VectorDim, double>> quadrature_points(
+      const Eigen::MatrixXd& quadratures, const Eigen::VectorXd& weights);
+
   //! Check if a point is in a cell
   //! Cell is broken into sub-triangles with point as one of the
   //! vertex The sum of the sub-volume should be equal to the volume of the cell
@@ -238,8 +253,8 @@ class Cell {
   //! mean_length of cell
   double mean_length_{std::numeric_limits<double>::max()};
 
-  //! particles ids in cell
-  std::vector<Index> particles_;
+  //! Number of particles in cell
+  std::atomic<unsigned> nparticles_{0};
 
   //! Container of node pointers (local id, node pointer)
   Map<NodeBase<Tdim>> nodes_;
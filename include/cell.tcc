@@ -86,19 +86,13 @@ bool mpm::Cell<Tdim>::add_node(
 //! Activate nodes if particle is present
 template <unsigned Tdim>
 bool mpm::Cell<Tdim>::activate_nodes() {
-  bool status = true;
-  try {
-    // If number of particles are present, set node status to active
-    if (particles_.size() > 0) {
-      // Activate all nodes
-      for (unsigned i = 0; i < nodes_.size(); ++i)
-        nodes_[i]->assign_status(true);
-    } else {
-      throw std::runtime_error("No particles in cell, can't activate nodes");
-    }
-  } catch (std::exception& exception) {
-    console_->error("{} #{}: {}\n", __FILE__, __LINE__, exception.what());
-    status = false;
+  bool status = false;
+  // If number of particles are present, set node status to active
+  if (this->nparticles() > 0) {
+    // Activate all nodes
+    for (unsigned i = 0; i < nodes_.size(); ++i)
+      nodes_[i]->assign_status(true);
+    status = true;
   }
   return status;
 }
@@ -121,26 +115,6 @@ bool mpm::Cell<Tdim>::add_neighbour(
   return insertion_status;
 }
 
-//! Add a particle id and return the status of addition of a particle id
-template <unsigned Tdim>
-bool mpm::Cell<Tdim>::add_particle_id(Index id) {
-  bool status = false;
-  // Check if it is found in the container
-  auto itr = std::find(particles_.begin(), particles_.end(), id);
-  if (itr == particles_.end()) {
-    particles_.emplace_back(id);
-    status = true;
-  }
-  return status;
-}
-
-//! Remove a particle id
-template <unsigned Tdim>
-void mpm::Cell<Tdim>::remove_particle_id(Index id) {
-  particles_.erase(std::remove(particles_.begin(), particles_.end(), id),
-                   particles_.end());
-}
-
 //! Compute volume of a 1D cell
 //! Computes the length of cell
 template <>
@@ -308,6 +282,27 @@ Eigen::MatrixXd mpm::Cell<Tdim>::nodal_coordinates() {
   return coordinates;
 }
 
+//! Return global coordinates and volumes of quadrature points in the cell
+template <unsigned Tdim>
+std::vector<std::pair<Eigen::Matrix<double, Tdim, 1>, double>>
+    mpm::Cell<Tdim>::quadrature_points(const Eigen::MatrixXd& quadratures,
+                                       const Eigen::VectorXd& weights) {
+  std::vector<std::pair<VectorDim, double>> points;
+  points.reserve(quadratures.rows());
+  const Eigen::MatrixXd coordinates = this->nodal_coordinates();
+  for (unsigned i = 0; i < quadratures.rows(); ++i) {
+    const VectorDim xi = quadratures.row(i).transpose();
+    // Global coordinates of the quadrature point
+    const VectorDim point = coordinates.transpose() * element_->shapefn(xi);
+    // Volume from the weight and the Jacobian
+    const double volume =
+        weights(i) *
+        std::fabs(element_->jacobian(xi, coordinates).determinant());
+    points.emplace_back(std::make_pair(point, volume));
+  }
+  return points;
+}
+
 //! Check if a point is in a 1D cell by breaking the cell into sub-volumes
 template <>
 inline bool mpm::Cell<1>::point_in_cell(
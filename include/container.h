@@ -25,6 +25,14 @@ class Container {
   //! \param[in] ptr A shared pointer
   bool add(const std::shared_ptr<T>&);
 
+  //! Add a range of element pointers, ids are not checked for duplicates
+  //! \param[in] first Iterator to the first shared pointer
+  //! \param[in] last Iterator past the last shared pointer
+  template <class Titerator>
+  void add(Titerator first, Titerator last) {
+    if (first != last) elements_.grow_by(first, last);
+  }
+
   //! Remove an element pointer
   //! \param[in] ptr A shared pointer
   bool remove(const std::shared_ptr<T>&);
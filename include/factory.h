@@ -35,6 +35,18 @@ class Factory {
     return registry.at(key)->create(std::forward<Targs>(args)...);
   }
 
+  //! Return a function that creates instances of a registered class, the
+  //! registry is looked up once to create many instances
+  //! \param[in] key key to item in registry
+  //! \retval creator Function that returns a shared_ptr to a base class
+  std::function<std::shared_ptr<Tbaseclass>(Targs&&...)> creator(
+      const std::string& key) {
+    const auto creator = registry.at(key);
+    return [creator](Targs&&... args) {
+      return creator->create(std::forward<Targs>(args)...);
+    };
+  }
+
   //! List registered elements
   //! \retval factory_items Return list of items in the registry
   std::vector<std::string> list() const {
@@ -1,12 +1,21 @@
 #ifndef MPM_HDF5_H_
 #define MPM_HDF5_H_
 
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
 // HDF5
 #include "hdf5.h"
 #include "hdf5_hl.h"
 
 namespace mpm {
 
+// Global index type for the particle
+using Index = unsigned long long;
+
 // Define a struct of particle
 typedef struct HDF5Particle {
   // Index
@@ -29,6 +38,203 @@ typedef struct HDF5Particle {
   bool status;
 } HDF5Particle;
 
+//! HDF5 output options
+struct HDF5Options {
+  //! Store each particle field as a separate dataset
+  bool columns{false};
+  //! Number of particles in a chunk
+  hsize_t chunk_size{10000};
+  //! Deflate compression level, 0 disables compression
+  unsigned compression{0};
+  //! Apply the shuffle filter before compression
+  bool shuffle{false};
+  //! Append output steps to a single file of the analysis
+  bool time_series{false};
+  //! Number of output steps between flushes of the single file
+  unsigned flush_interval{1};
+  //! Number of partition files tied together by a master file, 0 or 1 writes
+  //! a single file
+  unsigned partitions{0};
+  //! Number of writer threads of partition files, 0 uses all hardware threads
+  unsigned writers{0};
+};
+
+//! Particle fields of HDF5 output, ids are always written
+enum HDF5Field : unsigned {
+  Mass = 1 << 0,
+  Coordinates = 1 << 1,
+  Velocity = 1 << 2,
+  Stress = 1 << 3,
+  Strain = 1 << 4,
+  VolumetricStrain = 1 << 5,
+  Status = 1 << 6,
+  AllFields = (1 << 7) - 1
+};
+
+//! Return the field of a dataset name, throws if the name is invalid
+//! \param[in] name Dataset name of the field (eg., stress)
+unsigned hdf5_field(const std::string& name);
+
+//! Selection of particles and fields for output
+struct HDF5Selection {
+  //! Fields to gather and write
+  unsigned fields{HDF5Field::AllFields};
+  //! Axis-aligned regions as (min, max) corners, a particle is selected if it
+  //! lies in any region, no regions select all particles
+  std::vector<std::pair<std::vector<double>, std::vector<double>>> regions;
+  //! Particles with ids divisible by the stride are selected
+  mpm::Index stride{1};
+  //! Sorted ids of selected particles, no ids select all particles
+  std::vector<mpm::Index> ids;
+
+  //! Check if all particles are selected
+  bool all_particles() const {
+    return regions.empty() && stride <= 1 && ids.empty();
+  }
+
+  //! Check if a particle is selected
+  //! \param[in] id Particle id
+  //! \param[in] coordinates Particle coordinates
+  //! \param[in] dim Dimension of the coordinates
+  bool selects(mpm::Index id, const double* coordinates, unsigned dim) const;
+};
+
+//! Particle fields gathered for output with one row per particle
+struct HDF5ParticleColumns {
+  //! Fields present in the buffer
+  unsigned fields{HDF5Field::AllFields};
+  //! Dimension of coordinates and velocities
+  unsigned dim{0};
+  //! Particle ids
+  std::vector<mpm::Index> ids;
+  //! Masses
+  std::vector<double> masses;
+  //! Coordinates, dim values per particle
+  std::vector<double> coordinates;
+  //! Velocities, dim values per particle
+  std::vector<double> velocities;
+  //! Stresses, 6 values per particle
+  std::vector<double> stresses;
+  //! Strains, 6 values per particle
+  std::vector<double> strains;
+  //! Volumetric strains at the cell centroid
+  std::vector<double> volumetric_strains;
+  //! Particle status
+  std::vector<std::uint8_t> statuses;
+
+  //! Number of particles
+  hsize_t size() const { return ids.size(); }
+
+  //! Resize the fields, capacity is kept for reuse of the buffer
+  //! \param[in] dimension Dimension of coordinates and velocities
+  //! \param[in] nparticles Number of particles
+  //! \param[in] selected_fields Fields to hold, others are emptied
+  void resize(unsigned dimension, hsize_t nparticles,
+              unsigned selected_fields = HDF5Field::AllFields);
+
+  //! Return the particle record of a row
+  //! \param[in] i Row of the particle
+  HDF5Particle particle(hsize_t i) const;
+
+  //! Assign the particle record of a row, all fields have to be present
+  //! \param[in] i Row of the particle
+  //! \param[in] particle Particle record
+  void set_particle(hsize_t i, const HDF5Particle& particle);
+};
+
+//! Lock serialising HDF5 calls when the library is not thread-safe
+//! \retval lock Owning lock, or a deferred lock for a thread-safe library
+std::unique_lock<std::mutex> hdf5_lock();
+
+//! Write a chunked two-dimensional dataset of nrows x ncols
+//! \details The first dimension is extensible, chunks span chunk_size rows and
+//! the shuffle / deflate filters are applied as set in the options. Chunks are
+//! compressed by the calling thread and written directly, the HDF5 lock is
+//! only held around HDF5 calls so concurrent writers compress in parallel
+//! \param[in] location HDF5 file or group to create the dataset in
+//! \param[in] name Name of the dataset
+//! \param[in] type HDF5 native type of the data
+//! \param[in] data Row-major data buffer
+//! \param[in] nrows Number of rows
+//! \param[in] ncols Number of columns
+//! \param[in] options HDF5 output options
+//! \retval status Status of writing the dataset
+bool write_hdf5_dataset(hid_t location, const std::string& name, hid_t type,
+                        const void* data, hsize_t nrows, hsize_t ncols,
+                        const HDF5Options& options);
+
+//! Number of rows and columns of a dataset
+//! \param[in] location HDF5 file or group containing the dataset
+//! \param[in] name Name of the dataset
+//! \retval dims Rows and columns (columns are 1 for a one-dimensional dataset)
+std::pair<hsize_t, hsize_t> hdf5_dataset_dims(hid_t location,
+                                              const std::string& name);
+
+//! Write a virtual dataset concatenating the rows of a dataset in source files
+//! \param[in] location HDF5 file or group to create the dataset in
+//! \param[in] name Name of the virtual dataset and of the source datasets
+//! \param[in] type HDF5 native type of the data
+//! \param[in] ncols Number of columns
+//! \param[in] files Source file names, relative to the virtual dataset file
+//! \param[in] rows Number of rows in each source file
+//! \retval status Status of writing the virtual dataset
+bool write_hdf5_virtual_dataset(hid_t location, const std::string& name,
+                                hid_t type, hsize_t ncols,
+                                const std::vector<std::string>& files,
+                                const std::vector<hsize_t>& rows);
+
+//! Read a dataset into a row-major buffer
+//! \param[in] location HDF5 file or group containing the dataset
+//! \param[in] name Name of the dataset
+//! \param[in] type HDF5 native type of the buffer
+//! \param[in] data Buffer sized to hold the dataset
+//! \retval status Status of reading the dataset
+bool read_hdf5_dataset(hid_t location, const std::string& name, hid_t type,
+                       void* data);
+
+//! Write particle fields to a file in the layout set in the options
+//! \details Options select a single table, one dataset per field, or
+//! partition files written concurrently and tied together by virtual datasets.
+//! A table holds all fields, a subset of fields is written as datasets.
+//! \param[in] filename Name of the HDF5 file
+//! \param[in] columns Particle fields
+//! \param[in] options HDF5 output options
+//! \retval status Status of writing the file
+bool write_hdf5_particles(const std::string& filename,
+                          const HDF5ParticleColumns& columns,
+                          const HDF5Options& options);
+
+//! Write a range of rows of particle fields with one dataset per field
+//! \param[in] location HDF5 file or group to create the datasets in
+//! \param[in] columns Particle fields
+//! \param[in] options Chunking and compression of the datasets
+//! \param[in] first First row to write
+//! \param[in] last Row past the last row to write
+//! \retval status Status of writing the datasets
+bool write_hdf5_particle_columns(hid_t location,
+                                 const HDF5ParticleColumns& columns,
+                                 const HDF5Options& options, hsize_t first,
+                                 hsize_t last);
+
+//! Read particle fields from a file written in any layout
+//! \details A table is read in chunks of records, the records of a chunk are
+//! converted to fields in parallel. Datasets, including the virtual datasets
+//! of partitioned files, are read whole.
+//! \param[in] filename Name of the HDF5 file
+//! \param[in] dim Dimension of particles, columns of coordinates in a table
+//! \param[in] columns Particle fields read, fields sets the fields found
+//! \param[in] chunk_size Number of table records read at a time
+//! \retval status Status of reading the file
+bool read_hdf5_particles(const std::string& filename, unsigned dim,
+                         HDF5ParticleColumns* columns,
+                         hsize_t chunk_size = 10000);
+
+//! Read particle fields stored with one dataset per field
+//! \param[in] location HDF5 file or group containing the datasets
+//! \param[in] columns Particle fields read, fields sets the datasets found
+//! \retval status Status of reading the datasets
+bool read_hdf5_particle_columns(hid_t location, HDF5ParticleColumns* columns);
+
 }  // namespace mpm
 
 #endif  // MPM_HDF5_H_
@@ -0,0 +1,87 @@
+#ifndef MPM_HDF5_TIME_SERIES_H_
+#define MPM_HDF5_TIME_SERIES_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "hdf5.h"
+
+//! MPM namespace
+namespace mpm {
+
+//! HDF5TimeSeries class
+//! \brief A single HDF5 file holding the output steps of an analysis
+//! \details Each output step is a group /steps/<step>, an index of step and
+//! time is kept in the extensible datasets /index/step and /index/time.
+//! Writing a step that is already present replaces it, which allows a resumed
+//! analysis to overwrite steps written after its checkpoint.
+class HDF5TimeSeries {
+ public:
+  //! Constructor opens or creates the file, throws if it cannot be opened
+  //! \param[in] filename Name of the HDF5 file
+  //! \param[in] append Append to an existing file, otherwise truncate it
+  //! \param[in] read_only Open an existing file only for reading
+  //! \param[in] flush_interval Number of written steps between flushes
+  HDF5TimeSeries(const std::string& filename, bool append,
+                 bool read_only = false, unsigned flush_interval = 1);
+
+  //! Destructor flushes and closes the file
+  ~HDF5TimeSeries();
+
+  //! Delete copy constructor
+  HDF5TimeSeries(const HDF5TimeSeries&) = delete;
+
+  //! Delete assignement operator
+  HDF5TimeSeries& operator=(const HDF5TimeSeries&) = delete;
+
+  //! Create the group of an output step and add it to the index
+  //! \param[in] step Output step
+  //! \param[in] time Analysis time of the step
+  //! \retval group HDF5 group to write the step data in
+  hid_t create_step(mpm::Index step, double time);
+
+  //! Open the group of an output step, throws if the step is not present
+  //! \param[in] step Output step
+  //! \retval group HDF5 group containing the step data
+  hid_t open_step(mpm::Index step) const;
+
+  //! Close a step group, the file is flushed every flush_interval steps
+  //! \param[in] group HDF5 group returned by create_step or open_step
+  void close_step(hid_t group);
+
+  //! Flush the file to disk
+  void flush();
+
+  //! Check if an output step is present
+  //! \param[in] step Output step
+  bool has_step(mpm::Index step) const;
+
+  //! Return index of step and time in order of writing
+  const std::vector<std::pair<mpm::Index, double>>& index() const {
+    return index_;
+  }
+
+ private:
+  //! Name of the group of a step
+  //! \param[in] step Output step
+  static std::string step_name(mpm::Index step);
+
+  //! Write a row of the step and time index
+  //! \param[in] row Row of the index
+  void write_index(hsize_t row);
+
+  //! HDF5 file
+  hid_t file_id_{-1};
+  //! Read only file
+  bool read_only_{false};
+  //! Number of written steps between flushes
+  unsigned flush_interval_{1};
+  //! Number of steps written since the last flush
+  unsigned unflushed_steps_{0};
+  //! Step and time of the output steps
+  std::vector<std::pair<mpm::Index, double>> index_;
+};  // HDF5TimeSeries class
+}  // namespace mpm
+
+#endif  // MPM_HDF5_TIME_SERIES_H_
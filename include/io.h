@@ -36,6 +36,9 @@ class IO {
   //! Return analysis
   std::string analysis_type() const { return analysis_; }
 
+  //! Return if hardware events of profiled stages are counted
+  bool perf_counters() const { return perf_counters_; }
+
   //! Return json analysis object
   Json analysis() const { return json_["analysis"]; }
 
@@ -60,7 +63,22 @@ class IO {
                                       const std::string& analysis_id,
                                       unsigned step, unsigned max_steps);
 
+  //! Create output file name of a single file for the analysis
+  //! (eg. particles.h5) holding all the steps
+  //! \param[in] attribute Attribute being written (eg., particles)
+  //! \param[in] file_extension File Extension (*.h5)
+  //! \param[in] analysis_id Unique id of the analysis
+  //! \return file_name File name in the analysis output folder
+  boost::filesystem::path output_file(const std::string& attribute,
+                                      const std::string& file_extension,
+                                      const std::string& analysis_id);
+
  private:
+  //! Create the output folder of an analysis if not present
+  //! \param[in] analysis_id Unique id of the analysis
+  //! \return path Output folder of the analysis
+  std::string analysis_folder(const std::string& analysis_id);
+
   //! Working directory
   std::string working_dir_;
   //! Input file name
@@ -69,6 +87,8 @@ class IO {
   Json json_;
   //! Analysis
   std::string analysis_;
+  //! Count hardware events of profiled stages
+  bool perf_counters_{false};
   //! Logger
   std::shared_ptr<spdlog::logger> console_;
 };
@@ -24,6 +24,12 @@ struct Logger {
   // Create a logger for reading ascii mesh
   static const std::shared_ptr<spdlog::logger> read_mesh_ascii;
 
+  // Create a logger for reading ascii mesh in parallel
+  static const std::shared_ptr<spdlog::logger> read_mesh_ascii_parallel;
+
+  // Create a logger for reading binary mesh
+  static const std::shared_ptr<spdlog::logger> read_mesh_binary;
+
   // Create a logger for MPM
   static const std::shared_ptr<spdlog::logger> mpm_logger;
 
@@ -31,6 +31,10 @@ class Map {
   //! \param[in] id Global/local index of the pointer
   bool remove(Index id);
 
+  //! Reserve space for a number of elements
+  //! \param[in] size Number of elements
+  void reserve(std::size_t size) { elements_.reserve(size); }
+
   //! Return number of elements in the container
   std::size_t size() const { return elements_.size(); }
 
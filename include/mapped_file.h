@@ -0,0 +1,41 @@
+#ifndef MPM_MAPPED_FILE_H_
+#define MPM_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <string>
+
+//! MPM namespace
+namespace mpm {
+
+//! MappedFile class
+//! \brief Read-only memory map of a file, unmapped on destruction
+class MappedFile {
+ public:
+  //! Constructor maps the file, throws if the file cannot be mapped
+  //! \param[in] filename Name of the file to map
+  explicit MappedFile(const std::string& filename);
+
+  //! Destructor unmaps the file
+  ~MappedFile();
+
+  //! Delete copy constructor
+  MappedFile(const MappedFile&) = delete;
+
+  //! Delete assignement operator
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  //! Return pointer to the first byte of the file
+  const char* data() const { return data_; }
+
+  //! Return size of the file in bytes
+  std::size_t size() const { return size_; }
+
+ private:
+  //! Mapped data
+  const char* data_{nullptr};
+  //! Size of the file
+  std::size_t size_{0};
+};  // MappedFile class
+}  // namespace mpm
+
+#endif  // MPM_MAPPED_FILE_H_
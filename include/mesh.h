@@ -1,25 +1,42 @@
 #ifndef MPM_MESH_H_
 #define MPM_MESH_H_
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
 #include <limits>
+#include <map>
 #include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 // Eigen
 #include "Eigen/Dense"
 // TBB
+#include <tbb/blocked_range.h>
+#include <tbb/concurrent_vector.h>
 #include <tbb/parallel_for.h>
 #include <tbb/parallel_for_each.h>
+#include <tbb/parallel_scan.h>
 
 #include "cell.h"
 #include "container.h"
 #include "factory.h"
 #include "hdf5.h"
+#include "hexahedron_quadrature.h"
 #include "logger.h"
 #include "material/material.h"
+#include "mesh_binary_format.h"
 #include "node.h"
 #include "particle.h"
 #include "particle_base.h"
+#include "quadrilateral_quadrature.h"
 
 namespace mpm {
 
@@ -50,6 +67,7 @@ class Mesh {
   unsigned id() const { return id_; }
 
   //! Create nodes from coordinates
+  //! Nodes are created in parallel and ids follow the order of coordinates
   //! \param[in] gnid Global node id
   //! \param[in] node_type Node type
   //! \param[in] coordinates Nodal coordinates
@@ -81,7 +99,27 @@ class Mesh {
   template <typename Toper, typename Tpred>
   void iterate_over_nodes_predicate(Toper oper, Tpred pred);
 
+  //! Initialise nodes that were active in the previous step
+  //! Nodes only receive values through cells with particles, so nodes outside
+  //! the active list still hold their initialised values
+  void initialise_active_nodes();
+
+  //! Activate nodes of cells with particles and build the active node list
+  void activate_nodes();
+
+  //! Build a compact list of active nodes in parallel
+  void find_active_nodes();
+
+  //! Return the number of active nodes
+  mpm::Index nactive_nodes() const { return active_nodes_.size(); }
+
+  //! Iterate over active nodes
+  //! \tparam Toper Callable object typically a baseclass functor
+  template <typename Toper>
+  void iterate_over_active_nodes(Toper oper);
+
   //! Create cells from list of nodes
+  //! Cells and their geometry are created in parallel
   //! \param[in] gcid Global cell id
   //! \param[in] element Element type
   //! \param[in] cells Node ids of cells
@@ -108,7 +146,31 @@ class Mesh {
   template <typename Toper>
   void iterate_over_cells(Toper oper);
 
+  //! Rebuild the cell to particle list from particle cell ids
+  //! A counting sort on the cell index of particles builds a compressed
+  //! (CSR) cell to particle list in parallel
+  void build_cell_particles();
+
+  //! Return ids of particles in a cell
+  //! Ids are read from the cell to particle list of build_cell_particles
+  //! \param[in] cell_id Id of the cell
+  //! \retval particles Sorted ids of particles in the cell
+  std::vector<mpm::Index> cell_particles(mpm::Index cell_id) const;
+
+  //! Build a compact list of cells with particles in parallel
+  void find_active_cells();
+
+  //! Return the number of cells with particles
+  mpm::Index nactive_cells() const { return active_cells_.size(); }
+
+  //! Iterate over cells with particles
+  //! \tparam Toper Callable object typically a baseclass functor
+  template <typename Toper>
+  void iterate_over_active_cells(Toper oper);
+
   //! Create particles from coordinates
+  //! Particles are created in parallel and located in cells in one batch,
+  //! particles outside the mesh are not added
   //! \param[in] gpid Global particle id
   //! \param[in] particle_type Particle type
   //! \param[in] coordinates Nodal coordinates
@@ -116,6 +178,25 @@ class Mesh {
   bool create_particles(mpm::Index gpid, const std::string& particle_type,
                         const std::vector<VectorDim>& coordinates);
 
+  //! Generate particles at quadrature points of cells
+  //! Particles are created in parallel and assigned to their cell with a
+  //! volume from the quadrature weight and the cell Jacobian
+  //! \param[in] gpid Global particle id
+  //! \param[in] particle_type Particle type
+  //! \param[in] npoints Number of quadrature points in each direction
+  //! \param[in] cell_ids Ids of cells to fill, all cells if empty
+  //! \retval status Generate particle status
+  bool generate_particles(mpm::Index gpid, const std::string& particle_type,
+                          unsigned npoints,
+                          const std::vector<mpm::Index>& cell_ids);
+
+  //! Return ids of cells with a centroid inside a box
+  //! \param[in] min Minimum coordinates of the box
+  //! \param[in] max Maximum coordinates of the box
+  //! \retval cell_ids Ids of cells in the box
+  std::vector<mpm::Index> cell_ids_in_box(const VectorDim& min,
+                                          const VectorDim& max) const;
+
   //! Add a particle to the mesh
   //! \param[in] particle A shared pointer to particle
   //! \retval insertion_status Return the successful addition of a particle
@@ -131,8 +212,9 @@ class Mesh {
   mpm::Index nparticles() const { return particles_.size(); }
 
   //! Locate particles in a cell
-  //! Iterate over all cells in a mesh to find the cell in which particles
-  //! are located.
+  //! Particles are checked in their current cell, the remaining particles
+  //! are located in one batch. Particle ids of cells and the list of cells
+  //! with particles are rebuilt afterwards.
   //! \retval particles Particles which cannot be located in the mesh
   std::vector<std::shared_ptr<mpm::ParticleBase<Tdim>>> locate_particles_mesh();
 
@@ -149,11 +231,28 @@ class Mesh {
   std::vector<Eigen::Matrix<double, 3, 1>> particle_stresses(unsigned phase);
 
   //! Assign velocity constraints
+  //! Constraints are stored in flat arrays of the mesh, if a node direction is
+  //! constrained more than once, the first constraint is retained
   //! \param[in] velocity_constraints Constraint at node, dir, and velocity
   bool assign_velocity_constraints(
       const std::vector<std::tuple<mpm::Index, unsigned, double>>&
           velocity_constraints);
 
+  //! Assign a velocity constraint to a set of nodes
+  //! \param[in] node_set Ids of nodes in the set
+  //! \param[in] dir Direction of velocity constraint
+  //! \param[in] velocity Applied velocity constraint
+  bool assign_velocity_constraints(const std::vector<mpm::Index>& node_set,
+                                   unsigned dir, double velocity);
+
+  //! Return the number of velocity constraints
+  mpm::Index nvelocity_constraints() const {
+    return constrained_nodes_.size();
+  }
+
+  //! Apply velocity constraints to active nodes in parallel
+  void apply_velocity_constraints();
+
   //! Return status of the mesh. A mesh is active, if at least one particle is
   //! present
   bool status() const { return particles_.size(); }
@@ -172,8 +271,27 @@ class Mesh {
   //! Write HDF5 particles
   //! \param[in] phase Index corresponding to the phase
   //! \param[in] filename Name of HDF5 file to write particles data
+  //! \param[in] options Layout, chunking and compression of the output
   //! \retval status Status of writing HDF5 output
-  bool write_particles_hdf5(unsigned phase, const std::string& filename);
+  bool write_particles_hdf5(
+      unsigned phase, const std::string& filename,
+      const mpm::HDF5Options& options = mpm::HDF5Options());
+
+  //! Write HDF5 particles with one dataset per field
+  //! \param[in] phase Index corresponding to the phase
+  //! \param[in] location HDF5 file or group to write the datasets in
+  //! \param[in] options Chunking and compression of the datasets
+  //! \retval status Status of writing HDF5 output
+  bool write_particles_hdf5_columns(unsigned phase, hid_t location,
+                                    const mpm::HDF5Options& options);
+
+  //! Gather particle fields for HDF5 output
+  //! \param[in] phase Index corresponding to the phase
+  //! \param[in] columns Particle fields, the buffer is resized and reused
+  //! \param[in] selection Fields and particles to gather
+  void gather_particles_hdf5(
+      unsigned phase, mpm::HDF5ParticleColumns* columns,
+      const mpm::HDF5Selection& selection = mpm::HDF5Selection()) const;
 
   //! Read HDF5 particles
   //! \param[in] phase Index corresponding to the phase
@@ -181,9 +299,105 @@ class Mesh {
   //! \retval status Status of reading HDF5 output
   bool read_particles_hdf5(unsigned phase, const std::string& filename);
 
+  //! Create particles from HDF5
+  //! The particle store is sized from the file, which is read in chunks,
+  //! particles are created in parallel and located in cells in one batch,
+  //! particles outside the mesh are not added
+  //! \param[in] particle_type Particle type
+  //! \param[in] filename Name of HDF5 file with particles in any layout
+  //! \retval status Create particle status
+  bool create_particles_hdf5(const std::string& particle_type,
+                             const std::string& filename);
+
+  //! Read HDF5 particles stored with one dataset per field
+  //! \param[in] phase Index corresponding to the phase
+  //! \param[in] location HDF5 file or group containing the datasets
+  //! \retval status Status of reading HDF5 output
+  bool read_particles_hdf5_columns(unsigned phase, hid_t location);
+
+  //! Write the state of particles to a checkpoint file
+  //! \details A unique temporary file is written next to the checkpoint and
+  //! renamed, so an interrupted or concurrent write does not leave a partial
+  //! checkpoint
+  //! \param[in] phase Index corresponding to the phase
+  //! \param[in] filename Name of the checkpoint file
+  //! \param[in] checkpoint Step, time and analysis id of the checkpoint
+  //! \retval status Status of writing the checkpoint
+  bool write_checkpoint(unsigned phase, const std::string& filename,
+                        const mpm::binary::Checkpoint& checkpoint) const;
+
+  //! Create particles from a checkpoint file
+  //! \details Particles are created in bulk and placed in their stored cells
+  //! at their stored reference locations, no search is done. The mesh has to
+  //! have the cells of the checkpoint and no particles.
+  //! \param[in] phase Index corresponding to the phase
+  //! \param[in] filename Name of the checkpoint file
+  //! \param[in] particle_type Type of particles to create
+  //! \param[in] materials Materials of the particles by id
+  //! \param[out] checkpoint Step, time and analysis id of the checkpoint
+  //! \retval status Status of reading the checkpoint
+  bool read_checkpoint(
+      unsigned phase, const std::string& filename,
+      const std::string& particle_type,
+      const std::map<unsigned, std::shared_ptr<mpm::Material<Tdim>>>&
+          materials,
+      mpm::binary::Checkpoint* checkpoint);
+
+  //! Write the preprocessed mesh to a cache file
+  //! \details Nodes, cells and velocity constraints are written as in a
+  //! binary mesh file, with the cells and reference locations of the located
+  //! particles. A unique temporary file is written next to the cache and
+  //! renamed, so processes preprocessing the same mesh do not collide.
+  //! \param[in] filename Name of the cache file
+  //! \param[in] key Key of the inputs the mesh is preprocessed from
+  //! \param[in] coordinates Nodal coordinates
+  //! \param[in] cells Node ids of cells
+  //! \param[in] constraints Velocity constraints at node, dir and velocity
+  //! \retval status Status of writing the cache
+  bool write_cache(
+      const std::string& filename, std::uint64_t key,
+      const std::vector<VectorDim>& coordinates,
+      const std::vector<std::vector<mpm::Index>>& cells,
+      const std::vector<std::tuple<mpm::Index, unsigned, double>>&
+          constraints) const;
+
+  //! Create particles in their cells from a cache file
+  //! \details Particles are created in bulk and placed in their cached cells
+  //! at their cached reference locations, no search is done. The mesh has to
+  //! be created from the same cache and have no particles.
+  //! \param[in] filename Name of the cache file
+  //! \param[in] particle_type Type of particles to create
+  //! \retval status Status of reading the cache
+  bool read_cache_particles(const std::string& filename,
+                            const std::string& particle_type);
+
  private:
   // Locate a particle in mesh cells
   bool locate_particle_cells(std::shared_ptr<mpm::ParticleBase<Tdim>> particle);
+
+  //! Locate particles in mesh cells in one batch using a uniform grid of
+  //! cell bounding boxes
+  //! \param[in] particles Particles to locate
+  //! \retval particles Particles which cannot be located in the mesh
+  std::vector<std::shared_ptr<mpm::ParticleBase<Tdim>>> locate_particles_cells(
+      const std::vector<std::shared_ptr<mpm::ParticleBase<Tdim>>>& particles);
+
+  //! Initialise existing particles with HDF5 particle fields
+  //! \param[in] columns Particle fields, rows in the order of particles
+  void initialise_particles_hdf5(const mpm::HDF5ParticleColumns& columns);
+
+  //! Return quadrature points and weights of a cell
+  //! \param[in] npoints Number of quadrature points in each direction
+  //! \retval quadrature Local coordinates (row-wise) and weights of points
+  std::pair<Eigen::MatrixXd, Eigen::VectorXd> quadrature(
+      unsigned npoints) const;
+
+  //! Gather elements of a container with an active status in parallel
+  //! \param[in] container Container of elements
+  //! \param[out] active List of active elements
+  template <typename T>
+  void find_active(const Container<T>& container,
+                   tbb::concurrent_vector<std::shared_ptr<T>>* active) const;
   //! mesh id
   unsigned id_{std::numeric_limits<unsigned>::max()};
   //! Container of mesh neighbours
@@ -194,8 +408,26 @@ class Mesh {
   Container<NodeBase<Tdim>> nodes_;
   //! Map of nodes for fast retrieval
   Map<NodeBase<Tdim>> map_nodes_;
+  //! Compact list of active nodes
+  tbb::concurrent_vector<std::shared_ptr<NodeBase<Tdim>>> active_nodes_;
   //! Container of cells
   Container<Cell<Tdim>> cells_;
+  //! Compact list of cells with particles
+  tbb::concurrent_vector<std::shared_ptr<Cell<Tdim>>> active_cells_;
+  //! Index of a cell in the cell container for a given cell id
+  std::unordered_map<mpm::Index, mpm::Index> cell_index_;
+  //! Nodes with velocity constraints
+  std::vector<std::shared_ptr<NodeBase<Tdim>>> constrained_nodes_;
+  //! Direction of each velocity constraint
+  std::vector<unsigned> constraint_directions_;
+  //! Velocity of each velocity constraint
+  std::vector<double> constraint_velocities_;
+  //! Cell index of each particle in the particle container
+  std::vector<mpm::Index> particle_cells_;
+  //! Offsets of each cell in the cell to particle list (ncells + 1)
+  std::vector<mpm::Index> cell_particle_offsets_;
+  //! Cell to particle list of particle ids
+  std::vector<mpm::Index> cell_particles_;
   //! Logger
   std::unique_ptr<spdlog::logger> console_;
 };  // Mesh class
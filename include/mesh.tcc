@@ -19,21 +19,32 @@ bool mpm::Mesh<Tdim>::create_nodes(mpm::Index gnid,
   try {
     // Check if nodal coordinates is not empty
     if (!coordinates.empty()) {
-      for (const auto& node_coordinates : coordinates) {
-        // Add node to mesh and check
-        bool insert_status = this->add_node(
-            // Create a node of particular
-            Factory<mpm::NodeBase<Tdim>, mpm::Index,
-                    const Eigen::Matrix<double, Tdim, 1>&>::instance()
-                ->create(node_type, static_cast<mpm::Index>(gnid),
-                         node_coordinates));
-
-        // Increament node id
-        if (insert_status) ++gnid;
-        // When addition of node fails
-        else
+      // Look up node type once for all nodes
+      const auto create_node =
+          Factory<mpm::NodeBase<Tdim>, mpm::Index,
+                  const Eigen::Matrix<double, Tdim, 1>&>::instance()
+              ->creator(node_type);
+
+      // Create nodes in parallel
+      std::vector<std::shared_ptr<mpm::NodeBase<Tdim>>> nodes(
+          coordinates.size());
+      tbb::parallel_for(
+          std::size_t(0), coordinates.size(), [&](std::size_t i) {
+            nodes[i] = create_node(static_cast<mpm::Index>(gnid + i),
+                                   coordinates[i]);
+          });
+
+      // Add nodes to map, node ids should not be present in the mesh
+      map_nodes_.reserve(map_nodes_.size() + nodes.size());
+      for (auto itr = nodes.cbegin(); itr != nodes.cend(); ++itr) {
+        if (!map_nodes_.insert((*itr)->id(), *itr)) {
+          // Remove nodes added to the map
+          for (auto ritr = nodes.cbegin(); ritr != itr; ++ritr)
+            map_nodes_.remove((*ritr)->id());
           throw std::runtime_error("Addition of node to mesh failed!");
+        }
       }
+      nodes_.add(nodes.cbegin(), nodes.cend());
     } else
       // If the coordinates vector is empty
       throw std::runtime_error("List of coordinates is empty");
@@ -74,9 +85,65 @@ void mpm::Mesh<Tdim>::iterate_over_nodes(Toper oper) {
 template <unsigned Tdim>
 template <typename Toper, typename Tpred>
 void mpm::Mesh<Tdim>::iterate_over_nodes_predicate(Toper oper, Tpred pred) {
-  for (auto itr = nodes_.cbegin(); itr != nodes_.cend(); ++itr) {
-    if (pred(*itr)) oper(*itr);
-  }
+  tbb::parallel_for_each(
+      nodes_.cbegin(), nodes_.cend(),
+      [=](const std::shared_ptr<mpm::NodeBase<Tdim>>& node) {
+        if (pred(node)) oper(node);
+      });
+}
+
+//! Initialise nodes that were active in the previous step
+template <unsigned Tdim>
+void mpm::Mesh<Tdim>::initialise_active_nodes() {
+  this->iterate_over_active_nodes(
+      std::bind(&mpm::NodeBase<Tdim>::initialise, std::placeholders::_1));
+  active_nodes_.clear();
+}
+
+//! Activate nodes of cells with particles and build the active node list
+template <unsigned Tdim>
+void mpm::Mesh<Tdim>::activate_nodes() {
+  // Set status of nodes in cells with particles
+  this->iterate_over_active_cells(
+      std::bind(&mpm::Cell<Tdim>::activate_nodes, std::placeholders::_1));
+  // Compact active nodes
+  this->find_active_nodes();
+}
+
+//! Build a compact list of active nodes in parallel
+template <unsigned Tdim>
+void mpm::Mesh<Tdim>::find_active_nodes() {
+  this->find_active(nodes_, &active_nodes_);
+}
+
+//! Gather elements of a container with an active status in parallel
+template <unsigned Tdim>
+template <typename T>
+void mpm::Mesh<Tdim>::find_active(
+    const Container<T>& container,
+    tbb::concurrent_vector<std::shared_ptr<T>>* active) const {
+  using Iterator =
+      typename tbb::concurrent_vector<std::shared_ptr<T>>::const_iterator;
+
+  active->clear();
+  // Each task gathers active elements in its range and appends them in one go
+  tbb::parallel_for(tbb::blocked_range<Iterator>(container.cbegin(),
+                                                 container.cend()),
+                    [=](const tbb::blocked_range<Iterator>& range) {
+                      std::vector<std::shared_ptr<T>> elements;
+                      for (auto itr = range.begin(); itr != range.end(); ++itr)
+                        if ((*itr)->status()) elements.emplace_back(*itr);
+
+                      if (!elements.empty())
+                        active->grow_by(elements.cbegin(), elements.cend());
+                    });
+}
+
+//! Iterate over active nodes
+template <unsigned Tdim>
+template <typename Toper>
+void mpm::Mesh<Tdim>::iterate_over_active_nodes(Toper oper) {
+  tbb::parallel_for_each(active_nodes_.cbegin(), active_nodes_.cend(), oper);
 }
 
 //! Create cells from node lists
@@ -88,10 +155,13 @@ bool mpm::Mesh<Tdim>::create_cells(
   try {
     // Check if node id list is not empty
     if (!cells.empty()) {
-      for (const auto& nodes : cells) {
+      // Create cells and compute their geometry in parallel
+      std::vector<std::shared_ptr<mpm::Cell<Tdim>>> new_cells(cells.size());
+      tbb::parallel_for(std::size_t(0), cells.size(), [&](std::size_t i) {
+        const auto& nodes = cells[i];
         // Create cell with element
-        auto cell =
-            std::make_shared<mpm::Cell<Tdim>>(gcid, nodes.size(), element);
+        auto cell = std::make_shared<mpm::Cell<Tdim>>(
+            static_cast<mpm::Index>(gcid + i), nodes.size(), element);
 
         // Cell local node id
         unsigned local_nid = 0;
@@ -101,23 +171,28 @@ bool mpm::Mesh<Tdim>::create_cells(
           ++local_nid;
         }
 
-        // Add cell to mesh
-        bool insert_cell = false;
         // Check if cell has all nodes before inserting to mesh
-        if (cell->nnodes() == nodes.size()) {
-          // Initialise cell before insertion
-          cell->initialise();
-          // If cell is initialised insert to mesh
-          if (cell->is_initialised()) insert_cell = this->add_cell(cell);
-        } else
+        if (cell->nnodes() != nodes.size())
           throw std::runtime_error("Invalid node ids for cell!");
 
-        // Increament global cell id
-        if (insert_cell) ++gcid;
-        // When addition of cell fails
-        else
+        // Initialise cell before insertion
+        cell->initialise();
+        if (!cell->is_initialised())
+          throw std::runtime_error("Addition of cell to mesh failed!");
+        new_cells[i] = cell;
+      });
+
+      // Index cells, cell ids should not be present in the mesh
+      const mpm::Index ncells = cells_.size();
+      for (mpm::Index i = 0; i < new_cells.size(); ++i) {
+        if (!cell_index_.emplace(new_cells[i]->id(), ncells + i).second) {
+          // Remove indexed cells
+          for (mpm::Index j = 0; j < i; ++j)
+            cell_index_.erase(new_cells[j]->id());
           throw std::runtime_error("Addition of cell to mesh failed!");
+        }
       }
+      cells_.add(new_cells.cbegin(), new_cells.cend());
     } else {
       // If the coordinates vector is empty
       throw std::runtime_error("List of nodes of cells is empty");
@@ -133,6 +208,8 @@ bool mpm::Mesh<Tdim>::create_cells(
 template <unsigned Tdim>
 bool mpm::Mesh<Tdim>::add_cell(const std::shared_ptr<mpm::Cell<Tdim>>& cell) {
   bool insertion_status = cells_.add(cell);
+  // Cell is appended to the end of the container
+  if (insertion_status) cell_index_[cell->id()] = cells_.size() - 1;
   return insertion_status;
 }
 
@@ -142,6 +219,15 @@ bool mpm::Mesh<Tdim>::remove_cell(
     const std::shared_ptr<mpm::Cell<Tdim>>& cell) {
   // Remove a cell if found in the container
   bool status = cells_.remove(cell);
+  if (status) {
+    // Removal shifts cells in the container, so rebuild the cell index
+    cell_index_.clear();
+    mpm::Index index = 0;
+    for (auto citr = cells_.cbegin(); citr != cells_.cend(); ++citr, ++index)
+      cell_index_[(*citr)->id()] = index;
+    // and the cell to particle list
+    this->build_cell_particles();
+  }
   return status;
 }
 
@@ -152,6 +238,97 @@ void mpm::Mesh<Tdim>::iterate_over_cells(Toper oper) {
   tbb::parallel_for_each(cells_.cbegin(), cells_.cend(), oper);
 }
 
+//! Rebuild the cell to particle list from particle cell ids
+template <unsigned Tdim>
+void mpm::Mesh<Tdim>::build_cell_particles() {
+  const mpm::Index ncells = cells_.size();
+  const mpm::Index nparticles = particles_.size();
+  // Invalid cell index for particles not located in the mesh
+  const mpm::Index invalid = std::numeric_limits<mpm::Index>::max();
+
+  // Number of particles in each cell
+  std::vector<std::atomic<mpm::Index>> counts(ncells);
+  particle_cells_.resize(nparticles);
+
+  // Find cell index of each particle and count particles per cell
+  const auto pbegin = particles_.cbegin();
+  tbb::parallel_for(mpm::Index(0), nparticles, [&](mpm::Index i) {
+    const mpm::Index cell_id = (*(pbegin + i))->cell_id();
+    mpm::Index index = invalid;
+    if (cell_id != invalid) {
+      auto citr = cell_index_.find(cell_id);
+      if (citr != cell_index_.end()) {
+        index = citr->second;
+        counts[index].fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+    particle_cells_[i] = index;
+  });
+
+  // Exclusive scan of counts gives the offset of each cell
+  cell_particle_offsets_.resize(ncells + 1);
+  cell_particle_offsets_[0] = 0;
+  tbb::parallel_scan(
+      tbb::blocked_range<mpm::Index>(0, ncells), mpm::Index(0),
+      [&](const tbb::blocked_range<mpm::Index>& range, mpm::Index sum,
+          bool is_final) {
+        for (mpm::Index i = range.begin(); i != range.end(); ++i) {
+          sum += counts[i].load(std::memory_order_relaxed);
+          if (is_final) cell_particle_offsets_[i + 1] = sum;
+        }
+        return sum;
+      },
+      std::plus<mpm::Index>());
+
+  // Counts are reused as insertion positions
+  tbb::parallel_for(mpm::Index(0), ncells, [&](mpm::Index i) {
+    counts[i].store(cell_particle_offsets_[i], std::memory_order_relaxed);
+  });
+
+  // Scatter particle ids to their cells
+  cell_particles_.resize(cell_particle_offsets_[ncells]);
+  tbb::parallel_for(mpm::Index(0), nparticles, [&](mpm::Index i) {
+    const mpm::Index index = particle_cells_[i];
+    if (index != invalid)
+      cell_particles_[counts[index].fetch_add(1, std::memory_order_relaxed)] =
+          (*(pbegin + i))->id();
+  });
+
+  // Sort particle ids in each cell for a deterministic order
+  tbb::parallel_for(mpm::Index(0), ncells, [&](mpm::Index i) {
+    std::sort(cell_particles_.begin() + cell_particle_offsets_[i],
+              cell_particles_.begin() + cell_particle_offsets_[i + 1]);
+  });
+}
+
+//! Return ids of particles in a cell
+template <unsigned Tdim>
+std::vector<mpm::Index> mpm::Mesh<Tdim>::cell_particles(
+    mpm::Index cell_id) const {
+  std::vector<mpm::Index> particles;
+  const auto citr = cell_index_.find(cell_id);
+  // Cells added after the list was built have no particles in it
+  if (citr != cell_index_.end() &&
+      citr->second + 1 < cell_particle_offsets_.size())
+    particles.assign(
+        cell_particles_.cbegin() + cell_particle_offsets_[citr->second],
+        cell_particles_.cbegin() + cell_particle_offsets_[citr->second + 1]);
+  return particles;
+}
+
+//! Build a compact list of cells with particles in parallel
+template <unsigned Tdim>
+void mpm::Mesh<Tdim>::find_active_cells() {
+  this->find_active(cells_, &active_cells_);
+}
+
+//! Iterate over cells with particles
+template <unsigned Tdim>
+template <typename Toper>
+void mpm::Mesh<Tdim>::iterate_over_active_cells(Toper oper) {
+  tbb::parallel_for_each(active_cells_.cbegin(), active_cells_.cend(), oper);
+}
+
 //! Create particles from coordinates
 template <unsigned Tdim>
 bool mpm::Mesh<Tdim>::create_particles(
@@ -161,20 +338,48 @@ bool mpm::Mesh<Tdim>::create_particles(
   try {
     // Check if particle coordinates is not empty
     if (!coordinates.empty()) {
-      for (const auto& particle_coordinates : coordinates) {
-        // Add particle to mesh and check
-        bool insert_status = this->add_particle(
-            Factory<mpm::ParticleBase<Tdim>, mpm::Index,
-                    const Eigen::Matrix<double, Tdim, 1>&>::instance()
-                ->create(particle_type, static_cast<mpm::Index>(gpid),
-                         particle_coordinates));
-
-        // Increament particle id
-        if (insert_status) ++gpid;
-        // When addition of particle fails
-        else
-          throw std::runtime_error("Addition of particle to mesh failed!");
-      }
+      // Look up particle type once for all particles
+      const auto create_particle =
+          Factory<mpm::ParticleBase<Tdim>, mpm::Index,
+                  const Eigen::Matrix<double, Tdim, 1>&>::instance()
+              ->creator(particle_type);
+
+      // Create particles in parallel
+      std::vector<std::shared_ptr<mpm::ParticleBase<Tdim>>> particles(
+          coordinates.size());
+      tbb::parallel_for(
+          std::size_t(0), coordinates.size(), [&](std::size_t i) {
+            particles[i] = create_particle(
+                static_cast<mpm::Index>(gpid + i), coordinates[i]);
+          });
+
+      // Particle ids are contiguous, check none of them is in the mesh
+      const mpm::Index last_pid = gpid + coordinates.size();
+      std::atomic<bool> duplicate{false};
+      tbb::parallel_for_each(
+          particles_.cbegin(), particles_.cend(),
+          [&](const std::shared_ptr<mpm::ParticleBase<Tdim>>& particle) {
+            if (particle->id() >= gpid && particle->id() < last_pid)
+              duplicate = true;
+          });
+      if (duplicate)
+        throw std::runtime_error("Addition of particle to mesh failed!");
+
+      // Locate particles in cells and add located particles to mesh
+      const auto unlocatable = this->locate_particles_cells(particles);
+      if (!unlocatable.empty())
+        particles.erase(
+            std::remove_if(
+                particles.begin(), particles.end(),
+                [](const std::shared_ptr<mpm::ParticleBase<Tdim>>& particle) {
+                  return particle->cell_id() ==
+                         std::numeric_limits<mpm::Index>::max();
+                }),
+            particles.end());
+      particles_.add(particles.cbegin(), particles.cend());
+
+      if (!unlocatable.empty())
+        throw std::runtime_error("Particle not found in mesh");
     } else {
       // If the coordinates vector is empty
       throw std::runtime_error("List of coordinates is empty");
@@ -186,6 +391,142 @@ bool mpm::Mesh<Tdim>::create_particles(
   return status;
 }
 
+//! Generate particles at quadrature points of cells
+template <unsigned Tdim>
+bool mpm::Mesh<Tdim>::generate_particles(
+    mpm::Index gpid, const std::string& particle_type, unsigned npoints,
+    const std::vector<mpm::Index>& cell_ids) {
+  bool status = true;
+  try {
+    // Cells to fill with particles
+    std::vector<std::shared_ptr<mpm::Cell<Tdim>>> cells;
+    if (cell_ids.empty())
+      cells.assign(cells_.cbegin(), cells_.cend());
+    else {
+      const auto cbegin = cells_.cbegin();
+      for (const auto cell_id : cell_ids) {
+        const auto citr = cell_index_.find(cell_id);
+        if (citr == cell_index_.end())
+          throw std::runtime_error("Invalid cell id to generate particles");
+        cells.emplace_back(*(cbegin + citr->second));
+      }
+    }
+    if (cells.empty())
+      throw std::runtime_error("No cells to generate particles");
+
+    // Quadrature points and weights
+    const auto quadrature = this->quadrature(npoints);
+    const mpm::Index nquadratures = quadrature.second.size();
+
+    // Look up particle type once for all particles
+    const auto create_particle =
+        Factory<mpm::ParticleBase<Tdim>, mpm::Index,
+                const Eigen::Matrix<double, Tdim, 1>&>::instance()
+            ->creator(particle_type);
+
+    // Particle ids are contiguous, check none of them is in the mesh
+    const mpm::Index last_pid = gpid + cells.size() * nquadratures;
+    std::atomic<bool> duplicate{false};
+    tbb::parallel_for_each(
+        particles_.cbegin(), particles_.cend(),
+        [&](const std::shared_ptr<mpm::ParticleBase<Tdim>>& particle) {
+          if (particle->id() >= gpid && particle->id() < last_pid)
+            duplicate = true;
+        });
+    if (duplicate)
+      throw std::runtime_error("Addition of particle to mesh failed!");
+
+    // Create particles at quadrature points of each cell in parallel, the
+    // reference location of a particle is its quadrature point, so particles
+    // are assigned to their cell without a search
+    std::vector<std::shared_ptr<mpm::ParticleBase<Tdim>>> particles(
+        cells.size() * nquadratures);
+    std::atomic<bool> assigned{true};
+    tbb::parallel_for(std::size_t(0), cells.size(), [&](std::size_t c) {
+      const auto points =
+          cells[c]->quadrature_points(quadrature.first, quadrature.second);
+      for (mpm::Index q = 0; q < nquadratures; ++q) {
+        const mpm::Index index = c * nquadratures + q;
+        auto particle = create_particle(gpid + index, points[q].first);
+        const VectorDim xi = quadrature.first.row(q).transpose();
+        if (!particle->assign_cell_xi(cells[c], xi)) assigned = false;
+        particle->assign_volume(points[q].second);
+        particles[index] = particle;
+      }
+    });
+    if (!assigned)
+      throw std::runtime_error("Generated particles cannot be assigned cells");
+
+    particles_.add(particles.cbegin(), particles.cend());
+  } catch (std::exception& exception) {
+    console_->error("{} #{}: {}\n", __FILE__, __LINE__, exception.what());
+    status = false;
+  }
+  return status;
+}
+
+//! Return ids of cells with a centroid inside a box
+template <unsigned Tdim>
+std::vector<mpm::Index> mpm::Mesh<Tdim>::cell_ids_in_box(
+    const VectorDim& min, const VectorDim& max) const {
+  tbb::concurrent_vector<mpm::Index> ids;
+  tbb::parallel_for_each(
+      cells_.cbegin(), cells_.cend(),
+      [&](const std::shared_ptr<mpm::Cell<Tdim>>& cell) {
+        const VectorDim centroid = cell->centroid();
+        if ((centroid.array() >= min.array()).all() &&
+            (centroid.array() <= max.array()).all())
+          ids.emplace_back(cell->id());
+      });
+  std::vector<mpm::Index> cell_ids(ids.begin(), ids.end());
+  std::sort(cell_ids.begin(), cell_ids.end());
+  return cell_ids;
+}
+
+//! Return quadrature points and weights of a quadrilateral cell
+template <>
+inline std::pair<Eigen::MatrixXd, Eigen::VectorXd> mpm::Mesh<2>::quadrature(
+    unsigned npoints) const {
+  switch (npoints) {
+    case 1: {
+      mpm::QuadrilateralQuadrature<2, 1> quadrature;
+      return std::make_pair(quadrature.quadratures(), quadrature.weights());
+    }
+    case 2: {
+      mpm::QuadrilateralQuadrature<2, 4> quadrature;
+      return std::make_pair(quadrature.quadratures(), quadrature.weights());
+    }
+    case 3: {
+      mpm::QuadrilateralQuadrature<2, 9> quadrature;
+      return std::make_pair(quadrature.quadratures(), quadrature.weights());
+    }
+    default:
+      throw std::runtime_error("Number of quadrature points should be 1-3");
+  }
+}
+
+//! Return quadrature points and weights of a hexahedron cell
+template <>
+inline std::pair<Eigen::MatrixXd, Eigen::VectorXd> mpm::Mesh<3>::quadrature(
+    unsigned npoints) const {
+  switch (npoints) {
+    case 1: {
+      mpm::HexahedronQuadrature<3, 1> quadrature;
+      return std::make_pair(quadrature.quadratures(), quadrature.weights());
+    }
+    case 2: {
+      mpm::HexahedronQuadrature<3, 8> quadrature;
+      return std::make_pair(quadrature.quadratures(), quadrature.weights());
+    }
+    case 3: {
+      mpm::HexahedronQuadrature<3, 27> quadrature;
+      return std::make_pair(quadrature.quadratures(), quadrature.weights());
+    }
+    default:
+      throw std::runtime_error("Number of quadrature points should be 1-3");
+  }
+}
+
 //! Add a particle pointer to the mesh
 template <unsigned Tdim>
 bool mpm::Mesh<Tdim>::add_particle(
@@ -210,6 +551,11 @@ bool mpm::Mesh<Tdim>::remove_particle(
     const std::shared_ptr<mpm::ParticleBase<Tdim>>& particle) {
   // Remove a particle if found in the container
   bool status = particles_.remove(particle);
+  if (status) {
+    // Remove the particle from its cell and the cell to particle list
+    particle->remove_cell();
+    this->build_cell_particles();
+  }
   return status;
 }
 
@@ -218,17 +564,27 @@ template <unsigned Tdim>
 std::vector<std::shared_ptr<mpm::ParticleBase<Tdim>>>
     mpm::Mesh<Tdim>::locate_particles_mesh() {
 
-  std::vector<std::shared_ptr<mpm::ParticleBase<Tdim>>> particles;
+  // Particles which are not in their current cell
+  tbb::concurrent_vector<std::shared_ptr<mpm::ParticleBase<Tdim>>> relocate;
 
   tbb::parallel_for_each(
       particles_.cbegin(), particles_.cend(),
-      [=, &particles](std::shared_ptr<mpm::ParticleBase<Tdim>> particle) {
-        // If particle is not found in mesh add to a list of particles
-        if (!this->locate_particle_cells(particle))
-          // Needs a lock guard here
-          particles.emplace_back(particle);
+      [&relocate](std::shared_ptr<mpm::ParticleBase<Tdim>> particle) {
+        // Check the current cell if it is not invalid
+        if (particle->cell_id() == std::numeric_limits<mpm::Index>::max() ||
+            !particle->compute_reference_location())
+          relocate.emplace_back(particle);
       });
 
+  // Locate remaining particles in one batch
+  auto particles = this->locate_particles_cells(
+      std::vector<std::shared_ptr<mpm::ParticleBase<Tdim>>>(relocate.begin(),
+                                                            relocate.end()));
+
+  // Update particle ids of cells and list of cells with particles
+  this->build_cell_particles();
+  this->find_active_cells();
+
   return particles;
 }
 
@@ -256,6 +612,141 @@ bool mpm::Mesh<Tdim>::locate_particle_cells(
   return status;
 }
 
+//! Locate particles in mesh cells in one batch
+template <unsigned Tdim>
+std::vector<std::shared_ptr<mpm::ParticleBase<Tdim>>>
+    mpm::Mesh<Tdim>::locate_particles_cells(
+        const std::vector<std::shared_ptr<mpm::ParticleBase<Tdim>>>&
+            particles) {
+  // Particles which cannot be located
+  tbb::concurrent_vector<std::shared_ptr<mpm::ParticleBase<Tdim>>> unlocatable;
+
+  const mpm::Index ncells = cells_.size();
+  if (ncells == 0 || particles.empty())
+    return std::vector<std::shared_ptr<mpm::ParticleBase<Tdim>>>(
+        particles.begin(), particles.end());
+
+  // Bounding boxes of cells
+  std::vector<VectorDim> cell_min(ncells), cell_max(ncells);
+  const auto cbegin = cells_.cbegin();
+  tbb::parallel_for(mpm::Index(0), ncells, [&](mpm::Index i) {
+    const Eigen::MatrixXd coordinates = (*(cbegin + i))->nodal_coordinates();
+    cell_min[i] = coordinates.colwise().minCoeff().transpose();
+    cell_max[i] = coordinates.colwise().maxCoeff().transpose();
+  });
+
+  // Domain and mean cell size
+  VectorDim domain_min = cell_min[0], domain_max = cell_max[0];
+  VectorDim mean_size = VectorDim::Zero();
+  for (mpm::Index i = 0; i < ncells; ++i) {
+    domain_min = domain_min.cwiseMin(cell_min[i]);
+    domain_max = domain_max.cwiseMax(cell_max[i]);
+    mean_size += cell_max[i] - cell_min[i];
+  }
+  mean_size /= static_cast<double>(ncells);
+
+  // Uniform grid with about one cell per bin
+  const double tolerance = 1.E-9 * mean_size.maxCoeff();
+  const mpm::Index max_bins = static_cast<mpm::Index>(
+      2 * std::ceil(std::pow(static_cast<double>(ncells), 1. / Tdim)));
+  std::array<mpm::Index, Tdim> nbins;
+  VectorDim bin_size;
+  mpm::Index total_bins = 1;
+  for (unsigned i = 0; i < Tdim; ++i) {
+    const double length = domain_max(i) - domain_min(i);
+    nbins[i] = (mean_size(i) > 0.)
+                   ? std::min(max_bins, std::max(mpm::Index(1),
+                                                 static_cast<mpm::Index>(
+                                                     length / mean_size(i))))
+                   : 1;
+    bin_size(i) = (length > 0.) ? length / nbins[i] : 1.;
+    total_bins *= nbins[i];
+  }
+
+  // Bin of a point in each direction
+  const auto bin = [&](const VectorDim& point) {
+    std::array<mpm::Index, Tdim> index;
+    for (unsigned i = 0; i < Tdim; ++i) {
+      const double position = (point(i) - domain_min(i)) / bin_size(i);
+      index[i] = (position <= 0.) ? 0
+                                  : std::min(nbins[i] - 1,
+                                             static_cast<mpm::Index>(position));
+    }
+    return index;
+  };
+
+  // Call a function with the flat index of each bin a cell overlaps
+  const auto for_each_bin = [&](mpm::Index cell, auto function) {
+    const auto first = bin((cell_min[cell].array() - tolerance).matrix());
+    const auto last = bin((cell_max[cell].array() + tolerance).matrix());
+    std::array<mpm::Index, Tdim> index = first;
+    while (true) {
+      mpm::Index flat = 0;
+      for (int i = Tdim - 1; i >= 0; --i) flat = flat * nbins[i] + index[i];
+      function(flat);
+      unsigned i = 0;
+      for (; i < Tdim; ++i) {
+        if (index[i] < last[i]) {
+          ++index[i];
+          break;
+        }
+        index[i] = first[i];
+      }
+      if (i == Tdim) break;
+    }
+  };
+
+  // Count cells in each bin, then scatter cell indices to bins
+  std::vector<std::atomic<mpm::Index>> counts(total_bins);
+  tbb::parallel_for(mpm::Index(0), ncells, [&](mpm::Index i) {
+    for_each_bin(i, [&](mpm::Index flat) {
+      counts[flat].fetch_add(1, std::memory_order_relaxed);
+    });
+  });
+  std::vector<mpm::Index> offsets(total_bins + 1, 0);
+  for (mpm::Index i = 0; i < total_bins; ++i) {
+    offsets[i + 1] = offsets[i] + counts[i];
+    counts[i].store(offsets[i], std::memory_order_relaxed);
+  }
+  std::vector<mpm::Index> bin_cells(offsets[total_bins]);
+  tbb::parallel_for(mpm::Index(0), ncells, [&](mpm::Index i) {
+    for_each_bin(i, [&](mpm::Index flat) {
+      bin_cells[counts[flat].fetch_add(1, std::memory_order_relaxed)] = i;
+    });
+  });
+  // Check cells in the order of the cell container
+  tbb::parallel_for(mpm::Index(0), total_bins, [&](mpm::Index i) {
+    std::sort(bin_cells.begin() + offsets[i],
+              bin_cells.begin() + offsets[i + 1]);
+  });
+
+  // Locate each particle in the cells of its bin
+  tbb::parallel_for(std::size_t(0), particles.size(), [&](std::size_t p) {
+    const auto& particle = particles[p];
+    const VectorDim coordinates = particle->coordinates();
+    bool status = false;
+    if (((coordinates - domain_min).array() >= -tolerance).all() &&
+        ((domain_max - coordinates).array() >= -tolerance).all()) {
+      const auto index = bin(coordinates);
+      mpm::Index flat = 0;
+      for (int i = Tdim - 1; i >= 0; --i) flat = flat * nbins[i] + index[i];
+      for (mpm::Index c = offsets[flat]; c < offsets[flat + 1]; ++c) {
+        const auto& cell = *(cbegin + bin_cells[c]);
+        // Reference location is computed once and reused for the particle
+        const VectorDim xi = cell->transform_real_to_unit_cell(coordinates);
+        if ((xi.array() >= -1.).all() && (xi.array() <= 1.).all()) {
+          status = particle->assign_cell_xi(cell, xi);
+          break;
+        }
+      }
+    }
+    if (!status) unlocatable.emplace_back(particle);
+  });
+
+  return std::vector<std::shared_ptr<mpm::ParticleBase<Tdim>>>(
+      unlocatable.begin(), unlocatable.end());
+}
+
 //! Iterate over particles
 template <unsigned Tdim>
 template <typename Toper>
@@ -285,15 +776,14 @@ bool mpm::Mesh<Tdim>::add_neighbour(
 template <unsigned Tdim>
 std::vector<Eigen::Matrix<double, 3, 1>>
     mpm::Mesh<Tdim>::particle_coordinates() {
-  std::vector<Eigen::Matrix<double, 3, 1>> particle_coordinates;
-  for (auto pitr = particles_.cbegin(); pitr != particles_.cend(); ++pitr) {
-    Eigen::Vector3d coordinates;
-    coordinates.setZero();
-    auto pcoords = (*pitr)->coordinates();
+  const auto pbegin = particles_.cbegin();
+  std::vector<Eigen::Matrix<double, 3, 1>> particle_coordinates(
+      this->nparticles(), Eigen::Matrix<double, 3, 1>::Zero());
+  tbb::parallel_for(mpm::Index(0), this->nparticles(), [&](mpm::Index i) {
+    const auto pcoords = (*(pbegin + i))->coordinates();
     // Fill coordinates to the size of dimensions
-    for (unsigned i = 0; i < Tdim; ++i) coordinates(i) = pcoords(i);
-    particle_coordinates.emplace_back(coordinates);
-  }
+    for (unsigned j = 0; j < Tdim; ++j) particle_coordinates[i](j) = pcoords(j);
+  });
   return particle_coordinates;
 }
 
@@ -301,15 +791,14 @@ std::vector<Eigen::Matrix<double, 3, 1>>
 template <unsigned Tdim>
 std::vector<Eigen::Matrix<double, 3, 1>> mpm::Mesh<Tdim>::particle_stresses(
     unsigned phase) {
-  std::vector<Eigen::Matrix<double, 3, 1>> particle_stresses;
-  for (auto pitr = particles_.cbegin(); pitr != particles_.cend(); ++pitr) {
-    Eigen::Vector3d stresses;
-    stresses.setZero();
-    auto pstress = (*pitr)->stress(phase);
+  const auto pbegin = particles_.cbegin();
+  std::vector<Eigen::Matrix<double, 3, 1>> particle_stresses(
+      this->nparticles(), Eigen::Matrix<double, 3, 1>::Zero());
+  tbb::parallel_for(mpm::Index(0), this->nparticles(), [&](mpm::Index i) {
+    const auto pstress = (*(pbegin + i))->stress(phase);
     // Fill stresses to the size of dimensions
-    for (unsigned i = 0; i < Tdim; ++i) stresses(i) = pstress(i);
-    particle_stresses.emplace_back(stresses);
-  }
+    for (unsigned j = 0; j < Tdim; ++j) particle_stresses[i](j) = pstress(j);
+  });
   return particle_stresses;
 }
 
@@ -321,6 +810,18 @@ bool mpm::Mesh<Tdim>::assign_velocity_constraints(
   bool status = false;
   try {
     if (nodes_.size()) {
+      // Constraint as (node id, direction, velocity, node)
+      using Constraint = std::tuple<mpm::Index, unsigned, double,
+                                    std::shared_ptr<mpm::NodeBase<Tdim>>>;
+      std::vector<Constraint> constraints;
+      constraints.reserve(constrained_nodes_.size() +
+                          velocity_constraints.size());
+      // Existing constraints
+      for (unsigned i = 0; i < constrained_nodes_.size(); ++i)
+        constraints.emplace_back(std::make_tuple(
+            constrained_nodes_[i]->id(), constraint_directions_[i],
+            constraint_velocities_[i], constrained_nodes_[i]));
+
       for (const auto& velocity_constraint : velocity_constraints) {
         // Node id
         mpm::Index nid = std::get<0>(velocity_constraint);
@@ -329,12 +830,38 @@ bool mpm::Mesh<Tdim>::assign_velocity_constraints(
         // Velocity
         double velocity = std::get<2>(velocity_constraint);
 
-        // Apply constraint
-        status = map_nodes_[nid]->assign_velocity_constraint(dir, velocity);
-
-        if (!status)
+        // Constrain directions can take values between 0 and Dim * Nphases
+        const auto node = map_nodes_[nid];
+        if (dir >= (Tdim * node->nphases()))
           throw std::runtime_error("Node or velocity constraint is invalid");
+
+        constraints.emplace_back(std::make_tuple(nid, dir, velocity, node));
+      }
+
+      // Order constraints by node and direction, keeping the first constraint
+      std::stable_sort(constraints.begin(), constraints.end(),
+                       [](const Constraint& lhs, const Constraint& rhs) {
+                         return std::tie(std::get<0>(lhs), std::get<1>(lhs)) <
+                                std::tie(std::get<0>(rhs), std::get<1>(rhs));
+                       });
+      constraints.erase(
+          std::unique(constraints.begin(), constraints.end(),
+                      [](const Constraint& lhs, const Constraint& rhs) {
+                        return std::get<0>(lhs) == std::get<0>(rhs) &&
+                               std::get<1>(lhs) == std::get<1>(rhs);
+                      }),
+          constraints.end());
+
+      // Flat arrays of constraints
+      constrained_nodes_.clear();
+      constraint_directions_.clear();
+      constraint_velocities_.clear();
+      for (const auto& constraint : constraints) {
+        constrained_nodes_.emplace_back(std::get<3>(constraint));
+        constraint_directions_.emplace_back(std::get<1>(constraint));
+        constraint_velocities_.emplace_back(std::get<2>(constraint));
       }
+      status = true;
     } else {
       throw std::runtime_error(
           "No nodes have been assigned in mesh, cannot assign velocity "
@@ -347,212 +874,646 @@ bool mpm::Mesh<Tdim>::assign_velocity_constraints(
   return status;
 }
 
+//! Assign a velocity constraint to a set of nodes
+template <unsigned Tdim>
+bool mpm::Mesh<Tdim>::assign_velocity_constraints(
+    const std::vector<mpm::Index>& node_set, unsigned dir, double velocity) {
+  std::vector<std::tuple<mpm::Index, unsigned, double>> velocity_constraints;
+  velocity_constraints.reserve(node_set.size());
+  for (const auto nid : node_set)
+    velocity_constraints.emplace_back(std::make_tuple(nid, dir, velocity));
+
+  return this->assign_velocity_constraints(velocity_constraints);
+}
+
+//! Apply velocity constraints to active nodes in parallel
+template <unsigned Tdim>
+void mpm::Mesh<Tdim>::apply_velocity_constraints() {
+  tbb::parallel_for(
+      std::size_t(0), constrained_nodes_.size(), [&](std::size_t i) {
+        // Only active nodes carry nodal values in a step
+        if (constrained_nodes_[i]->status())
+          constrained_nodes_[i]->apply_velocity_constraint(
+              constraint_directions_[i], constraint_velocities_[i]);
+      });
+}
+
 //! Write particles to HDF5
 template <unsigned Tdim>
 bool mpm::Mesh<Tdim>::write_particles_hdf5(unsigned phase,
-                                           const std::string& filename) {
-  const unsigned nparticles = this->nparticles();
-
-  std::vector<HDF5Particle> particle_data;  // = new HDF5Particle[nparticles];
-  particle_data.reserve(nparticles);
+                                           const std::string& filename,
+                                           const mpm::HDF5Options& options) {
+  bool status = true;
+  try {
+    mpm::HDF5ParticleColumns columns;
+    this->gather_particles_hdf5(phase, &columns);
+    status = mpm::write_hdf5_particles(filename, columns, options);
+  } catch (std::exception& exception) {
+    console_->error("{} #{}: {}\n", __FILE__, __LINE__, exception.what());
+    status = false;
+  }
+  return status;
+}
 
-  mpm::Index i = 0;
-  for (auto pitr = particles_.cbegin(); pitr != particles_.cend(); ++pitr) {
+//! Write particles to HDF5 with one dataset per field
+template <unsigned Tdim>
+bool mpm::Mesh<Tdim>::write_particles_hdf5_columns(
+    unsigned phase, hid_t location, const mpm::HDF5Options& options) {
+  bool status = true;
+  try {
+    mpm::HDF5ParticleColumns columns;
+    this->gather_particles_hdf5(phase, &columns);
+    status = mpm::write_hdf5_particle_columns(location, columns, options, 0,
+                                              columns.size());
+  } catch (std::exception& exception) {
+    console_->error("{} #{}: {}\n", __FILE__, __LINE__, exception.what());
+    status = false;
+  }
+  return status;
+}
 
-    Eigen::Vector3d coordinates;
-    coordinates.setZero();
-    Eigen::VectorXd coords = (*pitr)->coordinates();
-    for (unsigned j = 0; j < Tdim; ++j) coordinates[j] = coords[j];
+//! Gather particle fields for HDF5 output
+template <unsigned Tdim>
+void mpm::Mesh<Tdim>::gather_particles_hdf5(
+    unsigned phase, mpm::HDF5ParticleColumns* columns,
+    const mpm::HDF5Selection& selection) const {
+  const mpm::Index nparticles = this->nparticles();
+  const auto pbegin = particles_.cbegin();
+
+  // Indices of particles selected by regions, ids and decimation
+  std::vector<mpm::Index> selected;
+  if (!selection.all_particles()) {
+    std::vector<std::uint8_t> flags(nparticles);
+    tbb::parallel_for(mpm::Index(0), nparticles, [&](mpm::Index i) {
+      const auto& particle = *(pbegin + i);
+      const VectorDim coordinates = particle->coordinates();
+      flags[i] = selection.selects(particle->id(), coordinates.data(), Tdim);
+    });
+    selected.reserve(std::count(flags.begin(), flags.end(), 1));
+    for (mpm::Index i = 0; i < nparticles; ++i)
+      if (flags[i]) selected.emplace_back(i);
+  }
+  const mpm::Index nselected =
+      selection.all_particles() ? nparticles : selected.size();
+
+  // Only the requested fields are gathered
+  const unsigned fields = selection.fields;
+  columns->resize(Tdim, nselected, fields);
+
+  tbb::parallel_for(mpm::Index(0), nselected, [&](mpm::Index i) {
+    const auto& particle =
+        *(pbegin + (selection.all_particles() ? i : selected[i]));
+    columns->ids[i] = particle->id();
+    if (fields & mpm::HDF5Field::Mass)
+      columns->masses[i] = particle->mass(phase);
+
+    if (fields & mpm::HDF5Field::Coordinates) {
+      const VectorDim coords = particle->coordinates();
+      for (unsigned j = 0; j < Tdim; ++j)
+        columns->coordinates[i * Tdim + j] = coords(j);
+    }
+    if (fields & mpm::HDF5Field::Velocity) {
+      const Eigen::VectorXd velocity = particle->velocity(phase);
+      for (unsigned j = 0; j < Tdim; ++j)
+        columns->velocities[i * Tdim + j] = velocity(j);
+    }
 
-    Eigen::Vector3d velocity;
-    velocity.setZero();
-    for (unsigned j = 0; j < Tdim; ++j)
-      velocity[j] = (*pitr)->velocity(phase)[j];
+    if (fields & mpm::HDF5Field::Stress) {
+      const Eigen::Matrix<double, 6, 1> stress = particle->stress(phase);
+      for (unsigned j = 0; j < 6; ++j) columns->stresses[i * 6 + j] = stress(j);
+    }
+    if (fields & mpm::HDF5Field::Strain) {
+      const Eigen::Matrix<double, 6, 1> strain = particle->strain(phase);
+      for (unsigned j = 0; j < 6; ++j) columns->strains[i * 6 + j] = strain(j);
+    }
 
-    Eigen::Matrix<double, 6, 1> stress = (*pitr)->stress(phase);
+    if (fields & mpm::HDF5Field::VolumetricStrain)
+      columns->volumetric_strains[i] =
+          particle->volumetric_strain_centroid(phase);
+    if (fields & mpm::HDF5Field::Status)
+      columns->statuses[i] = particle->status();
+  });
+}
 
-    Eigen::Matrix<double, 6, 1> strain = (*pitr)->strain(phase);
+//! Read particles from HDF5
+template <unsigned Tdim>
+bool mpm::Mesh<Tdim>::read_particles_hdf5(unsigned phase,
+                                          const std::string& filename) {
+  bool status = true;
+  try {
+    mpm::HDF5ParticleColumns columns;
+    mpm::read_hdf5_particles(filename, Tdim, &columns);
+    this->initialise_particles_hdf5(columns);
+  } catch (std::exception& exception) {
+    console_->error("{} #{}: {}\n", __FILE__, __LINE__, exception.what());
+    status = false;
+  }
+  return status;
+}
 
-    particle_data[i].id = (*pitr)->id();
-    particle_data[i].mass = (*pitr)->mass(phase);
+//! Read particles from HDF5 datasets with one dataset per field
+template <unsigned Tdim>
+bool mpm::Mesh<Tdim>::read_particles_hdf5_columns(unsigned phase,
+                                                  hid_t location) {
+  bool status = true;
+  try {
+    mpm::HDF5ParticleColumns columns;
+    mpm::read_hdf5_particle_columns(location, &columns);
+    this->initialise_particles_hdf5(columns);
+  } catch (std::exception& exception) {
+    console_->error("{} #{}: {}\n", __FILE__, __LINE__, exception.what());
+    status = false;
+  }
+  return status;
+}
 
-    particle_data[i].coord_x = coordinates[0];
-    particle_data[i].coord_y = coordinates[1];
-    particle_data[i].coord_z = coordinates[2];
+//! Initialise existing particles with HDF5 particle fields
+template <unsigned Tdim>
+void mpm::Mesh<Tdim>::initialise_particles_hdf5(
+    const mpm::HDF5ParticleColumns& columns) {
+  const mpm::Index nparticles = this->nparticles();
+  if (columns.size() != nparticles)
+    throw std::runtime_error(
+        "Number of HDF5 particles does not match the mesh");
+  if (columns.fields != mpm::HDF5Field::AllFields)
+    throw std::runtime_error("HDF5 particle file does not hold all fields");
+  if (columns.dim != Tdim)
+    throw std::runtime_error("HDF5 particle dimension does not match");
+
+  // Initialise particles with HDF5 data
+  const auto pbegin = particles_.cbegin();
+  tbb::parallel_for(mpm::Index(0), nparticles, [&](mpm::Index i) {
+    (*(pbegin + i))->initialise_particle(columns.particle(i));
+  });
+}
 
-    particle_data[i].velocity_x = velocity[0];
-    particle_data[i].velocity_y = velocity[1];
-    particle_data[i].velocity_z = velocity[2];
+//! Create particles from HDF5
+template <unsigned Tdim>
+bool mpm::Mesh<Tdim>::create_particles_hdf5(const std::string& particle_type,
+                                            const std::string& filename) {
+  bool status = true;
+  try {
+    // Particle store is sized from the file
+    mpm::HDF5ParticleColumns columns;
+    mpm::read_hdf5_particles(filename, Tdim, &columns);
+    const mpm::Index nparticles = columns.size();
+    if (nparticles == 0)
+      throw std::runtime_error("HDF5 particle file is empty");
+    if (columns.fields != mpm::HDF5Field::AllFields)
+      throw std::runtime_error("HDF5 particle file does not hold all fields");
+    if (columns.dim != Tdim)
+      throw std::runtime_error("HDF5 particle dimension does not match");
+
+    // Check ids are unique and none of them is in the mesh
+    std::vector<mpm::Index> ids(columns.ids.cbegin(), columns.ids.cend());
+    std::sort(ids.begin(), ids.end());
+    if (std::adjacent_find(ids.cbegin(), ids.cend()) != ids.cend())
+      throw std::runtime_error("HDF5 particle ids are not unique");
+    std::atomic<bool> duplicate{false};
+    tbb::parallel_for_each(
+        particles_.cbegin(), particles_.cend(),
+        [&](const std::shared_ptr<mpm::ParticleBase<Tdim>>& particle) {
+          if (std::binary_search(ids.cbegin(), ids.cend(), particle->id()))
+            duplicate = true;
+        });
+    if (duplicate)
+      throw std::runtime_error("Addition of particle to mesh failed!");
+
+    // Look up particle type once for all particles
+    const auto create_particle =
+        Factory<mpm::ParticleBase<Tdim>, mpm::Index,
+                const Eigen::Matrix<double, Tdim, 1>&>::instance()
+            ->creator(particle_type);
+
+    // Create and initialise particles in parallel
+    std::vector<std::shared_ptr<mpm::ParticleBase<Tdim>>> particles(
+        nparticles);
+    tbb::parallel_for(mpm::Index(0), nparticles, [&](mpm::Index i) {
+      const VectorDim coordinates =
+          Eigen::Map<const VectorDim>(&columns.coordinates[i * Tdim]);
+      particles[i] = create_particle(mpm::Index(columns.ids[i]), coordinates);
+      particles[i]->initialise_particle(columns.particle(i));
+    });
+
+    // Locate particles in cells and add located particles to mesh
+    const auto unlocatable = this->locate_particles_cells(particles);
+    if (!unlocatable.empty())
+      particles.erase(
+          std::remove_if(
+              particles.begin(), particles.end(),
+              [](const std::shared_ptr<mpm::ParticleBase<Tdim>>& particle) {
+                return particle->cell_id() ==
+                       std::numeric_limits<mpm::Index>::max();
+              }),
+          particles.end());
+    particles_.add(particles.cbegin(), particles.cend());
+
+    if (!unlocatable.empty())
+      throw std::runtime_error("Particle not found in mesh");
+  } catch (std::exception& exception) {
+    console_->error("{} #{}: {}\n", __FILE__, __LINE__, exception.what());
+    status = false;
+  }
+  return status;
+}
 
-    particle_data[i].stress_xx = stress[0];
-    particle_data[i].stress_yy = stress[1];
-    particle_data[i].stress_zz = stress[2];
-    particle_data[i].tau_xy = stress[3];
-    particle_data[i].tau_yz = stress[4];
-    particle_data[i].tau_xz = stress[5];
+//! Write the state of particles to a checkpoint file
+template <unsigned Tdim>
+bool mpm::Mesh<Tdim>::write_checkpoint(
+    unsigned phase, const std::string& filename,
+    const mpm::binary::Checkpoint& checkpoint) const {
+  bool status = true;
+  try {
+    const mpm::Index nparticles = this->nparticles();
+    const auto pbegin = particles_.cbegin();
+
+    // Gather the state of particles in parallel
+    std::vector<std::uint64_t> ids(nparticles), cells(nparticles);
+    std::vector<std::uint32_t> materials(nparticles);
+    std::vector<std::uint8_t> statuses(nparticles);
+    std::vector<double> coordinates(nparticles * Tdim), xi(nparticles * Tdim),
+        volumes(nparticles), masses(nparticles),
+        velocities(nparticles * Tdim), stresses(nparticles * 6),
+        strains(nparticles * 6), volumetric_strains(nparticles);
+    tbb::parallel_for(mpm::Index(0), nparticles, [&](mpm::Index i) {
+      const auto& particle = *(pbegin + i);
+      ids[i] = particle->id();
+      cells[i] = particle->cell_id();
+      materials[i] = particle->material_id();
+      statuses[i] = particle->status();
+      volumes[i] = particle->volume();
+      masses[i] = particle->mass(phase);
+      volumetric_strains[i] = particle->volumetric_strain_centroid(phase);
+
+      const VectorDim coords = particle->coordinates();
+      const VectorDim reference = particle->reference_location();
+      const Eigen::VectorXd velocity = particle->velocity(phase);
+      for (unsigned j = 0; j < Tdim; ++j) {
+        coordinates[i * Tdim + j] = coords(j);
+        xi[i * Tdim + j] = reference(j);
+        velocities[i * Tdim + j] = velocity(j);
+      }
 
-    particle_data[i].strain_xx = strain[0];
-    particle_data[i].strain_yy = strain[1];
-    particle_data[i].strain_zz = strain[2];
-    particle_data[i].gamma_xy = strain[3];
-    particle_data[i].gamma_yz = strain[4];
-    particle_data[i].gamma_xz = strain[5];
+      const Eigen::Matrix<double, 6, 1> stress = particle->stress(phase);
+      const Eigen::Matrix<double, 6, 1> strain = particle->strain(phase);
+      for (unsigned j = 0; j < 6; ++j) {
+        stresses[i * 6 + j] = stress(j);
+        strains[i * 6 + j] = strain(j);
+      }
+    });
+
+    using mpm::binary::Array;
+    using mpm::binary::Type;
+    const std::uint64_t step = checkpoint.step;
+    mpm::binary::write_atomic(
+        filename, Tdim,
+        {{Array::CheckpointStep, Type::UInt64, 1, 1, &step},
+         {Array::CheckpointTime, Type::Float64, 1, 1, &checkpoint.time},
+         {Array::CheckpointUuid, Type::UInt8, 1, checkpoint.uuid.size(),
+          checkpoint.uuid.data()},
+         {Array::ParticleIds, Type::UInt64, nparticles, 1, ids.data()},
+         {Array::ParticleCoordinates, Type::Float64, nparticles, Tdim,
+          coordinates.data()},
+         {Array::ParticleCells, Type::UInt64, nparticles, 1, cells.data()},
+         {Array::ParticleReferenceCoordinates, Type::Float64, nparticles, Tdim,
+          xi.data()},
+         {Array::ParticleVolumes, Type::Float64, nparticles, 1,
+          volumes.data()},
+         {Array::ParticleMaterials, Type::UInt32, nparticles, 1,
+          materials.data()},
+         {Array::ParticleMasses, Type::Float64, nparticles, 1, masses.data()},
+         {Array::ParticleVelocities, Type::Float64, nparticles, Tdim,
+          velocities.data()},
+         {Array::ParticleStresses, Type::Float64, nparticles, 6,
+          stresses.data()},
+         {Array::ParticleStrains, Type::Float64, nparticles, 6,
+          strains.data()},
+         {Array::ParticleVolumetricStrains, Type::Float64, nparticles, 1,
+          volumetric_strains.data()},
+         {Array::ParticleStatuses, Type::UInt8, nparticles, 1,
+          statuses.data()}});
+  } catch (std::exception& exception) {
+    console_->error("{} #{}: {}\n", __FILE__, __LINE__, exception.what());
+    status = false;
+  }
+  return status;
+}
 
-    particle_data[i].epsilon_v = (*pitr)->volumetric_strain_centroid(phase);
+//! Create particles from a checkpoint file
+template <unsigned Tdim>
+bool mpm::Mesh<Tdim>::read_checkpoint(
+    unsigned phase, const std::string& filename,
+    const std::string& particle_type,
+    const std::map<unsigned, std::shared_ptr<mpm::Material<Tdim>>>& materials,
+    mpm::binary::Checkpoint* checkpoint) {
+  bool status = true;
+  try {
+    if (particles_.size() != 0)
+      throw std::runtime_error(
+          "Checkpoint particles cannot be added to a mesh with particles");
+
+    using mpm::binary::Array;
+    using mpm::binary::Type;
+    const mpm::MappedFile file(filename);
+
+    // Values of an array with the expected type and number of columns
+    const auto values = [&file, &filename](Array array, Type type,
+                                           std::uint64_t cols) {
+      const auto info = mpm::binary::find(file, Tdim, array, type);
+      if (info == nullptr || info->cols != cols)
+        throw std::runtime_error("Checkpoint array is not present in " +
+                                 filename);
+      return std::make_pair(file.data() + info->offset, info->rows);
+    };
+
+    // Step, time and analysis id
+    const auto uuid = mpm::binary::find(file, Tdim, Array::CheckpointUuid,
+                                        Type::UInt8);
+    if (uuid == nullptr)
+      throw std::runtime_error("Checkpoint analysis id is not present in " +
+                               filename);
+    checkpoint->uuid.assign(file.data() + uuid->offset, uuid->cols);
+    checkpoint->step = *reinterpret_cast<const std::uint64_t*>(
+        values(Array::CheckpointStep, Type::UInt64, 1).first);
+    checkpoint->time = *reinterpret_cast<const double*>(
+        values(Array::CheckpointTime, Type::Float64, 1).first);
+
+    // Particle arrays, all with a row per particle
+    const auto id_values = values(Array::ParticleIds, Type::UInt64, 1);
+    const mpm::Index nparticles = id_values.second;
+    const auto array = [&](Array array, Type type, std::uint64_t cols) {
+      const auto data = values(array, type, cols);
+      if (data.second != nparticles)
+        throw std::runtime_error("Checkpoint arrays have different sizes");
+      return data.first;
+    };
+    const auto ids = reinterpret_cast<const std::uint64_t*>(id_values.first);
+    const auto coordinates = reinterpret_cast<const double*>(
+        array(Array::ParticleCoordinates, Type::Float64, Tdim));
+    const auto cells = reinterpret_cast<const std::uint64_t*>(
+        array(Array::ParticleCells, Type::UInt64, 1));
+    const auto xi = reinterpret_cast<const double*>(
+        array(Array::ParticleReferenceCoordinates, Type::Float64, Tdim));
+    const auto volumes = reinterpret_cast<const double*>(
+        array(Array::ParticleVolumes, Type::Float64, 1));
+    const auto material_ids = reinterpret_cast<const std::uint32_t*>(
+        array(Array::ParticleMaterials, Type::UInt32, 1));
+    const auto masses = reinterpret_cast<const double*>(
+        array(Array::ParticleMasses, Type::Float64, 1));
+    const auto velocities = reinterpret_cast<const double*>(
+        array(Array::ParticleVelocities, Type::Float64, Tdim));
+    const auto stresses = reinterpret_cast<const double*>(
+        array(Array::ParticleStresses, Type::Float64, 6));
+    const auto strains = reinterpret_cast<const double*>(
+        array(Array::ParticleStrains, Type::Float64, 6));
+    const auto volumetric_strains = reinterpret_cast<const double*>(
+        array(Array::ParticleVolumetricStrains, Type::Float64, 1));
+    const auto statuses = reinterpret_cast<const std::uint8_t*>(
+        array(Array::ParticleStatuses, Type::UInt8, 1));
+
+    // Look up particle type once for all particles
+    const auto create_particle =
+        Factory<mpm::ParticleBase<Tdim>, mpm::Index,
+                const Eigen::Matrix<double, Tdim, 1>&>::instance()
+            ->creator(particle_type);
+
+    // Create particles and restore their state in parallel
+    std::vector<std::shared_ptr<mpm::ParticleBase<Tdim>>> particles(
+        nparticles);
+    std::atomic<bool> valid{true};
+    const auto cbegin = cells_.cbegin();
+    tbb::parallel_for(mpm::Index(0), nparticles, [&](mpm::Index i) {
+      const VectorDim coords =
+          Eigen::Map<const VectorDim>(coordinates + i * Tdim);
+      auto particle = create_particle(ids[i], coords);
+
+      HDF5Particle state;
+      state.id = ids[i];
+      state.mass = masses[i];
+      double* position[] = {&state.coord_x, &state.coord_y, &state.coord_z};
+      double* velocity[] = {&state.velocity_x, &state.velocity_y,
+                            &state.velocity_z};
+      for (unsigned j = 0; j < 3; ++j) {
+        *position[j] = (j < Tdim) ? coordinates[i * Tdim + j] : 0.;
+        *velocity[j] = (j < Tdim) ? velocities[i * Tdim + j] : 0.;
+      }
+      const double* stress = stresses + i * 6;
+      const double* strain = strains + i * 6;
+      state.stress_xx = stress[0];
+      state.stress_yy = stress[1];
+      state.stress_zz = stress[2];
+      state.tau_xy = stress[3];
+      state.tau_yz = stress[4];
+      state.tau_xz = stress[5];
+      state.strain_xx = strain[0];
+      state.strain_yy = strain[1];
+      state.strain_zz = strain[2];
+      state.gamma_xy = strain[3];
+      state.gamma_yz = strain[4];
+      state.gamma_xz = strain[5];
+      state.epsilon_v = volumetric_strains[i];
+      state.status = statuses[i];
+      if (!particle->initialise_particle(state)) valid = false;
+      particle->assign_volume(volumes[i]);
+
+      // Material, particles without a material are stored with max unsigned
+      if (material_ids[i] != std::numeric_limits<std::uint32_t>::max()) {
+        const auto material = materials.find(material_ids[i]);
+        if (material == materials.end() ||
+            !particle->assign_material(material->second))
+          valid = false;
+      }
 
-    particle_data[i].status = (*pitr)->status();
+      // Stored cell and reference location
+      const auto cell = cell_index_.find(cells[i]);
+      if (cell == cell_index_.end() ||
+          !particle->assign_cell_xi(*(cbegin + cell->second),
+                                    Eigen::Map<const VectorDim>(xi + i * Tdim)))
+        valid = false;
 
-    // Counter
-    ++i;
-  }
-  // Calculate the size and the offsets of our struct members in memory
-  const hsize_t NRECORDS = nparticles;
-
-  const hsize_t NFIELDS = 22;
-
-  size_t dst_size = sizeof(HDF5Particle);
-  size_t dst_offset[NFIELDS] = {
-      HOFFSET(HDF5Particle, id),         HOFFSET(HDF5Particle, mass),
-      HOFFSET(HDF5Particle, coord_x),    HOFFSET(HDF5Particle, coord_y),
-      HOFFSET(HDF5Particle, coord_z),    HOFFSET(HDF5Particle, velocity_x),
-      HOFFSET(HDF5Particle, velocity_y), HOFFSET(HDF5Particle, velocity_z),
-      HOFFSET(HDF5Particle, stress_xx),  HOFFSET(HDF5Particle, stress_yy),
-      HOFFSET(HDF5Particle, stress_zz),  HOFFSET(HDF5Particle, tau_xy),
-      HOFFSET(HDF5Particle, tau_yz),     HOFFSET(HDF5Particle, tau_xz),
-      HOFFSET(HDF5Particle, strain_xx),  HOFFSET(HDF5Particle, strain_yy),
-      HOFFSET(HDF5Particle, strain_zz),  HOFFSET(HDF5Particle, gamma_xy),
-      HOFFSET(HDF5Particle, gamma_yz),   HOFFSET(HDF5Particle, gamma_xz),
-      HOFFSET(HDF5Particle, epsilon_v),  HOFFSET(HDF5Particle, status),
-  };
+      particles[i] = particle;
+    });
+    if (!valid)
+      throw std::runtime_error(
+          "Checkpoint particles do not match the cells or materials");
 
-  size_t dst_sizes[NFIELDS] = {
-      sizeof(particle_data[0].id),         sizeof(particle_data[0].mass),
-      sizeof(particle_data[0].coord_x),    sizeof(particle_data[0].coord_y),
-      sizeof(particle_data[0].coord_z),    sizeof(particle_data[0].velocity_x),
-      sizeof(particle_data[0].velocity_y), sizeof(particle_data[0].velocity_z),
-      sizeof(particle_data[0].stress_xx),  sizeof(particle_data[0].stress_yy),
-      sizeof(particle_data[0].stress_zz),  sizeof(particle_data[0].tau_xy),
-      sizeof(particle_data[0].tau_yz),     sizeof(particle_data[0].tau_xz),
-      sizeof(particle_data[0].strain_xx),  sizeof(particle_data[0].strain_yy),
-      sizeof(particle_data[0].strain_zz),  sizeof(particle_data[0].gamma_xy),
-      sizeof(particle_data[0].gamma_yz),   sizeof(particle_data[0].gamma_xz),
-      sizeof(particle_data[0].epsilon_v),  sizeof(particle_data[0].status),
-  };
+    particles_.add(particles.cbegin(), particles.cend());
 
-  // Define particle field information
-  const char* field_names[NFIELDS] = {
-      "id",         "mass",       "coord_x",    "coord_y",   "coord_z",
-      "velocity_x", "velocity_y", "velocity_z", "stress_xx", "stress_yy",
-      "stress_zz",  "tau_xy",     "tau_yz",     "tau_xz",    "strain_xx",
-      "strain_yy",  "strain_zz",  "gamma_xy",   "gamma_yz",  "gamma_xz",
-      "epsilon_v",  "status"};
-
-  hid_t field_type[NFIELDS];
-  hid_t string_type;
-  hid_t file_id;
-  hsize_t chunk_size = 10000;
-  int* fill_data = NULL;
-  int compress = 0;
-
-  // Initialize the field_type
-  field_type[0] = H5T_NATIVE_LLONG;
-  field_type[1] = H5T_NATIVE_DOUBLE;
-  field_type[2] = H5T_NATIVE_DOUBLE;
-  field_type[3] = H5T_NATIVE_DOUBLE;
-  field_type[4] = H5T_NATIVE_DOUBLE;
-  field_type[5] = H5T_NATIVE_DOUBLE;
-  field_type[6] = H5T_NATIVE_DOUBLE;
-  field_type[7] = H5T_NATIVE_DOUBLE;
-  field_type[8] = H5T_NATIVE_DOUBLE;
-  field_type[9] = H5T_NATIVE_DOUBLE;
-  field_type[10] = H5T_NATIVE_DOUBLE;
-  field_type[11] = H5T_NATIVE_DOUBLE;
-  field_type[12] = H5T_NATIVE_DOUBLE;
-  field_type[13] = H5T_NATIVE_DOUBLE;
-  field_type[14] = H5T_NATIVE_DOUBLE;
-  field_type[15] = H5T_NATIVE_DOUBLE;
-  field_type[16] = H5T_NATIVE_DOUBLE;
-  field_type[17] = H5T_NATIVE_DOUBLE;
-  field_type[18] = H5T_NATIVE_DOUBLE;
-  field_type[19] = H5T_NATIVE_DOUBLE;
-  field_type[20] = H5T_NATIVE_DOUBLE;
-  field_type[21] = H5T_NATIVE_HBOOL;
-
-  // Create a new file using default properties.
-  file_id =
-      H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
-
-  // make a table
-  H5TBmake_table("Table Title", file_id, "table", NFIELDS, NRECORDS, dst_size,
-                 field_names, dst_offset, field_type, chunk_size, fill_data,
-                 compress, particle_data.data());
-
-  H5Fclose(file_id);
-  return true;
+    // Update particle ids of cells and list of cells with particles
+    this->build_cell_particles();
+    this->find_active_cells();
+  } catch (std::exception& exception) {
+    console_->error("{} #{}: {}\n", __FILE__, __LINE__, exception.what());
+    status = false;
+  }
+  return status;
 }
 
-//! Write particles to HDF5
+//! Write the preprocessed mesh to a cache file
 template <unsigned Tdim>
-bool mpm::Mesh<Tdim>::read_particles_hdf5(unsigned phase,
-                                          const std::string& filename) {
-
-  // Create a new file using default properties.
-  hid_t file_id = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
-  // Throw an error if file can't be found
-  if (file_id < 0) throw std::runtime_error("HDF5 particle file is not found");
-
-  // Calculate the size and the offsets of our struct members in memory
-  const unsigned nparticles = this->nparticles();
-  const hsize_t NRECORDS = nparticles;
-
-  const hsize_t NFIELDS = 22;
-
-  size_t dst_size = sizeof(HDF5Particle);
-  size_t dst_offset[NFIELDS] = {
-      HOFFSET(HDF5Particle, id),         HOFFSET(HDF5Particle, mass),
-      HOFFSET(HDF5Particle, coord_x),    HOFFSET(HDF5Particle, coord_y),
-      HOFFSET(HDF5Particle, coord_z),    HOFFSET(HDF5Particle, velocity_x),
-      HOFFSET(HDF5Particle, velocity_y), HOFFSET(HDF5Particle, velocity_z),
-      HOFFSET(HDF5Particle, stress_xx),  HOFFSET(HDF5Particle, stress_yy),
-      HOFFSET(HDF5Particle, stress_zz),  HOFFSET(HDF5Particle, tau_xy),
-      HOFFSET(HDF5Particle, tau_yz),     HOFFSET(HDF5Particle, tau_xz),
-      HOFFSET(HDF5Particle, strain_xx),  HOFFSET(HDF5Particle, strain_yy),
-      HOFFSET(HDF5Particle, strain_zz),  HOFFSET(HDF5Particle, gamma_xy),
-      HOFFSET(HDF5Particle, gamma_yz),   HOFFSET(HDF5Particle, gamma_xz),
-      HOFFSET(HDF5Particle, epsilon_v),  HOFFSET(HDF5Particle, status),
-  };
+bool mpm::Mesh<Tdim>::write_cache(
+    const std::string& filename, std::uint64_t key,
+    const std::vector<VectorDim>& coordinates,
+    const std::vector<std::vector<mpm::Index>>& cells,
+    const std::vector<std::tuple<mpm::Index, unsigned, double>>& constraints)
+    const {
+  bool status = true;
+  try {
+    // Nodal coordinates and cell connectivity
+    const std::uint64_t nnodes = cells.empty() ? 0 : cells.front().size();
+    std::vector<double> node_coordinates(coordinates.size() * Tdim);
+    std::vector<std::uint64_t> cell_nodes(cells.size() * nnodes);
+    tbb::parallel_for(std::size_t(0), coordinates.size(), [&](std::size_t i) {
+      for (unsigned j = 0; j < Tdim; ++j)
+        node_coordinates[i * Tdim + j] = coordinates[i](j);
+    });
+    std::atomic<bool> uniform{true};
+    tbb::parallel_for(std::size_t(0), cells.size(), [&](std::size_t i) {
+      if (cells[i].size() != nnodes)
+        uniform = false;
+      else
+        std::copy(cells[i].cbegin(), cells[i].cend(),
+                  cell_nodes.begin() + i * nnodes);
+    });
+    if (!uniform)
+      throw std::runtime_error(
+          "Cells with different number of nodes cannot be cached");
+
+    // Velocity constraints
+    std::vector<std::uint64_t> constraint_nodes(constraints.size());
+    std::vector<std::uint32_t> directions(constraints.size());
+    std::vector<double> velocities(constraints.size());
+    for (std::size_t i = 0; i < constraints.size(); ++i) {
+      constraint_nodes[i] = std::get<0>(constraints[i]);
+      directions[i] = std::get<1>(constraints[i]);
+      velocities[i] = std::get<2>(constraints[i]);
+    }
 
-  // To get size
-  HDF5Particle particle;
-
-  size_t dst_sizes[NFIELDS] = {
-      sizeof(particle.id),         sizeof(particle.mass),
-      sizeof(particle.coord_x),    sizeof(particle.coord_y),
-      sizeof(particle.coord_z),    sizeof(particle.velocity_x),
-      sizeof(particle.velocity_y), sizeof(particle.velocity_z),
-      sizeof(particle.stress_xx),  sizeof(particle.stress_yy),
-      sizeof(particle.stress_zz),  sizeof(particle.tau_xy),
-      sizeof(particle.tau_yz),     sizeof(particle.tau_xz),
-      sizeof(particle.strain_xx),  sizeof(particle.strain_yy),
-      sizeof(particle.strain_zz),  sizeof(particle.gamma_xy),
-      sizeof(particle.gamma_yz),   sizeof(particle.gamma_xz),
-      sizeof(particle.epsilon_v),  sizeof(particle.status),
-  };
+    // Located particles
+    const mpm::Index nparticles = this->nparticles();
+    const auto pbegin = particles_.cbegin();
+    std::vector<std::uint64_t> ids(nparticles), particle_cells(nparticles);
+    std::vector<double> particle_coordinates(nparticles * Tdim),
+        xi(nparticles * Tdim), volumes(nparticles);
+    tbb::parallel_for(mpm::Index(0), nparticles, [&](mpm::Index i) {
+      const auto& particle = *(pbegin + i);
+      ids[i] = particle->id();
+      particle_cells[i] = particle->cell_id();
+      volumes[i] = particle->volume();
+      const VectorDim coords = particle->coordinates();
+      const VectorDim reference = particle->reference_location();
+      for (unsigned j = 0; j < Tdim; ++j) {
+        particle_coordinates[i * Tdim + j] = coords(j);
+        xi[i * Tdim + j] = reference(j);
+      }
+    });
+
+    using mpm::binary::Array;
+    using mpm::binary::Type;
+    mpm::binary::write_atomic(
+        filename, Tdim,
+        {{Array::CacheKey, Type::UInt64, 1, 1, &key},
+         {Array::NodeCoordinates, Type::Float64, coordinates.size(), Tdim,
+          node_coordinates.data()},
+         {Array::CellNodes, Type::UInt64, cells.size(), nnodes,
+          cell_nodes.data()},
+         {Array::ConstraintNodes, Type::UInt64, constraints.size(), 1,
+          constraint_nodes.data()},
+         {Array::ConstraintDirections, Type::UInt32, constraints.size(), 1,
+          directions.data()},
+         {Array::ConstraintVelocities, Type::Float64, constraints.size(), 1,
+          velocities.data()},
+         {Array::ParticleIds, Type::UInt64, nparticles, 1, ids.data()},
+         {Array::ParticleCoordinates, Type::Float64, nparticles, Tdim,
+          particle_coordinates.data()},
+         {Array::ParticleCells, Type::UInt64, nparticles, 1,
+          particle_cells.data()},
+         {Array::ParticleReferenceCoordinates, Type::Float64, nparticles, Tdim,
+          xi.data()},
+         {Array::ParticleVolumes, Type::Float64, nparticles, 1,
+          volumes.data()}});
+  } catch (std::exception& exception) {
+    console_->error("{} #{}: {}\n", __FILE__, __LINE__, exception.what());
+    status = false;
+  }
+  return status;
+}
 
-  std::vector<HDF5Particle> dst_buf;
-  dst_buf.reserve(nparticles);
-  // Read the table
-  H5TBread_table(file_id, "table", dst_size, dst_offset, dst_sizes,
-                 dst_buf.data());
-
-  unsigned i = 0;
-  for (auto pitr = particles_.cbegin(); pitr != particles_.cend(); ++pitr) {
-    particle = dst_buf[i];
-    // Initialise particle with HDF5 data
-    (*pitr)->initialise_particle(particle);
-    ++i;
+//! Create particles in their cells from a cache file
+template <unsigned Tdim>
+bool mpm::Mesh<Tdim>::read_cache_particles(const std::string& filename,
+                                           const std::string& particle_type) {
+  bool status = true;
+  try {
+    if (particles_.size() != 0)
+      throw std::runtime_error(
+          "Cached particles cannot be added to a mesh with particles");
+
+    using mpm::binary::Array;
+    using mpm::binary::Type;
+    const mpm::MappedFile file(filename);
+
+    // Particle arrays, all with a row per particle
+    const auto ids_info =
+        mpm::binary::find(file, Tdim, Array::ParticleIds, Type::UInt64);
+    if (ids_info == nullptr)
+      throw std::runtime_error("Cached particles are not present in " +
+                               filename);
+    const mpm::Index nparticles = ids_info->rows;
+    const auto array = [&](Array array, Type type, std::uint64_t cols) {
+      const auto info = mpm::binary::find(file, Tdim, array, type);
+      if (info == nullptr || info->rows != nparticles || info->cols != cols)
+        throw std::runtime_error("Cached particle arrays are invalid in " +
+                                 filename);
+      return file.data() + info->offset;
+    };
+    const auto ids =
+        reinterpret_cast<const std::uint64_t*>(file.data() + ids_info->offset);
+    const auto coordinates = reinterpret_cast<const double*>(
+        array(Array::ParticleCoordinates, Type::Float64, Tdim));
+    const auto cells = reinterpret_cast<const std::uint64_t*>(
+        array(Array::ParticleCells, Type::UInt64, 1));
+    const auto xi = reinterpret_cast<const double*>(
+        array(Array::ParticleReferenceCoordinates, Type::Float64, Tdim));
+    const auto volumes = reinterpret_cast<const double*>(
+        array(Array::ParticleVolumes, Type::Float64, 1));
+
+    // Look up particle type once for all particles
+    const auto create_particle =
+        Factory<mpm::ParticleBase<Tdim>, mpm::Index,
+                const Eigen::Matrix<double, Tdim, 1>&>::instance()
+            ->creator(particle_type);
+
+    // Create particles in their cells in parallel
+    std::vector<std::shared_ptr<mpm::ParticleBase<Tdim>>> particles(
+        nparticles);
+    std::atomic<bool> valid{true};
+    const auto cbegin = cells_.cbegin();
+    tbb::parallel_for(mpm::Index(0), nparticles, [&](mpm::Index i) {
+      const VectorDim coords =
+          Eigen::Map<const VectorDim>(coordinates + i * Tdim);
+      auto particle = create_particle(mpm::Index(ids[i]), coords);
+      particle->assign_volume(volumes[i]);
+
+      const auto cell = cell_index_.find(cells[i]);
+      if (cell == cell_index_.end() ||
+          !particle->assign_cell_xi(*(cbegin + cell->second),
+                                    Eigen::Map<const VectorDim>(xi + i * Tdim)))
+        valid = false;
+
+      particles[i] = particle;
+    });
+    if (!valid)
+      throw std::runtime_error("Cached particles do not match the cells");
+
+    particles_.add(particles.cbegin(), particles.cend());
+
+    // Update particle ids of cells and list of cells with particles
+    this->build_cell_particles();
+    this->find_active_cells();
+  } catch (std::exception& exception) {
+    console_->error("{} #{}: {}\n", __FILE__, __LINE__, exception.what());
+    status = false;
   }
-  // close the file
-  H5Fclose(file_id);
-  return true;
+  return status;
 }
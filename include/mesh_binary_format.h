@@ -0,0 +1,199 @@
+#ifndef MPM_MESH_BINARY_FORMAT_H_
+#define MPM_MESH_BINARY_FORMAT_H_
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "Eigen/Dense"
+
+#include "mapped_file.h"
+
+//! MPM namespace
+namespace mpm {
+
+//! Global index type for the cell
+using Index = unsigned long long;
+
+//! Binary mesh and particle input format, also used for checkpoints and
+//! caches of preprocessed meshes
+//! A file starts with a Header, followed by an ArrayInfo for each array.
+//! Arrays are stored contiguously in row-major order at 64 byte aligned
+//! offsets, so they can be used directly from a memory-mapped file.
+namespace binary {
+
+//! Format version
+const std::uint32_t version = 1;
+
+//! Byte order marker, a file written on a machine with a different byte
+//! order reads this value reversed
+const std::uint32_t byte_order = 0x01020304;
+
+//! Alignment of arrays in bytes
+const std::uint64_t alignment = 64;
+
+//! Arrays in a binary file
+enum class Array : std::uint32_t {
+  NodeCoordinates = 0,
+  CellNodes = 1,
+  ParticleCoordinates = 2,
+  ConstraintNodes = 3,
+  ConstraintDirections = 4,
+  ConstraintVelocities = 5,
+  CheckpointStep = 6,
+  CheckpointTime = 7,
+  CheckpointUuid = 8,
+  ParticleIds = 9,
+  ParticleCells = 10,
+  ParticleReferenceCoordinates = 11,
+  ParticleVolumes = 12,
+  ParticleMaterials = 13,
+  ParticleMasses = 14,
+  ParticleVelocities = 15,
+  ParticleStresses = 16,
+  ParticleStrains = 17,
+  ParticleVolumetricStrains = 18,
+  ParticleStatuses = 19,
+  CacheKey = 20
+};
+
+//! Type of array values
+enum class Type : std::uint32_t {
+  UInt32 = 0,
+  UInt64 = 1,
+  Float64 = 2,
+  UInt8 = 3
+};
+
+//! File header
+struct Header {
+  //! Magic string "MPMBIN"
+  char magic[8];
+  //! Format version
+  std::uint32_t version;
+  //! Byte order marker
+  std::uint32_t byte_order;
+  //! Dimension
+  std::uint32_t dim;
+  //! Number of arrays
+  std::uint32_t narrays;
+};
+
+//! Description of an array
+struct ArrayInfo {
+  //! Array
+  Array array;
+  //! Type of values
+  Type type;
+  //! Number of rows
+  std::uint64_t rows;
+  //! Number of columns
+  std::uint64_t cols;
+  //! Offset of the first value from the beginning of the file
+  std::uint64_t offset;
+};
+
+//! Array to be written, values are read from data
+struct ArrayData {
+  //! Array
+  Array array;
+  //! Type of values
+  Type type;
+  //! Number of rows
+  std::uint64_t rows;
+  //! Number of columns
+  std::uint64_t cols;
+  //! Pointer to rows * cols values
+  const void* data;
+};
+
+//! Step, time and analysis of a checkpoint
+struct Checkpoint {
+  //! Step
+  mpm::Index step{0};
+  //! Analysis time
+  double time{0.};
+  //! Unique id of the analysis
+  std::string uuid;
+};
+
+//! Return size of a value in bytes
+//! \param[in] type Type of value
+std::uint64_t type_size(Type type);
+
+//! Write arrays to a binary file, throws on failure
+//! \param[in] filename Name of the binary file
+//! \param[in] dim Dimension
+//! \param[in] arrays Arrays to write
+void write(const std::string& filename, unsigned dim,
+           const std::vector<ArrayData>& arrays);
+
+//! Write arrays to a unique temporary file next to a binary file and rename
+//! it over the file, so readers and concurrent writers never see a partial
+//! file. Throws on failure after removing the temporary file
+//! \param[in] filename Name of the binary file
+//! \param[in] dim Dimension
+//! \param[in] arrays Arrays to write
+void write_atomic(const std::string& filename, unsigned dim,
+                  const std::vector<ArrayData>& arrays);
+
+//! Find an array in a mapped binary file, throws if the file is invalid or
+//! the array has a different type
+//! \param[in] file Mapped binary file
+//! \param[in] dim Expected dimension
+//! \param[in] array Array to find
+//! \param[in] type Expected type of values
+//! \retval info Description of the array, nullptr if it is not present
+const ArrayInfo* find(const mpm::MappedFile& file, unsigned dim, Array array,
+                      Type type);
+
+//! Return the key of a preprocessed mesh cache
+//! \details Hash of the contents of the input files, the settings used to
+//! preprocess them, the format version and the source revision
+//! \param[in] filenames Input files, missing files are hashed by their name
+//! \param[in] settings Settings used to preprocess the inputs
+//! \retval key Key of the cache
+std::uint64_t cache_key(const std::vector<std::string>& filenames,
+                        const std::string& settings);
+
+//! Check if a file is a cache of a preprocessed mesh with a key
+//! \param[in] filename Name of the cache file
+//! \param[in] dim Dimension
+//! \param[in] key Key of the inputs
+//! \retval status False if the file is missing, invalid or has another key
+bool valid_cache(const std::string& filename, unsigned dim,
+                 std::uint64_t key);
+
+//! Write mesh nodes and cells to a binary file
+//! \param[in] filename Name of the binary file
+//! \param[in] coordinates Nodal coordinates
+//! \param[in] cells Node ids of cells, all cells have the same number of nodes
+template <unsigned Tdim>
+void write_mesh(const std::string& filename,
+                const std::vector<Eigen::Matrix<double, Tdim, 1>>& coordinates,
+                const std::vector<std::vector<mpm::Index>>& cells);
+
+//! Write particle coordinates to a binary file
+//! \param[in] filename Name of the binary file
+//! \param[in] coordinates Particle coordinates
+template <unsigned Tdim>
+void write_particles(
+    const std::string& filename,
+    const std::vector<Eigen::Matrix<double, Tdim, 1>>& coordinates);
+
+//! Write velocity constraints to a binary file
+//! \param[in] filename Name of the binary file
+//! \param[in] constraints Constraint at node, dir, and velocity
+template <unsigned Tdim>
+void write_velocity_constraints(
+    const std::string& filename,
+    const std::vector<std::tuple<mpm::Index, unsigned, double>>& constraints);
+
+}  // namespace binary
+}  // namespace mpm
+
+#include "mesh_binary_format.tcc"
+
+#endif  // MPM_MESH_BINARY_FORMAT_H_
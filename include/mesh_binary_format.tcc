@@ -0,0 +1,72 @@
+//! Write mesh nodes and cells to a binary file
+template <unsigned Tdim>
+void mpm::binary::write_mesh(
+    const std::string& filename,
+    const std::vector<Eigen::Matrix<double, Tdim, 1>>& coordinates,
+    const std::vector<std::vector<mpm::Index>>& cells) {
+  // Nodal coordinates
+  std::vector<double> node_coordinates;
+  node_coordinates.reserve(coordinates.size() * Tdim);
+  for (const auto& coordinate : coordinates)
+    for (unsigned i = 0; i < Tdim; ++i)
+      node_coordinates.emplace_back(coordinate[i]);
+
+  // Cell connectivity
+  const std::uint64_t nnodes = cells.empty() ? 0 : cells.front().size();
+  std::vector<std::uint64_t> cell_nodes;
+  cell_nodes.reserve(cells.size() * nnodes);
+  for (const auto& cell : cells) {
+    if (cell.size() != nnodes)
+      throw std::runtime_error(
+          "Cells with different number of nodes cannot be written");
+    cell_nodes.insert(cell_nodes.end(), cell.begin(), cell.end());
+  }
+
+  write(filename, Tdim,
+        {{Array::NodeCoordinates, Type::Float64, coordinates.size(), Tdim,
+          node_coordinates.data()},
+         {Array::CellNodes, Type::UInt64, cells.size(), nnodes,
+          cell_nodes.data()}});
+}
+
+//! Write particle coordinates to a binary file
+template <unsigned Tdim>
+void mpm::binary::write_particles(
+    const std::string& filename,
+    const std::vector<Eigen::Matrix<double, Tdim, 1>>& coordinates) {
+  std::vector<double> particle_coordinates;
+  particle_coordinates.reserve(coordinates.size() * Tdim);
+  for (const auto& coordinate : coordinates)
+    for (unsigned i = 0; i < Tdim; ++i)
+      particle_coordinates.emplace_back(coordinate[i]);
+
+  write(filename, Tdim,
+        {{Array::ParticleCoordinates, Type::Float64, coordinates.size(), Tdim,
+          particle_coordinates.data()}});
+}
+
+//! Write velocity constraints to a binary file
+template <unsigned Tdim>
+void mpm::binary::write_velocity_constraints(
+    const std::string& filename,
+    const std::vector<std::tuple<mpm::Index, unsigned, double>>& constraints) {
+  std::vector<std::uint64_t> nodes;
+  std::vector<std::uint32_t> directions;
+  std::vector<double> velocities;
+  nodes.reserve(constraints.size());
+  directions.reserve(constraints.size());
+  velocities.reserve(constraints.size());
+  for (const auto& constraint : constraints) {
+    nodes.emplace_back(std::get<0>(constraint));
+    directions.emplace_back(std::get<1>(constraint));
+    velocities.emplace_back(std::get<2>(constraint));
+  }
+
+  write(filename, Tdim,
+        {{Array::ConstraintNodes, Type::UInt64, constraints.size(), 1,
+          nodes.data()},
+         {Array::ConstraintDirections, Type::UInt32, constraints.size(), 1,
+          directions.data()},
+         {Array::ConstraintVelocities, Type::Float64, constraints.size(), 1,
+          velocities.data()}});
+}
@@ -1,6 +1,7 @@
 #ifndef MPM_MPM_H_
 #define MPM_MPM_H_
 
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -53,6 +54,12 @@ class MPM {
   //! Write HDF5 files
   virtual void write_hdf5(mpm::Index step, mpm::Index max_steps) = 0;
 
+  //! Write checkpoint files
+  virtual void write_checkpoint(mpm::Index step, mpm::Index max_steps) = 0;
+
+  //! Return wall time of the time loop of the last solve in seconds
+  double time_loop_duration() const { return time_loop_duration_; }
+
  protected:
   //! A unique id for the analysis
   std::string uuid_;
@@ -64,6 +71,8 @@ class MPM {
   mpm::Index nsteps_{std::numeric_limits<mpm::Index>::max()};
   //! Output steps
   mpm::Index output_steps_{std::numeric_limits<mpm::Index>::max()};
+  //! Wall time of the time loop in seconds
+  double time_loop_duration_{0.};
   //! A unique ptr to IO object
   std::unique_ptr<mpm::IO> io_;
   //! JSON analysis object
@@ -1,14 +1,25 @@
 #ifndef MPM_MPM_EXPLICIT_H_
 #define MPM_MPM_EXPLICIT_H_
 
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+
 #include <boost/lexical_cast.hpp>
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
 
+#include "allocation_tracker.h"
+#include "async_writer.h"
 #include "container.h"
+#include "hdf5_time_series.h"
 #include "mpm.h"
 #include "particle.h"
+#include "profiler.h"
 
 namespace mpm {
 
@@ -40,7 +51,53 @@ class MPMExplicit : public MPM {
   //! Write HDF5 files
   void write_hdf5(mpm::Index step, mpm::Index max_steps) override;
 
+  //! Write checkpoint files
+  void write_checkpoint(mpm::Index step, mpm::Index max_steps) override;
+
  protected:
+  //! Restore particles of a resumed analysis from a checkpoint
+  //! \retval status Particles are restored, false if no checkpoint is used
+  bool read_checkpoint();
+
+  //! Write particle fields of an output step to HDF5
+  //! \param[in] columns Particle fields
+  //! \param[in] filename Name of the HDF5 file
+  //! \param[in] step Output step
+  //! \param[in] time Analysis time of the step
+  //! \retval status Status of writing HDF5 output
+  bool write_hdf5_buffer(const mpm::HDF5ParticleColumns& columns,
+                         const std::string& filename, mpm::Index step,
+                         double time);
+
+  //! Write particle fields of an output step to VTK
+  //! \param[in] columns Particle fields, coordinates have to be present
+  //! \param[in] filename Name of the VTK file
+  //! \retval status Status of writing VTK output
+  bool write_vtk_buffer(mpm::HDF5ParticleColumns* columns,
+                        const std::string& filename);
+
+  //! Return the fields selected for output at a step
+  //! \param[in] step Output step
+  unsigned output_fields(mpm::Index step) const;
+
+  //! Read fields, regions and decimation of output
+  //! \param[in] post_process JSON post-process object
+  void read_output_selection(const Json& post_process);
+
+  //! Return a staging buffer of particle fields for output
+  std::shared_ptr<mpm::HDF5ParticleColumns> output_buffer();
+
+  //! Wait for pending output to be written
+  void complete_output();
+
+  //! Write the summary and trace of profiled stages
+  void write_profile();
+
+  //! Check heap allocations of a step, steady state steps may not allocate
+  //! more than allowed. Output steps are excluded and complete their output.
+  //! \param[in] start Heap allocations at the start of the step
+  void check_step_allocations(const mpm::Allocations& start);
+
   // Generate a unique id for the analysis
   using mpm::MPM::uuid_;
   //! Time step size
@@ -51,6 +108,8 @@ class MPMExplicit : public MPM {
   using mpm::MPM::nsteps_;
   //! Output steps
   using mpm::MPM::output_steps_;
+  //! Wall time of the time loop
+  using mpm::MPM::time_loop_duration_;
   //! A unique ptr to IO object
   using mpm::MPM::io_;
   //! JSON analysis object
@@ -66,6 +125,40 @@ class MPMExplicit : public MPM {
   std::vector<std::unique_ptr<mpm::Mesh<Tdim>>> meshes_;
   //! Materials
   std::map<unsigned, std::shared_ptr<mpm::Material<Tdim>>> materials_;
+  //! Particles are generated at quadrature points with assigned volumes
+  bool generate_particles_{false};
+  //! Checkpoint interval in steps, 0 disables checkpoints
+  mpm::Index checkpoint_steps_{0};
+  //! Particles are restored from a checkpoint
+  bool checkpoint_restored_{false};
+  //! HDF5 output options
+  mpm::HDF5Options hdf5_options_;
+  //! Number of pieces of VTK output
+  unsigned vtk_pieces_{1};
+  //! Particles and fields selected for output
+  mpm::HDF5Selection output_selection_;
+  //! Fields selected for output
+  unsigned output_fields_{mpm::HDF5Field::AllFields};
+  //! Output interval in steps of fields not written at every output step
+  std::map<unsigned, mpm::Index> field_steps_;
+  //! Single HDF5 file of the analysis holding all output steps
+  std::unique_ptr<mpm::HDF5TimeSeries> hdf5_series_;
+  //! Staging buffers of particle fields for reuse
+  std::vector<std::unique_ptr<mpm::HDF5ParticleColumns>> output_buffers_;
+  //! Mutex of the staging buffers
+  std::mutex output_buffers_mutex_;
+  //! Profiler of stages, null unless profiling is compiled in and requested
+  std::unique_ptr<mpm::Profiler> profiler_;
+  //! Heap allocations of steady state steps are checked
+  bool check_step_allocations_{false};
+  //! Heap allocations allowed in a steady state step
+  unsigned long long max_step_allocations_{0};
+  //! Steps checked before steady state is assumed
+  mpm::Index allocation_warmup_steps_{2};
+  //! Number of steps checked for heap allocations
+  mpm::Index allocation_checked_steps_{0};
+  //! Background writer of output, destroyed first to complete pending writes
+  std::unique_ptr<mpm::AsyncWriter> output_writer_;
 
 };  // MPMExplicit class
 }  // namespace mpm
@@ -32,10 +32,100 @@ mpm::MPMExplicit<Tdim>::MPMExplicit(std::unique_ptr<IO>&& io)
       throw std::runtime_error("Specified gravity dimension is invalid");
     }
 
+    // Checkpoint interval
+    if (analysis_.find("checkpoint_steps") != analysis_.end())
+      checkpoint_steps_ =
+          analysis_.at("checkpoint_steps").template get<mpm::Index>();
+
     post_process_ = io_->post_processing();
     // Output steps
     output_steps_ = post_process_["output_steps"].template get<mpm::Index>();
 
+    // HDF5 layout, chunking and compression
+    if (post_process_.find("hdf5") != post_process_.end()) {
+      const auto hdf5 = post_process_.at("hdf5");
+      if (hdf5.find("layout") != hdf5.end())
+        hdf5_options_.columns =
+            (hdf5.at("layout").template get<std::string>() == "columns");
+      if (hdf5.find("chunk_size") != hdf5.end())
+        hdf5_options_.chunk_size =
+            hdf5.at("chunk_size").template get<mpm::Index>();
+      if (hdf5.find("compression") != hdf5.end())
+        hdf5_options_.compression =
+            hdf5.at("compression").template get<unsigned>();
+      if (hdf5.find("shuffle") != hdf5.end())
+        hdf5_options_.shuffle = hdf5.at("shuffle").template get<bool>();
+      // A single file always stores one dataset per field
+      if (hdf5.find("time_series") != hdf5.end())
+        hdf5_options_.time_series = hdf5.at("time_series").template get<bool>();
+      if (hdf5_options_.time_series) hdf5_options_.columns = true;
+      if (hdf5.find("flush_interval") != hdf5.end())
+        hdf5_options_.flush_interval =
+            hdf5.at("flush_interval").template get<unsigned>();
+      if (hdf5.find("partitions") != hdf5.end())
+        hdf5_options_.partitions =
+            hdf5.at("partitions").template get<unsigned>();
+      if (hdf5.find("writers") != hdf5.end())
+        hdf5_options_.writers = hdf5.at("writers").template get<unsigned>();
+    }
+
+    // VTK output split into pieces written concurrently
+    if (post_process_.find("vtk") != post_process_.end()) {
+      const auto vtk = post_process_.at("vtk");
+      if (vtk.find("pieces") != vtk.end())
+        vtk_pieces_ = std::max(vtk.at("pieces").template get<unsigned>(), 1u);
+    }
+
+    // Output fields, regions and decimation
+    this->read_output_selection(post_process_);
+
+    // Stage profiler, compiled in with MPM_PROFILING
+    bool counters = io_->perf_counters();
+    if (post_process_.find("profile") != post_process_.end() || counters) {
+      Json profile = counters;
+      if (post_process_.find("profile") != post_process_.end())
+        profile = post_process_.at("profile");
+#ifdef MPM_PROFILING
+      if (!profile.is_boolean() || profile.template get<bool>() || counters)
+        profiler_ = std::make_unique<mpm::Profiler>(
+            profile.is_object() && profile.value("trace", false));
+      // Hardware event counters, from the command line or the profile
+      if (profile.is_object()) counters |= profile.value("counters", false);
+      if (profiler_ && counters && !profiler_->enable_counters())
+        console_->warn("Hardware event counters are unavailable, profiling "
+                       "durations only");
+#else
+      console_->warn("Profiling is not compiled in, build with MPM_PROFILING");
+#endif
+    }
+
+    // Heap allocations allowed in steady state steps, to test that the time
+    // loop does not allocate
+    if (post_process_.find("allocations") != post_process_.end()) {
+      const auto allocations = post_process_.at("allocations");
+      if (mpm::allocation_tracking()) {
+        check_step_allocations_ = true;
+        if (allocations.find("max_per_step") != allocations.end())
+          max_step_allocations_ = allocations.at("max_per_step")
+                                      .template get<unsigned long long>();
+        if (allocations.find("warmup_steps") != allocations.end())
+          allocation_warmup_steps_ =
+              allocations.at("warmup_steps").template get<mpm::Index>();
+      } else
+        console_->warn("Allocation tracking is not compiled in, build with "
+                       "MPM_ALLOCATION_TRACKING");
+    }
+
+    // Write output on a background thread with a bounded queue
+    if (post_process_.find("async_output") != post_process_.end()) {
+      const auto async = post_process_.at("async_output");
+      unsigned queue_size = 1;
+      if (async.is_object() && async.find("queue_size") != async.end())
+        queue_size = async.at("queue_size").template get<unsigned>();
+      if (!async.is_boolean() || async.template get<bool>())
+        output_writer_ = std::make_unique<mpm::AsyncWriter>(queue_size);
+    }
+
   } catch (std::domain_error& domain_error) {
     console_->error(" {} {} Get analysis object: {}", __FILE__, __LINE__,
                     domain_error.what());
@@ -48,34 +138,81 @@ template <unsigned Tdim>
 bool mpm::MPMExplicit<Tdim>::initialise_mesh_particles() {
   bool status = true;
   try {
+    // Start of the current initialisation phase
+    auto phase_start = std::chrono::steady_clock::now();
+    // Report elapsed time of an initialisation phase
+    const auto report_phase = [this, &phase_start](const std::string& phase) {
+      const auto phase_end = std::chrono::steady_clock::now();
+      console_->info("{}: {} ms", phase,
+                     std::chrono::duration_cast<std::chrono::milliseconds>(
+                         phase_end - phase_start)
+                         .count());
+      MPM_PROFILE_RECORD(profiler_.get(), phase, phase_start, phase_end);
+      phase_start = phase_end;
+    };
+
     // Get mesh properties
     auto mesh_props = io_->json_object("mesh");
     // Get Mesh reader from JSON object
-    const std::string reader =
-        mesh_props["mesh_reader"].template get<std::string>();
+    std::string reader = mesh_props["mesh_reader"].template get<std::string>();
+
+    // Preprocessed mesh cached by a key of the inputs and mesh properties,
+    // the state of particles read from HDF5 is not cached
+    std::string mesh_file = io_->file_name("mesh");
+    std::string constraints_file = io_->file_name("velocity_constraints");
+    std::string cache_file;
+    std::uint64_t cache_key = 0;
+    bool cached = false;
+    if (mesh_props.find("cache") != mesh_props.end() &&
+        mesh_props.at("cache").template get<bool>() &&
+        boost::filesystem::path(io_->file_name("particles")).extension() !=
+            ".h5") {
+      cache_key = mpm::binary::cache_key(
+          {mesh_file, io_->file_name("particles"), constraints_file},
+          std::to_string(Tdim) + mesh_props.dump());
+      std::ostringstream name;
+      name << "mesh-" << std::hex << std::setw(16) << std::setfill('0')
+           << cache_key;
+      cache_file = io_->output_file(name.str(), ".bin", "cache").string();
+      cached = mpm::binary::valid_cache(cache_file, Tdim, cache_key);
+      // A cached mesh is read as a binary mesh
+      if (cached) {
+        reader = "Binary" + std::to_string(Tdim) + "D";
+        mesh_file = constraints_file = cache_file;
+      }
+      report_phase(cached ? "Find mesh cache" : "Hash mesh inputs");
+    }
+
     // Create a mesh reader
     auto mesh_reader = Factory<mpm::ReadMesh<Tdim>>::instance()->create(reader);
 
+    // Read nodal coordinates and cells of the mesh
+    const auto mesh = mesh_reader->read_mesh(mesh_file);
+    report_phase("Read mesh");
+
     // Global Index
     mpm::Index gid = 0;
     // Node type
     const auto node_type = mesh_props["node_type"].template get<std::string>();
     // Create nodes from file
-    bool node_status = meshes_.at(0)->create_nodes(
-        gid,                                                    // global id
-        node_type,                                              // node type
-        mesh_reader->read_mesh_nodes(io_->file_name("mesh")));  // coordinates
+    bool node_status =
+        meshes_.at(0)->create_nodes(gid,          // global id
+                                    node_type,    // node type
+                                    mesh.first);  // coordinates
 
     if (!node_status)
       throw std::runtime_error("Addition of nodes to mesh failed");
+    report_phase("Create nodes");
 
     // Read and assign velocity constraints
-    bool velocity_constraints = meshes_.at(0)->assign_velocity_constraints(
-        mesh_reader->read_velocity_constraints(
-            io_->file_name("velocity_constraints")));
+    const auto constraints =
+        mesh_reader->read_velocity_constraints(constraints_file);
+    bool velocity_constraints =
+        meshes_.at(0)->assign_velocity_constraints(constraints);
     if (!velocity_constraints)
       throw std::runtime_error(
           "Velocity constraints are not properly assigned");
+    report_phase("Assign velocity constraints");
 
     // Shape function name
     const auto cell_type = mesh_props["cell_type"].template get<std::string>();
@@ -84,32 +221,115 @@ bool mpm::MPMExplicit<Tdim>::initialise_mesh_particles() {
         Factory<mpm::Element<Tdim>>::instance()->create(cell_type);
 
     // Create cells from file
-    bool cell_status = meshes_.at(0)->create_cells(
-        gid,                                                    // global id
-        element,                                                // element tyep
-        mesh_reader->read_mesh_cells(io_->file_name("mesh")));  // Node ids
+    bool cell_status =
+        meshes_.at(0)->create_cells(gid,           // global id
+                                    element,       // element tyep
+                                    mesh.second);  // Node ids
 
     if (!cell_status)
       throw std::runtime_error("Addition of cells to mesh failed");
+    report_phase("Create cells");
+
+    // Particles of a resumed analysis are restored in their cells from the
+    // checkpoint, no particles are read or located
+    if (this->read_checkpoint()) {
+      generate_particles_ =
+          (mesh_props.find("generate_particles") != mesh_props.end());
+      report_phase("Read checkpoint");
+      return status;
+    }
 
     // Particle type
     const auto particle_type =
         mesh_props["particle_type"].template get<std::string>();
-    // Create particles from file
-    bool particle_status = meshes_.at(0)->create_particles(
-        gid,            // global id
-        particle_type,  // particle type
-        mesh_reader->read_particles(
-            io_->file_name("particles")));  // coordinates
 
-    if (!particle_status)
-      throw std::runtime_error("Addition of particles to mesh failed");
+    // Particles of a cached mesh are restored in their cells
+    if (cached) {
+      if (!meshes_.at(0)->read_cache_particles(cache_file, particle_type))
+        throw std::runtime_error("Reading cached particles failed");
+      generate_particles_ =
+          (mesh_props.find("generate_particles") != mesh_props.end());
+      report_phase("Read cached particles");
+      return status;
+    }
 
-    // Locate particles in cell
-    auto unlocatable_particles = meshes_.at(0)->locate_particles_mesh();
+    if (mesh_props.find("generate_particles") != mesh_props.end()) {
+      // Generate particles at quadrature points of cells
+      const auto generate = mesh_props["generate_particles"];
+      const auto npoints =
+          generate["points_per_direction"].template get<unsigned>();
+
+      // Cells to fill with particles, all cells if none are selected
+      std::vector<mpm::Index> cell_ids;
+      if (generate.find("cells") != generate.end())
+        cell_ids = generate["cells"].template get<std::vector<mpm::Index>>();
+      if (generate.find("regions") != generate.end()) {
+        for (const auto& region : generate["regions"]) {
+          Eigen::Matrix<double, Tdim, 1> min, max;
+          for (unsigned i = 0; i < Tdim; ++i) {
+            min(i) = region.at("min").at(i).template get<double>();
+            max(i) = region.at("max").at(i).template get<double>();
+          }
+          const auto region_cells = meshes_.at(0)->cell_ids_in_box(min, max);
+          if (region_cells.empty())
+            throw std::runtime_error("No cells in particle generation region");
+          cell_ids.insert(cell_ids.end(), region_cells.begin(),
+                          region_cells.end());
+        }
+      }
+      std::sort(cell_ids.begin(), cell_ids.end());
+      cell_ids.erase(std::unique(cell_ids.begin(), cell_ids.end()),
+                     cell_ids.end());
+
+      bool particle_status = meshes_.at(0)->generate_particles(
+          gid,            // global id
+          particle_type,  // particle type
+          npoints,        // quadrature points per direction
+          cell_ids);      // cells
+
+      if (!particle_status)
+        throw std::runtime_error("Generation of particles in mesh failed");
+      generate_particles_ = true;
+      report_phase("Generate particles");
+    } else if (boost::filesystem::path(io_->file_name("particles"))
+                   .extension() == ".h5") {
+      // Create particles with their state from an HDF5 particle file
+      bool particle_status = meshes_.at(0)->create_particles_hdf5(
+          particle_type, io_->file_name("particles"));
+
+      if (!particle_status)
+        throw std::runtime_error("Addition of particles to mesh failed");
+      report_phase("Create particles");
+    } else {
+      // Read particle coordinates from file
+      const auto particles =
+          mesh_reader->read_particles(io_->file_name("particles"));
+      report_phase("Read particles");
+
+      // Create particles and locate them in cells
+      bool particle_status =
+          meshes_.at(0)->create_particles(gid,            // global id
+                                          particle_type,  // particle type
+                                          particles);     // coordinates
+
+      if (!particle_status)
+        throw std::runtime_error("Addition of particles to mesh failed");
+      report_phase("Create particles");
+    }
 
-    if (!unlocatable_particles.empty())
-      throw std::runtime_error("Particle outside the mesh domain");
+    // Particles are located in cells when they are created, only particle
+    // ids of cells and the list of cells with particles are built
+    meshes_.at(0)->build_cell_particles();
+    meshes_.at(0)->find_active_cells();
+    report_phase("Build cell particles");
+
+    // Cache the preprocessed mesh for later runs of the same inputs
+    if (!cache_file.empty()) {
+      if (!meshes_.at(0)->write_cache(cache_file, cache_key, mesh.first,
+                                      mesh.second, constraints))
+        console_->warn("Writing mesh cache {} failed", cache_file);
+      report_phase("Write mesh cache");
+    }
 
   } catch (std::exception& exception) {
     console_->error("#{}: Reading mesh and particles: {}", __LINE__,
@@ -179,16 +399,35 @@ bool mpm::MPMExplicit<Tdim>::checkpoint_resume() {
     std::string attribute = "particles";
     std::string extension = ".h5";
 
-    auto particles_file =
-        io_->output_file(attribute, extension, uuid_, step_, this->nsteps_)
-            .string();
-    // Load particle information from file
-    meshes_.at(0)->read_particles_hdf5(phase, particles_file);
-    // Locate particles
-    auto unlocatable_particles = meshes_.at(0)->locate_particles_mesh();
+    if (hdf5_options_.time_series) {
+      // Read the step from the analysis file, later steps are appended to it
+      hdf5_series_ = std::make_unique<mpm::HDF5TimeSeries>(
+          io_->output_file(attribute, extension, uuid_).string(), true, false,
+          hdf5_options_.flush_interval);
+      if (!checkpoint_restored_) {
+        hid_t group = hdf5_series_->open_step(step_);
+        const bool read =
+            meshes_.at(0)->read_particles_hdf5_columns(phase, group);
+        H5Gclose(group);
+        if (!read) throw std::runtime_error("Reading HDF5 particles failed");
+      }
+    } else if (!checkpoint_restored_) {
+      auto particles_file =
+          io_->output_file(attribute, extension, uuid_, step_, this->nsteps_)
+              .string();
+      // Load particle information from file
+      if (!meshes_.at(0)->read_particles_hdf5(phase, particles_file))
+        throw std::runtime_error("Reading HDF5 particles failed");
+    }
 
-    if (!unlocatable_particles.empty())
-      throw std::runtime_error("Particle outside the mesh domain");
+    // Particles restored from a checkpoint are in their cells
+    if (!checkpoint_restored_) {
+      // Locate particles
+      auto unlocatable_particles = meshes_.at(0)->locate_particles_mesh();
+
+      if (!unlocatable_particles.empty())
+        throw std::runtime_error("Particle outside the mesh domain");
+    }
 
     // Increament step
     ++this->step_;
@@ -208,25 +447,100 @@ bool mpm::MPMExplicit<Tdim>::checkpoint_resume() {
 //! Write VTK files
 template <unsigned Tdim>
 void mpm::MPMExplicit<Tdim>::write_vtk(mpm::Index step, mpm::Index max_steps) {
-  const auto coordinates = meshes_.at(0)->particle_coordinates();
-  // VTK PolyData writer
-  auto vtk_writer = std::make_unique<VtkWriter>(coordinates);
+  // Write points and the selected fields to a single vtk file, or to pieces
+  // referenced by a parallel vtk file
+  std::string attribute = "particles";
+  std::string extension = (vtk_pieces_ > 1) ? ".pvtp" : ".vtp";
 
-  // Write input geometry to vtk file
-  std::string attribute = "geometry";
-  std::string extension = ".vtp";
+  const unsigned phase = 0;
 
-  auto meshfile =
+  const std::string particles_file =
       io_->output_file(attribute, extension, uuid_, step, max_steps).string();
-  vtk_writer->write_geometry(meshfile);
 
-  unsigned phase = 0;
-  // Write stress vector
-  attribute = "stresses";
-  auto stress_file =
+  // Points are always written
+  output_selection_.fields =
+      this->output_fields(step) | mpm::HDF5Field::Coordinates;
+
+  // Snapshot particle fields into a staging buffer
+  auto buffer = this->output_buffer();
+  meshes_.at(0)->gather_particles_hdf5(phase, buffer.get(),
+                                       output_selection_);
+
+  const auto write = [this, buffer, particles_file]() {
+    MPM_PROFILE(profiler_.get(), "write_vtk");
+    if (!this->write_vtk_buffer(buffer.get(), particles_file))
+      throw std::runtime_error("Writing VTK output failed");
+  };
+
+  // Hand the buffer to the writer thread while the next steps compute
+  if (output_writer_) {
+    output_writer_->submit(write);
+  } else {
+    MPM_PROFILE(profiler_.get(), "write_vtk");
+    this->write_vtk_buffer(buffer.get(), particles_file);
+  }
+}
+
+//! Write checkpoint files
+template <unsigned Tdim>
+void mpm::MPMExplicit<Tdim>::write_checkpoint(mpm::Index step,
+                                              mpm::Index max_steps) {
+  std::string attribute = "checkpoint";
+  std::string extension = ".bin";
+
+  const unsigned phase = 0;
+
+  const auto checkpoint_file =
       io_->output_file(attribute, extension, uuid_, step, max_steps).string();
-  vtk_writer->write_vector_point_data(
-      stress_file, meshes_.at(0)->particle_stresses(phase), attribute);
+
+  mpm::binary::Checkpoint checkpoint;
+  checkpoint.step = step;
+  checkpoint.time = step * dt_;
+  checkpoint.uuid = uuid_;
+  if (!meshes_.at(0)->write_checkpoint(phase, checkpoint_file, checkpoint))
+    console_->error("{} #{}: Writing checkpoint of step {} failed\n", __FILE__,
+                    __LINE__, step);
+}
+
+//! Restore particles of a resumed analysis from a checkpoint
+template <unsigned Tdim>
+bool mpm::MPMExplicit<Tdim>::read_checkpoint() {
+  // Checkpoints are read when a resume requests them
+  if (analysis_.find("resume") == analysis_.end()) return false;
+  const auto resume = analysis_.at("resume");
+  if (!resume.value("resume", false) || !resume.value("checkpoint", false))
+    return false;
+
+  bool status = true;
+  try {
+    const unsigned phase = 0;
+
+    const auto uuid = resume.at("uuid").template get<std::string>();
+    const auto step = resume.at("step").template get<mpm::Index>();
+
+    std::string attribute = "checkpoint";
+    std::string extension = ".bin";
+    const auto checkpoint_file =
+        io_->output_file(attribute, extension, uuid, step, nsteps_).string();
+
+    const auto particle_type = io_->json_object("mesh")["particle_type"]
+                                   .template get<std::string>();
+    mpm::binary::Checkpoint checkpoint;
+    if (!meshes_.at(0)->read_checkpoint(phase, checkpoint_file, particle_type,
+                                        materials_, &checkpoint))
+      throw std::runtime_error("Reading checkpoint failed");
+    if (checkpoint.uuid != uuid || checkpoint.step != step)
+      throw std::runtime_error("Checkpoint does not match the resume step");
+
+    checkpoint_restored_ = true;
+    console_->info("Read checkpoint of step {} at time {}", checkpoint.step,
+                   checkpoint.time);
+  } catch (std::exception& exception) {
+    console_->error("{} #{}: Checkpoint: {}, reading particles\n", __FILE__,
+                    __LINE__, exception.what());
+    status = false;
+  }
+  return status;
 }
 
 //! Write HDF5 files
@@ -236,9 +550,249 @@ void mpm::MPMExplicit<Tdim>::write_hdf5(mpm::Index step, mpm::Index max_steps) {
   std::string attribute = "particles";
   std::string extension = ".h5";
 
-  auto particles_file =
-      io_->output_file(attribute, extension, uuid_, step, max_steps).string();
-
   const unsigned phase = 0;
-  meshes_.at(0)->write_particles_hdf5(phase, particles_file);
+
+  // A single file of the analysis or a file per step
+  const std::string particles_file =
+      hdf5_options_.time_series
+          ? io_->output_file(attribute, extension, uuid_).string()
+          : io_->output_file(attribute, extension, uuid_, step, max_steps)
+                .string();
+
+  // Fields due at this step
+  output_selection_.fields = this->output_fields(step);
+
+  // Snapshot particle fields into a staging buffer
+  auto buffer = this->output_buffer();
+  meshes_.at(0)->gather_particles_hdf5(phase, buffer.get(),
+                                       output_selection_);
+
+  const double time = step * dt_;
+  const auto write = [this, buffer, particles_file, step, time]() {
+    MPM_PROFILE(profiler_.get(), "write_hdf5");
+    if (!this->write_hdf5_buffer(*buffer, particles_file, step, time))
+      throw std::runtime_error("Writing HDF5 output failed");
+  };
+
+  // Hand the buffer to the writer thread while the next steps compute
+  if (output_writer_) {
+    output_writer_->submit(write);
+  } else {
+    MPM_PROFILE(profiler_.get(), "write_hdf5");
+    this->write_hdf5_buffer(*buffer, particles_file, step, time);
+  }
+}
+
+//! Write particle fields of an output step to HDF5
+template <unsigned Tdim>
+bool mpm::MPMExplicit<Tdim>::write_hdf5_buffer(
+    const mpm::HDF5ParticleColumns& columns, const std::string& filename,
+    mpm::Index step, double time) {
+  bool status = true;
+  try {
+    // Append the step to the single file of the analysis
+    if (hdf5_options_.time_series) {
+      if (!hdf5_series_)
+        hdf5_series_ = std::make_unique<mpm::HDF5TimeSeries>(
+            filename, false, false, hdf5_options_.flush_interval);
+      hid_t group = hdf5_series_->create_step(step, time);
+      try {
+        mpm::write_hdf5_particle_columns(group, columns, hdf5_options_, 0,
+                                         columns.size());
+      } catch (...) {
+        hdf5_series_->close_step(group);
+        throw;
+      }
+      hdf5_series_->close_step(group);
+    } else {
+      mpm::write_hdf5_particles(filename, columns, hdf5_options_);
+    }
+  } catch (std::exception& exception) {
+    console_->error("{} #{}: Writing HDF5 step {}: {}\n", __FILE__, __LINE__,
+                    step, exception.what());
+    status = false;
+  }
+  return status;
+}
+
+//! Write particle fields of an output step to VTK
+template <unsigned Tdim>
+bool mpm::MPMExplicit<Tdim>::write_vtk_buffer(
+    mpm::HDF5ParticleColumns* columns, const std::string& filename) {
+  bool status = true;
+  try {
+    const mpm::Index npoints = columns->size();
+    const unsigned fields = columns->fields;
+
+    // VTK points and vectors have 3 components, 1D / 2D values are padded
+    std::vector<double> padded_coordinates, padded_velocities;
+    const auto pad = [npoints](std::vector<double>& values,
+                               std::vector<double>* padded) {
+      if (Tdim == 3) return values.data();
+      padded->assign(npoints * 3, 0.);
+      tbb::parallel_for(mpm::Index(0), npoints, [&](mpm::Index i) {
+        for (unsigned j = 0; j < Tdim; ++j)
+          (*padded)[i * 3 + j] = values[i * Tdim + j];
+      });
+      return padded->data();
+    };
+
+    VtkWriter vtk_writer(pad(columns->coordinates, &padded_coordinates),
+                         npoints);
+
+    // Arrays wrap the staging buffer
+    std::vector<VtkPointArray> arrays;
+    if (fields & mpm::HDF5Field::Mass)
+      arrays.emplace_back(VtkPointArray{"mass", 1, columns->masses.data()});
+    if (fields & mpm::HDF5Field::Velocity)
+      arrays.emplace_back(VtkPointArray{
+          "velocities", 3, pad(columns->velocities, &padded_velocities)});
+    if (fields & mpm::HDF5Field::Stress)
+      arrays.emplace_back(
+          VtkPointArray{"stresses", 6, columns->stresses.data()});
+    if (fields & mpm::HDF5Field::Strain)
+      arrays.emplace_back(VtkPointArray{"strains", 6, columns->strains.data()});
+    if (fields & mpm::HDF5Field::VolumetricStrain)
+      arrays.emplace_back(VtkPointArray{
+          "volumetric_strains", 1, columns->volumetric_strains.data()});
+
+    if (vtk_pieces_ > 1)
+      vtk_writer.write_parallel_point_data(filename, arrays, vtk_pieces_);
+    else
+      vtk_writer.write_point_data(filename, arrays);
+  } catch (std::exception& exception) {
+    console_->error("{} #{}: Writing VTK {}: {}\n", __FILE__, __LINE__,
+                    filename, exception.what());
+    status = false;
+  }
+  return status;
+}
+
+//! Return the fields selected for output at a step
+template <unsigned Tdim>
+unsigned mpm::MPMExplicit<Tdim>::output_fields(mpm::Index step) const {
+  // Fields with an output interval are dropped between their steps
+  unsigned fields = output_fields_;
+  for (const auto& field_step : field_steps_)
+    if (step % field_step.second != 0) fields &= ~field_step.first;
+  return fields;
+}
+
+//! Read fields, regions and decimation of output
+template <unsigned Tdim>
+void mpm::MPMExplicit<Tdim>::read_output_selection(const Json& post_process) {
+  // Fields as a list of names, or as names with output intervals in steps
+  if (post_process.find("fields") != post_process.end()) {
+    const auto fields = post_process.at("fields");
+    unsigned selected = 0;
+    if (fields.is_object()) {
+      for (auto itr = fields.begin(); itr != fields.end(); ++itr) {
+        const unsigned field = mpm::hdf5_field(itr.key());
+        selected |= field;
+        const auto interval = itr.value().template get<mpm::Index>();
+        if (interval > 1) field_steps_[field] = interval;
+      }
+    } else {
+      for (const auto& name : fields)
+        selected |= mpm::hdf5_field(name.template get<std::string>());
+    }
+    output_fields_ = selected;
+  }
+
+  // Axis-aligned regions
+  if (post_process.find("regions") != post_process.end()) {
+    for (const auto& region : post_process.at("regions")) {
+      auto min = region.at("min").template get<std::vector<double>>();
+      auto max = region.at("max").template get<std::vector<double>>();
+      if (min.size() != Tdim || max.size() != Tdim)
+        throw std::runtime_error("Output region dimension is invalid");
+      output_selection_.regions.emplace_back(
+          std::make_pair(std::move(min), std::move(max)));
+    }
+  }
+
+  // Decimation by a stride of particle ids or by a set of ids
+  if (post_process.find("decimation") != post_process.end()) {
+    const auto decimation = post_process.at("decimation");
+    if (decimation.find("stride") != decimation.end())
+      output_selection_.stride =
+          decimation.at("stride").template get<mpm::Index>();
+    if (decimation.find("ids") != decimation.end()) {
+      auto ids = decimation.at("ids").template get<std::vector<mpm::Index>>();
+      std::sort(ids.begin(), ids.end());
+      output_selection_.ids = std::move(ids);
+    }
+  }
+}
+
+//! Return a staging buffer of particle fields for output
+template <unsigned Tdim>
+std::shared_ptr<mpm::HDF5ParticleColumns>
+    mpm::MPMExplicit<Tdim>::output_buffer() {
+  std::unique_ptr<mpm::HDF5ParticleColumns> buffer;
+  {
+    std::lock_guard<std::mutex> lock(output_buffers_mutex_);
+    if (!output_buffers_.empty()) {
+      buffer = std::move(output_buffers_.back());
+      output_buffers_.pop_back();
+    }
+  }
+  if (!buffer) buffer = std::make_unique<mpm::HDF5ParticleColumns>();
+
+  // The buffer returns to the pool once written, keeping its capacity
+  return std::shared_ptr<mpm::HDF5ParticleColumns>(
+      buffer.release(), [this](mpm::HDF5ParticleColumns* columns) {
+        std::lock_guard<std::mutex> lock(output_buffers_mutex_);
+        output_buffers_.emplace_back(columns);
+      });
+}
+
+//! Wait for pending output to be written
+template <unsigned Tdim>
+void mpm::MPMExplicit<Tdim>::complete_output() {
+  if (output_writer_ && !output_writer_->wait())
+    console_->error("{} #{}: Asynchronous output failed\n", __FILE__,
+                    __LINE__);
+}
+
+//! Check heap allocations of a step
+template <unsigned Tdim>
+void mpm::MPMExplicit<Tdim>::check_step_allocations(
+    const mpm::Allocations& start) {
+  if (!check_step_allocations_) return;
+
+  // Output and checkpoints allocate, they are completed in their step so
+  // that background writes do not overlap the steps checked next
+  if (step_ % output_steps_ == 0 ||
+      (checkpoint_steps_ > 0 && step_ % checkpoint_steps_ == 0)) {
+    this->complete_output();
+    return;
+  }
+  if (allocation_checked_steps_++ < allocation_warmup_steps_) return;
+
+  const auto allocations = mpm::heap_allocations() - start;
+  if (allocations.calls > max_step_allocations_)
+    throw std::runtime_error(
+        "Step " + std::to_string(step_) + " allocated " +
+        std::to_string(allocations.calls) + " times (" +
+        std::to_string(allocations.bytes) + " bytes), " +
+        std::to_string(max_step_allocations_) + " allowed in steady state");
+}
+
+//! Write the summary and trace of profiled stages
+template <unsigned Tdim>
+void mpm::MPMExplicit<Tdim>::write_profile() {
+  if (!profiler_) return;
+  try {
+    // Particles updated by each step, for traffic per particle update
+    profiler_->assign_particles(meshes_.at(0)->nparticles());
+    profiler_->write_summary(
+        io_->output_file("profile", ".json", uuid_).string());
+    if (profiler_->trace())
+      profiler_->write_trace(
+          io_->output_file("trace", ".json", uuid_).string());
+  } catch (std::exception& exception) {
+    console_->error("{} #{}: Writing profile: {}\n", __FILE__, __LINE__,
+                    exception.what());
+  }
 }
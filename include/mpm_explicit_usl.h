@@ -37,6 +37,8 @@ class MPMExplicitUSL : public MPMExplicit<Tdim> {
   using mpm::MPMExplicit<Tdim>::nsteps_;
   //! Output steps
   using mpm::MPMExplicit<Tdim>::output_steps_;
+  //! Wall time of the time loop
+  using mpm::MPMExplicit<Tdim>::time_loop_duration_;
   //! A unique ptr to IO object
   using mpm::MPMExplicit<Tdim>::io_;
   //! JSON analysis object
@@ -52,6 +54,14 @@ class MPMExplicitUSL : public MPMExplicit<Tdim> {
   using mpm::MPMExplicit<Tdim>::meshes_;
   //! Materials
   using mpm::MPMExplicit<Tdim>::materials_;
+  //! Particles are generated at quadrature points
+  using mpm::MPMExplicit<Tdim>::generate_particles_;
+  //! Checkpoint interval in steps
+  using mpm::MPMExplicit<Tdim>::checkpoint_steps_;
+  //! Particles are restored from a checkpoint
+  using mpm::MPMExplicit<Tdim>::checkpoint_restored_;
+  //! Profiler of stages
+  using mpm::MPMExplicit<Tdim>::profiler_;
 
 };  // MPMExplicitUSl class
 }  // namespace mpm
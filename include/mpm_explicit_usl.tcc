@@ -14,11 +14,19 @@ bool mpm::MPMExplicitUSL<Tdim>::solve() {
   // Phase
   const unsigned phase = 0;
   // Initialise material
-  bool mat_status = this->initialise_materials();
+  bool mat_status = true;
+  {
+    MPM_PROFILE(profiler_.get(), "initialise_materials");
+    mat_status = this->initialise_materials();
+  }
   if (!mat_status) status = false;
 
   // Initialise mesh and materials
-  bool mesh_status = this->initialise_mesh_particles();
+  bool mesh_status = true;
+  {
+    MPM_PROFILE(profiler_.get(), "initialise_mesh_particles");
+    mesh_status = this->initialise_mesh_particles();
+  }
   if (!mesh_status) status = false;
 
   // Assign material to particles
@@ -30,91 +38,160 @@ bool mpm::MPMExplicitUSL<Tdim>::solve() {
   // Get material from list of materials
   auto material = materials_.at(material_id);
 
-  // Iterate over each particle to assign material
-  meshes_.at(0)->iterate_over_particles(
-      std::bind(&mpm::ParticleBase<Tdim>::assign_material,
-                std::placeholders::_1, material));
+  // Iterate over each particle to assign material, particles restored from a
+  // checkpoint keep their materials
+  if (!checkpoint_restored_)
+    meshes_.at(0)->iterate_over_particles(
+        std::bind(&mpm::ParticleBase<Tdim>::assign_material,
+                  std::placeholders::_1, material));
 
   // Test if checkpoint resume is needed
   bool resume = false;
   if (analysis_.find("resume") != analysis_.end())
     resume = analysis_["resume"]["resume"].template get<bool>();
-  if (resume) this->checkpoint_resume();
+  if (resume) {
+    MPM_PROFILE(profiler_.get(), "checkpoint_resume");
+    this->checkpoint_resume();
+  }
 
+  // Main loop
+  const auto loop_start = std::chrono::steady_clock::now();
   for (; step_ < nsteps_; ++step_) {
+    const auto step_allocations = mpm::heap_allocations();
+    MPM_PROFILE(profiler_.get(), "step");
     console_->info("Step: {} of {}.\n", step_, nsteps_);
-    // Initialise nodes
-    meshes_.at(0)->iterate_over_nodes(
-        std::bind(&mpm::NodeBase<Tdim>::initialise, std::placeholders::_1));
+    // Initialise nodes active in the previous step
+    {
+      MPM_PROFILE(profiler_.get(), "initialise_nodes");
+      meshes_.at(0)->initialise_active_nodes();
+    }
 
-    meshes_.at(0)->iterate_over_cells(
-        std::bind(&mpm::Cell<Tdim>::activate_nodes, std::placeholders::_1));
+    // Activate nodes of cells with particles
+    {
+      MPM_PROFILE(profiler_.get(), "activate_nodes");
+      meshes_.at(0)->activate_nodes();
+    }
 
     // Iterate over each particle to compute shapefn
-    meshes_.at(0)->iterate_over_particles(std::bind(
-        &mpm::ParticleBase<Tdim>::compute_shapefn, std::placeholders::_1));
-
-    // Compute volume
-    meshes_.at(0)->iterate_over_particles(std::bind(
-        &mpm::ParticleBase<Tdim>::compute_volume, std::placeholders::_1));
+    {
+      MPM_PROFILE(profiler_.get(), "shapefn");
+      meshes_.at(0)->iterate_over_particles(std::bind(
+          &mpm::ParticleBase<Tdim>::compute_shapefn, std::placeholders::_1));
+
+      // Compute volume, generated particles have volumes assigned
+      if (!generate_particles_)
+        meshes_.at(0)->iterate_over_particles(std::bind(
+            &mpm::ParticleBase<Tdim>::compute_volume, std::placeholders::_1));
+    }
 
     // Compute mass
-    meshes_.at(0)->iterate_over_particles(std::bind(
-        &mpm::ParticleBase<Tdim>::compute_mass, std::placeholders::_1, phase));
-    // Assign mass and momentum to nodes
-    meshes_.at(0)->iterate_over_particles(
-        std::bind(&mpm::ParticleBase<Tdim>::map_mass_momentum_to_nodes,
-                  std::placeholders::_1, phase));
+    {
+      MPM_PROFILE(profiler_.get(), "p2g");
+      meshes_.at(0)->iterate_over_particles(
+          std::bind(&mpm::ParticleBase<Tdim>::compute_mass,
+                    std::placeholders::_1, phase));
+      // Assign mass and momentum to nodes
+      meshes_.at(0)->iterate_over_particles(
+          std::bind(&mpm::ParticleBase<Tdim>::map_mass_momentum_to_nodes,
+                    std::placeholders::_1, phase));
+    }
 
     // Compute nodal velocity
-    meshes_.at(0)->iterate_over_nodes_predicate(
-        std::bind(&mpm::NodeBase<Tdim>::compute_velocity,
-                  std::placeholders::_1),
-        std::bind(&mpm::NodeBase<Tdim>::status, std::placeholders::_1));
+    {
+      MPM_PROFILE(profiler_.get(), "nodal_velocity");
+      meshes_.at(0)->iterate_over_active_nodes(std::bind(
+          &mpm::NodeBase<Tdim>::compute_velocity, std::placeholders::_1));
 
-    // Iterate over each particle to compute nodal body force
-    meshes_.at(0)->iterate_over_particles(
-        std::bind(&mpm::ParticleBase<Tdim>::map_body_force,
-                  std::placeholders::_1, phase, this->gravity_));
+      // Apply velocity constraints
+      meshes_.at(0)->apply_velocity_constraints();
+    }
 
-    // Iterate over each particle to compute nodal internal force
-    meshes_.at(0)->iterate_over_particles(
-        std::bind(&mpm::ParticleBase<Tdim>::map_internal_force,
-                  std::placeholders::_1, phase));
+    // Iterate over each particle to compute nodal body force
+    {
+      MPM_PROFILE(profiler_.get(), "p2g_forces");
+      meshes_.at(0)->iterate_over_particles(
+          std::bind(&mpm::ParticleBase<Tdim>::map_body_force,
+                    std::placeholders::_1, phase, this->gravity_));
+
+      // Iterate over each particle to compute nodal internal force
+      meshes_.at(0)->iterate_over_particles(
+          std::bind(&mpm::ParticleBase<Tdim>::map_internal_force,
+                    std::placeholders::_1, phase));
+    }
 
     // Iterate over active nodes to compute acceleratation and velocity
-    meshes_.at(0)->iterate_over_nodes_predicate(
-        std::bind(&mpm::NodeBase<Tdim>::compute_acceleration_velocity,
-                  std::placeholders::_1, phase, this->dt_),
-        std::bind(&mpm::NodeBase<Tdim>::status, std::placeholders::_1));
+    {
+      MPM_PROFILE(profiler_.get(), "nodal_update");
+      meshes_.at(0)->iterate_over_active_nodes(
+          std::bind(&mpm::NodeBase<Tdim>::compute_acceleration_velocity,
+                    std::placeholders::_1, phase, this->dt_));
+
+      // Apply velocity constraints, which also sets acceleration to 0
+      meshes_.at(0)->apply_velocity_constraints();
+    }
 
     // Iterate over each particle to compute updated position
-    meshes_.at(0)->iterate_over_particles(
-        std::bind(&mpm::ParticleBase<Tdim>::compute_updated_position,
-                  std::placeholders::_1, phase, this->dt_));
+    {
+      MPM_PROFILE(profiler_.get(), "g2p");
+      meshes_.at(0)->iterate_over_particles(
+          std::bind(&mpm::ParticleBase<Tdim>::compute_updated_position,
+                    std::placeholders::_1, phase, this->dt_));
+    }
 
     // Iterate over each particle to calculate strain
-    meshes_.at(0)->iterate_over_particles(
-        std::bind(&mpm::ParticleBase<Tdim>::compute_strain,
-                  std::placeholders::_1, phase, dt_));
+    {
+      MPM_PROFILE(profiler_.get(), "strain");
+      meshes_.at(0)->iterate_over_particles(
+          std::bind(&mpm::ParticleBase<Tdim>::compute_strain,
+                    std::placeholders::_1, phase, dt_));
+    }
 
     // Iterate over each particle to compute stress
-    meshes_.at(0)->iterate_over_particles(
-        std::bind(&mpm::ParticleBase<Tdim>::compute_stress,
-                  std::placeholders::_1, phase));
+    {
+      MPM_PROFILE(profiler_.get(), "stress");
+      meshes_.at(0)->iterate_over_particles(
+          std::bind(&mpm::ParticleBase<Tdim>::compute_stress,
+                    std::placeholders::_1, phase));
+    }
 
     // Locate particles
-    auto unlocatable_particles = meshes_.at(0)->locate_particles_mesh();
+    std::vector<std::shared_ptr<mpm::ParticleBase<Tdim>>> unlocatable_particles;
+    {
+      MPM_PROFILE(profiler_.get(), "locate");
+      unlocatable_particles = meshes_.at(0)->locate_particles_mesh();
+    }
 
     if (!unlocatable_particles.empty())
       throw std::runtime_error("Particle outside the mesh domain");
 
     if (step_ % output_steps_ == 0) {
+      MPM_PROFILE(profiler_.get(), "output");
       // VTK outputs
       this->write_vtk(step_, this->nsteps_);
       // HDF5 outputs
       this->write_hdf5(step_, this->nsteps_);
     }
+
+    // Checkpoint of the state, independent of the output steps
+    if (checkpoint_steps_ > 0 && step_ % checkpoint_steps_ == 0) {
+      MPM_PROFILE(profiler_.get(), "checkpoint");
+      this->write_checkpoint(step_, this->nsteps_);
+    }
+
+    // Heap allocations of steady state steps
+    this->check_step_allocations(step_allocations);
   }
+  // Complete pending output
+  {
+    MPM_PROFILE(profiler_.get(), "complete_output");
+    this->complete_output();
+  }
+  time_loop_duration_ = std::chrono::duration<double>(
+                            std::chrono::steady_clock::now() - loop_start)
+                            .count();
+
+  // Summary and trace of stages
+  this->write_profile();
+
   return status;
 }
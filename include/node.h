@@ -59,6 +59,9 @@ class Node : public NodeBase<Tdim> {
   //! Return degrees of freedom
   unsigned dof() const override { return dof_; }
 
+  //! Return number of phases
+  unsigned nphases() const override { return Tnphases; }
+
   //! Assign status
   void assign_status(bool status) override { status_ = status; }
 
@@ -155,14 +158,11 @@ class Node : public NodeBase<Tdim> {
   //! \param[in] dt Timestep in analysis
   bool compute_acceleration_velocity(unsigned phase, double dt) override;
 
-  //! Assign velocity constraint
+  //! Apply a velocity constraint, which also sets acceleration to 0
   //! Directions can take values between 0 and Dim * Nphases
   //! \param[in] dir Direction of velocity constraint
   //! \param[in] velocity Applied velocity constraint
-  bool assign_velocity_constraint(unsigned dir, double velocity) override;
-
-  //! Apply velocity constraints
-  void apply_velocity_constraints() override;
+  void apply_velocity_constraint(unsigned dir, double velocity) override;
 
  private:
   //! Mutex
@@ -189,8 +189,6 @@ class Node : public NodeBase<Tdim> {
   Eigen::Matrix<double, Tdim, Tnphases> momentum_;
   //! Acceleration
   Eigen::Matrix<double, Tdim, Tnphases> acceleration_;
-  //! Velocity constraints
-  std::map<unsigned, double> velocity_constraints_;
   //! Logger
   std::unique_ptr<spdlog::logger> console_;
 };  // Node class
@@ -14,8 +14,6 @@ mpm::Node<Tdim, Tdof, Tnphases>::Node(
       "node" + std::to_string(Tdim) + "d::" + std::to_string(id);
   console_ = std::make_unique<spdlog::logger>(logger, mpm::stdout_sink);
 
-  // Clear any velocity constraints
-  velocity_constraints_.clear();
   this->initialise();
 }
 
@@ -149,10 +147,6 @@ void mpm::Node<Tdim, Tdof, Tnphases>::compute_velocity() {
       } else
         throw std::runtime_error("Nodal mass is zero or below threshold");
     }
-
-    // Apply velocity constraints, which also sets acceleration to 0,
-    // when velocity is set.
-    this->apply_velocity_constraints();
   } catch (std::exception& exception) {
     console_->error("{} #{}: {}\n", __FILE__, __LINE__, exception.what());
   }
@@ -199,9 +193,6 @@ bool mpm::Node<Tdim, Tdof, Tnphases>::compute_acceleration_velocity(
 
       // Velocity += acceleration * dt
       this->velocity_.col(phase) += this->acceleration_.col(phase) * dt;
-      // Apply velocity constraints, which also sets acceleration to 0,
-      // when velocity is set.
-      this->apply_velocity_constraints();
     } else
       throw std::runtime_error("Nodal mass is zero or below threshold");
 
@@ -212,39 +203,14 @@ bool mpm::Node<Tdim, Tdof, Tnphases>::compute_acceleration_velocity(
   return status;
 }
 
-//! Assign velocity constraint
-//! Constrain directions can take values between 0 and Dim * Nphases
+//! Apply a velocity constraint
 template <unsigned Tdim, unsigned Tdof, unsigned Tnphases>
-bool mpm::Node<Tdim, Tdof, Tnphases>::assign_velocity_constraint(
+void mpm::Node<Tdim, Tdof, Tnphases>::apply_velocity_constraint(
     unsigned dir, double velocity) {
-  bool status = true;
-  try {
-    //! Constrain directions can take values between 0 and Dim * Nphases
-    if (dir >= 0 && dir < (Tdim * Tnphases))
-      this->velocity_constraints_.insert(std::make_pair<unsigned, double>(
-          static_cast<unsigned>(dir), static_cast<double>(velocity)));
-    else
-      throw std::runtime_error("Constraint direction is out of bounds");
-
-  } catch (std::exception& exception) {
-    console_->error("{} #{}: {}\n", __FILE__, __LINE__, exception.what());
-    status = false;
-  }
-  return status;
-}
-
-//! Apply velocity constraints
-template <unsigned Tdim, unsigned Tdof, unsigned Tnphases>
-void mpm::Node<Tdim, Tdof, Tnphases>::apply_velocity_constraints() {
-  // Set velocity constraint
-  for (const auto& constraint : this->velocity_constraints_) {
-    // Direction value in the constraint (0, Dim * Nphases)
-    const unsigned dir = constraint.first;
-    // Direction: dir % Tdim (modulus)
-    const auto direction = static_cast<unsigned>(dir % Tdim);
-    // Phase: Integer value of division (dir / Tdim)
-    const auto phase = static_cast<unsigned>(dir / Tdim);
-    this->velocity_(direction, phase) = constraint.second;
-    this->acceleration_(direction, phase) = 0.;
-  }
+  // Direction: dir % Tdim (modulus)
+  const auto direction = static_cast<unsigned>(dir % Tdim);
+  // Phase: Integer value of division (dir / Tdim)
+  const auto phase = static_cast<unsigned>(dir / Tdim);
+  this->velocity_(direction, phase) = velocity;
+  this->acceleration_(direction, phase) = 0.;
 }
@@ -53,6 +53,9 @@ class NodeBase {
   //! Return degrees of freedom
   virtual unsigned dof() const = 0;
 
+  //! Return number of phases
+  virtual unsigned nphases() const = 0;
+
   //! Assign status
   virtual void assign_status(bool status) = 0;
 
@@ -135,14 +138,11 @@ class NodeBase {
   //! Compute acceleration
   virtual bool compute_acceleration_velocity(unsigned phase, double dt) = 0;
 
-  //! Assign velocity constraint
-  //! Directions can take values between 0 and Dim * Nphases
+  //! Apply a velocity constraint, which also sets acceleration to 0
+  //! Constraints are held and applied by the mesh
   //! \param[in] dir Direction of velocity constraint
   //! \param[in] velocity Applied velocity constraint
-  virtual bool assign_velocity_constraint(unsigned dir, double velocity) = 0;
-
-  //! Apply velocity constraints
-  virtual void apply_velocity_constraints() = 0;
+  virtual void apply_velocity_constraint(unsigned dir, double velocity) = 0;
 
 };  // NodeBase class
 }  // namespace mpm
@@ -62,12 +62,18 @@ class Particle : public ParticleBase<Tdim> {
   VectorDim reference_location() const override { return xi_; }
 
   //! Assign a cell to particle
-  //! If point is in new cell, assign new cell and remove particle id from old
-  //! cell. If point can't be found in the new cell, check if particle is still
-  //! valid in the old cell, if it is leave it as is. If not, set cell as null
+  //! If point is in new cell, assign new cell and remove particle from old
+  //! cell. If point can't be found in the new cell, the particle keeps its
+  //! old cell
   //! \param[in] cellptr Pointer to a cell
   bool assign_cell(const std::shared_ptr<Cell<Tdim>>& cellptr) override;
 
+  //! Assign a cell and the reference location in it without a search
+  //! \param[in] cellptr Pointer to a cell
+  //! \param[in] xi Reference location of the particle in the cell
+  bool assign_cell_xi(const std::shared_ptr<Cell<Tdim>>& cellptr,
+                      const VectorDim& xi) override;
+
   //! Return cell id
   Index cell_id() const override { return cell_id_; }
 
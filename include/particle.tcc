@@ -88,14 +88,15 @@ bool mpm::Particle<Tdim, Tnphases>::assign_cell(
   try {
     // Assign cell to the new cell ptr, if point can be found in new cell
     if (cellptr->is_point_in_cell(this->coordinates_)) {
-      // if a cell already exists remove particle from that cell
-      if (cell_ != nullptr) cell_->remove_particle_id(this->id_);
-
+      // Move the particle from the previous cell
+      if (cell_ != cellptr) {
+        if (cell_ != nullptr) cell_->remove_particle();
+        cellptr->add_particle();
+      }
       cell_ = cellptr;
       cell_id_ = cellptr->id();
       // Calculate the reference location of particle
-      this->compute_reference_location();
-      status = cell_->add_particle_id(this->id());
+      status = this->compute_reference_location();
     } else {
       throw std::runtime_error("Point cannot be found in cell!");
     }
@@ -106,11 +107,34 @@ bool mpm::Particle<Tdim, Tnphases>::assign_cell(
   return status;
 }
 
+// Assign a cell and the reference location in it without a search
+template <unsigned Tdim, unsigned Tnphases>
+bool mpm::Particle<Tdim, Tnphases>::assign_cell_xi(
+    const std::shared_ptr<Cell<Tdim>>& cellptr, const VectorDim& xi) {
+  bool status = true;
+  try {
+    if (cellptr == nullptr) throw std::runtime_error("Cell is undefined!");
+    // Move the particle from the previous cell
+    if (cell_ != cellptr) {
+      if (cell_ != nullptr) cell_->remove_particle();
+      cellptr->add_particle();
+    }
+    cell_ = cellptr;
+    cell_id_ = cellptr->id();
+    xi_ = xi;
+  } catch (std::exception& exception) {
+    console_->error("{} #{}: {}\n", __FILE__, __LINE__, exception.what());
+    status = false;
+  }
+  return status;
+}
+
 // Remove cell for the particle
 template <unsigned Tdim, unsigned Tnphases>
 void mpm::Particle<Tdim, Tnphases>::remove_cell() {
   // if a cell is not nullptr
-  if (cell_ != nullptr) cell_->remove_particle_id(this->id_);
+  if (cell_ != nullptr) cell_->remove_particle();
+  cell_ = nullptr;
   cell_id_ = std::numeric_limits<Index>::max();
 }
 
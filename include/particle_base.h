@@ -74,6 +74,10 @@ class ParticleBase {
   //! Assign cell
   virtual bool assign_cell(const std::shared_ptr<Cell<Tdim>>& cellptr) = 0;
 
+  //! Assign a cell and the reference location in it without a search
+  virtual bool assign_cell_xi(const std::shared_ptr<Cell<Tdim>>& cellptr,
+                              const VectorDim& xi) = 0;
+
   //! Return cell id
   virtual Index cell_id() const = 0;
 
@@ -102,6 +106,12 @@ class ParticleBase {
   virtual bool assign_material(
       const std::shared_ptr<Material<Tdim>>& material) = 0;
 
+  //! Return material id, max unsigned if no material is assigned
+  unsigned material_id() const {
+    return material_ != nullptr ? material_->id()
+                                : std::numeric_limits<unsigned>::max();
+  }
+
   //! Assign status
   void assign_status(bool status) { status_ = status; }
 
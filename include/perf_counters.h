@@ -0,0 +1,82 @@
+#ifndef MPM_PERF_COUNTERS_H_
+#define MPM_PERF_COUNTERS_H_
+
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <tbb/task_scheduler_observer.h>
+
+//! MPM namespace
+namespace mpm {
+
+//! Event counted by PerfCounters
+struct PerfEvent {
+  //! Name of the event
+  std::string name;
+  //! Type of the event, as perf_event_attr::type
+  std::uint32_t type;
+  //! Configuration of the event, as perf_event_attr::config
+  std::uint64_t config;
+};
+
+//! PerfCounters class
+//! \brief Counts events of the threads of the task scheduler with
+//! perf_event_open
+//! \details A counter group is opened for the constructing thread and for
+//! each thread entering the TBB scheduler afterwards, only user space is
+//! counted. A read sums the groups of all threads, scaled for multiplexing.
+//! Events the kernel or the hardware does not provide are left out, without
+//! perf_event_open (other systems, virtual machines, restricted containers)
+//! no events are counted.
+class PerfCounters : public tbb::task_scheduler_observer {
+ public:
+  //! Return events of cycles, instructions, LLC misses and branch misses
+  static std::vector<PerfEvent> hardware_events();
+
+  //! Constructor opens the counters of the calling thread
+  //! \param[in] events Events to count
+  explicit PerfCounters(
+      const std::vector<PerfEvent>& events = hardware_events());
+
+  //! Destructor closes the counters
+  ~PerfCounters() override;
+
+  //! Delete copy constructor
+  PerfCounters(const PerfCounters&) = delete;
+
+  //! Delete assignement operator
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  //! Return names of the events being counted
+  const std::vector<std::string>& names() const { return names_; }
+
+  //! Return counts of events summed over threads, in the order of names
+  std::vector<double> read() const;
+
+  //! Open the counters of a thread entering the scheduler
+  //! \param[in] worker Thread is a worker of the scheduler
+  void on_scheduler_entry(bool worker) override;
+
+ private:
+  //! Open a counter group of the calling thread if it has none
+  //! \param[in] drop Leave out events which cannot be opened
+  void open_thread(bool drop);
+
+  //! Events being counted
+  std::vector<PerfEvent> events_;
+  //! Names of the events being counted
+  std::vector<std::string> names_;
+  //! File descriptors of the counter group of each thread, leader first
+  std::vector<std::vector<int>> groups_;
+  //! Threads with counters
+  std::set<std::thread::id> threads_;
+  //! Mutex of the counter groups
+  mutable std::mutex mutex_;
+};  // PerfCounters class
+}  // namespace mpm
+
+#endif  // MPM_PERF_COUNTERS_H_
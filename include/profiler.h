@@ -0,0 +1,197 @@
+#ifndef MPM_PROFILER_H_
+#define MPM_PROFILER_H_
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "json.hpp"
+
+#include "allocation_tracker.h"
+#include "perf_counters.h"
+
+//! Time a scope as a stage of a profiler, compiled out unless MPM_PROFILING
+//! is defined. The profiler is a pointer, a null profiler records nothing.
+#ifdef MPM_PROFILING
+#define MPM_PROFILE_CONCAT_(a, b) a##b
+#define MPM_PROFILE_CONCAT(a, b) MPM_PROFILE_CONCAT_(a, b)
+#define MPM_PROFILE(profiler, stage) \
+  mpm::ScopedTimer MPM_PROFILE_CONCAT(scoped_timer_, __LINE__)(profiler, stage)
+#define MPM_PROFILE_RECORD(profiler, stage, start, end)  \
+  do {                                                   \
+    if (profiler) (profiler)->record(stage, start, end); \
+  } while (0)
+#else
+#define MPM_PROFILE(profiler, stage)
+#define MPM_PROFILE_RECORD(profiler, stage, start, end)
+#endif
+
+//! MPM namespace
+namespace mpm {
+
+//! Profiler class
+//! \brief Collects the durations of named stages
+//! \details Stages are recorded from any thread. The summary gives the
+//! number of calls, total, mean and 99th percentile duration of each stage
+//! and its share of the total of a reference stage, usually a step. Events
+//! are kept for a Chrome trace (chrome://tracing) when the trace is enabled,
+//! with a row per thread that records stages. A stage is recorded by the
+//! thread that runs it, the solver or the output writer; work of the TBB
+//! threads inside a stage is part of its duration and has no spans of its
+//! own in the trace. With counters enabled, stages also sum the
+//! events of all threads counted during the stage, which is reported with
+//! the instructions per cycle and the bytes of LLC misses per particle
+//! update. With allocation tracking, stages sum the heap allocations of all
+//! threads during the stage.
+class Profiler {
+ public:
+  //! Clock of the profiler
+  using Clock = std::chrono::steady_clock;
+
+  //! Constructor
+  //! \param[in] trace Keep events for a trace
+  explicit Profiler(bool trace = false);
+
+  //! Record a stage
+  //! \param[in] stage Name of the stage
+  //! \param[in] start Start of the stage
+  //! \param[in] end End of the stage
+  //! \param[in] counts Counts of events during the stage, if counted
+  //! \param[in] allocations Heap allocations during the stage, if tracked
+  void record(const std::string& stage, Clock::time_point start,
+              Clock::time_point end, const std::vector<double>& counts = {},
+              const Allocations* allocations = nullptr);
+
+  //! Count events of stages
+  //! \param[in] events Events to count
+  //! \retval status Any of the events is counted
+  bool enable_counters(
+      const std::vector<PerfEvent>& events = PerfCounters::hardware_events());
+
+  //! Return counters of events, null unless enabled
+  const PerfCounters* counters() const { return counters_.get(); }
+
+  //! Assign the number of particles updated by each call of a stage
+  //! \param[in] nparticles Number of particles
+  void assign_particles(std::size_t nparticles) { nparticles_ = nparticles; }
+
+  //! Return the summary of stages in the order of their first record
+  //! \param[in] reference Stage the shares of stages are relative to
+  //! \retval summary Durations of stages in milliseconds
+  nlohmann::json summary(const std::string& reference = "step") const;
+
+  //! Write the summary of stages to a JSON file, throws on failure
+  //! \param[in] filename Name of the JSON file
+  //! \param[in] reference Stage the shares of stages are relative to
+  void write_summary(const std::string& filename,
+                     const std::string& reference = "step") const;
+
+  //! Write recorded events as a Chrome trace, throws on failure
+  //! \param[in] filename Name of the trace file
+  void write_trace(const std::string& filename) const;
+
+  //! Return if events are kept for a trace
+  bool trace() const { return trace_; }
+
+ private:
+  //! Event of a trace
+  struct Event {
+    //! Index of the stage
+    unsigned stage;
+    //! Index of the thread
+    unsigned thread;
+    //! Start in microseconds from the construction of the profiler
+    double start;
+    //! Duration in microseconds
+    double duration;
+  };
+
+  //! Keep events for a trace
+  bool trace_{false};
+  //! Construction time of the profiler
+  Clock::time_point origin_;
+  //! Names of stages in the order of their first record
+  std::vector<std::string> stages_;
+  //! Index of stages by name
+  std::map<std::string, unsigned> stage_index_;
+  //! Durations of calls of each stage in milliseconds
+  std::vector<std::vector<double>> durations_;
+  //! Counters of events
+  std::unique_ptr<PerfCounters> counters_;
+  //! Counts of events of each stage
+  std::vector<std::vector<double>> counts_;
+  //! Heap allocations of each stage
+  std::vector<Allocations> allocations_;
+  //! Stages recorded with heap allocations
+  std::vector<bool> allocations_tracked_;
+  //! Number of particles updated by each call of a stage
+  std::size_t nparticles_{0};
+  //! Index of threads in the order of their first record
+  std::map<std::thread::id, unsigned> threads_;
+  //! Events of the trace
+  std::vector<Event> events_;
+  //! Mutex of the records
+  mutable std::mutex mutex_;
+};  // Profiler class
+
+//! ScopedTimer class
+//! \brief Records the lifetime of a scope as a stage of a profiler
+class ScopedTimer {
+ public:
+  //! Constructor starts the timer
+  //! \param[in] profiler Profiler to record to, nothing is recorded if null
+  //! \param[in] stage Name of the stage
+  ScopedTimer(Profiler* profiler, const char* stage)
+      : profiler_{profiler}, stage_{stage} {
+    if (profiler_) {
+      {
+        // Bookkeeping of the timer is not a heap allocation of the stage
+        UntrackedAllocations untracked;
+        if (profiler_->counters()) counts_ = profiler_->counters()->read();
+      }
+      if (allocation_tracking()) allocations_ = heap_allocations();
+      start_ = Profiler::Clock::now();
+    }
+  }
+
+  //! Destructor records the stage
+  ~ScopedTimer() {
+    if (profiler_) {
+      const auto end = Profiler::Clock::now();
+      const Allocations allocations = heap_allocations() - allocations_;
+      UntrackedAllocations untracked;
+      if (profiler_->counters()) {
+        const auto counts = profiler_->counters()->read();
+        for (std::size_t i = 0; i < counts_.size(); ++i)
+          counts_[i] = counts[i] - counts_[i];
+      }
+      profiler_->record(stage_, start_, end, counts_,
+                        allocation_tracking() ? &allocations : nullptr);
+    }
+  }
+
+  //! Delete copy constructor
+  ScopedTimer(const ScopedTimer&) = delete;
+
+  //! Delete assignement operator
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+ private:
+  //! Profiler
+  Profiler* profiler_{nullptr};
+  //! Name of the stage
+  const char* stage_;
+  //! Start of the stage
+  Profiler::Clock::time_point start_;
+  //! Counts of events at the start, then during the stage
+  std::vector<double> counts_;
+  //! Heap allocations at the start of the stage
+  Allocations allocations_;
+};  // ScopedTimer class
+}  // namespace mpm
+
+#endif  // MPM_PROFILER_H_
@@ -5,6 +5,7 @@
 #include <fstream>
 #include <memory>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 // Boost string algorithm
@@ -52,6 +53,17 @@ class ReadMesh {
   virtual std::vector<std::vector<mpm::Index>> read_mesh_cells(
       const std::string& mesh) = 0;
 
+  //! Read mesh nodes and cells file
+  //! Readers that parse the file once override this, by default the nodes
+  //! and cells are read separately
+  //! \param[in] mesh file name with nodes and cells
+  //! \retval mesh Pair of nodal coordinates and nodal indices of cells
+  virtual std::pair<std::vector<VectorDim>, std::vector<std::vector<mpm::Index>>>
+      read_mesh(const std::string& mesh) {
+    return std::make_pair(this->read_mesh_nodes(mesh),
+                          this->read_mesh_cells(mesh));
+  }
+
   //! Read particles file
   //! \param[in] particles_files file name with particle coordinates
   //! \retval coordinates Vector of particle coordinates
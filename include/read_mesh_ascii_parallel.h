@@ -0,0 +1,149 @@
+#ifndef MPM_READ_MESH_ASCII_PARALLEL_H_
+#define MPM_READ_MESH_ASCII_PARALLEL_H_
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Eigen/Dense"
+#include "tbb/parallel_for.h"
+
+#include "mapped_file.h"
+#include "read_mesh.h"
+
+//! MPM namespace
+namespace mpm {
+
+//! Global index type for the cell
+using Index = unsigned long long;
+
+//! ReadMeshAsciiParallel class
+//! \brief Derived class that returns mesh and particles locations from ascii
+//! files, which are memory-mapped, split into line-aligned chunks and parsed
+//! in parallel. The file format is the same as ReadMeshAscii.
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+class ReadMeshAsciiParallel : public ReadMesh<Tdim> {
+ public:
+  //! Define a vector of size dimension
+  using VectorDim = Eigen::Matrix<double, Tdim, 1>;
+
+  //! Constructor
+  ReadMeshAsciiParallel() : ReadMeshAsciiParallel(1 << 20) {}
+
+  //! Constructor with chunk size
+  //! \param[in] chunk_size Approximate size of a chunk parsed by a task
+  explicit ReadMeshAsciiParallel(std::size_t chunk_size)
+      : mpm::ReadMesh<Tdim>(), chunk_size_{chunk_size > 0 ? chunk_size : 1} {
+    //! Logger
+    console_ = spdlog::get("ReadMeshAsciiParallel");
+  }
+
+  //! Destructor
+  ~ReadMeshAsciiParallel() override = default;
+
+  //! Read mesh nodes file
+  //! \param[in] mesh file name with nodes and cells
+  //! \retval coordinates Vector of nodal coordinates
+  std::vector<VectorDim> read_mesh_nodes(const std::string& mesh) override;
+
+  //! Read mesh cells file
+  //! \param[in] mesh file name with nodes and cells
+  //! \retval cells Vector of nodal indices of cells
+  std::vector<std::vector<mpm::Index>> read_mesh_cells(
+      const std::string& mesh) override;
+
+  //! Read mesh nodes and cells file in a single pass
+  //! \param[in] mesh file name with nodes and cells
+  //! \retval mesh Pair of nodal coordinates and nodal indices of cells
+  std::pair<std::vector<VectorDim>, std::vector<std::vector<mpm::Index>>>
+      read_mesh(const std::string& mesh) override;
+
+  //! Read particles file
+  //! \param[in] particles_files file name with particle coordinates
+  //! \retval coordinates Vector of particle coordinates
+  std::vector<VectorDim> read_particles(
+      const std::string& particles_file) override;
+
+  //! Read constraints file
+  //! \param[in] velocity_constraints_files file name with constraints
+  std::vector<std::tuple<mpm::Index, unsigned, double>>
+      read_velocity_constraints(
+          const std::string& velocity_constraints_file) override;
+
+ private:
+  //! Line-aligned chunks of a mapped file
+  struct Chunks {
+    //! Offset of the first byte of each chunk, with the file size appended
+    std::vector<std::size_t> offsets;
+    //! Index of the first data line in each chunk
+    std::vector<mpm::Index> first_lines;
+    //! Total number of data lines
+    mpm::Index nlines{0};
+  };
+
+  //! Split a mapped file into line-aligned chunks and count data lines
+  //! \param[in] file Mapped file
+  Chunks split_chunks(const mpm::MappedFile& file) const;
+
+  //! Call a function on each data line in parallel
+  //! \param[in] file Mapped file
+  //! \param[in] chunks Line-aligned chunks of the file
+  //! \param[in] parse_line Function of (data line index, line begin, line end)
+  template <typename Tparse>
+  void parse_lines(const mpm::MappedFile& file, const Chunks& chunks,
+                   Tparse parse_line) const;
+
+  //! Call a function on each line between first and last
+  //! \param[in] first Beginning of the characters
+  //! \param[in] last End of the characters
+  //! \param[in] function Function of (line begin, line end)
+  template <typename Tfunction>
+  static void for_each_line(const char* first, const char* last,
+                            Tfunction function);
+
+  //! Check if a line holds data, comment lines (# or !) and blank lines don't
+  //! \param[in] first Beginning of the line
+  //! \param[in] last End of the line
+  static bool data_line(const char* first, const char* last);
+
+  //! Parse an unsigned integer, throws if no number is found
+  //! \param[in] first Beginning of the characters to parse
+  //! \param[in] last End of the characters to parse
+  //! \param[out] value Parsed value
+  //! \retval next Pointer past the parsed number
+  static const char* parse_value(const char* first, const char* last,
+                                 mpm::Index* value);
+
+  //! Parse a floating point number, throws if no number is found
+  //! \param[in] first Beginning of the characters to parse
+  //! \param[in] last End of the characters to parse
+  //! \param[out] value Parsed value
+  //! \retval next Pointer past the parsed number
+  static const char* parse_value(const char* first, const char* last,
+                                 double* value);
+
+  //! Skip whitespace
+  //! \param[in] first Beginning of the characters
+  //! \param[in] last End of the characters
+  static const char* skip_whitespace(const char* first, const char* last) {
+    while (first != last &&
+           (*first == ' ' || *first == '\t' || *first == '\r'))
+      ++first;
+    return first;
+  }
+
+  //! Approximate size of a chunk parsed by a task
+  std::size_t chunk_size_;
+  //! Logger
+  std::shared_ptr<spdlog::logger> console_;
+};  // ReadMeshAsciiParallel class
+}  // namespace mpm
+
+#include "read_mesh_ascii_parallel.tcc"
+
+#endif  // MPM_READ_MESH_ASCII_PARALLEL_H_
@@ -0,0 +1,339 @@
+//! Return coordinates of nodes in a mesh from input file
+template <unsigned Tdim>
+std::vector<Eigen::Matrix<double, Tdim, 1>>
+    mpm::ReadMeshAsciiParallel<Tdim>::read_mesh_nodes(const std::string& mesh) {
+  return std::move(this->read_mesh(mesh).first);
+}
+
+//! Return indices of nodes of cells in a mesh from input file
+template <unsigned Tdim>
+std::vector<std::vector<mpm::Index>>
+    mpm::ReadMeshAsciiParallel<Tdim>::read_mesh_cells(const std::string& mesh) {
+  return std::move(this->read_mesh(mesh).second);
+}
+
+//! Return coordinates of nodes and indices of nodes of cells in a mesh
+template <unsigned Tdim>
+std::pair<std::vector<Eigen::Matrix<double, Tdim, 1>>,
+          std::vector<std::vector<mpm::Index>>>
+    mpm::ReadMeshAsciiParallel<Tdim>::read_mesh(const std::string& mesh) {
+  // Nodal coordinates
+  std::vector<VectorDim> coordinates;
+  // Indices of nodes
+  std::vector<std::vector<mpm::Index>> cells;
+
+  try {
+    const mpm::MappedFile file(mesh);
+    const auto chunks = this->split_chunks(file);
+
+    if (chunks.nlines > 0) {
+      // Read number of nodes from the first data line
+      mpm::Index nnodes = 0;
+      const char* end = file.data() + file.size();
+      for (const char* first = file.data(); first < end;) {
+        auto eol =
+            static_cast<const char*>(std::memchr(first, '\n', end - first));
+        if (eol == nullptr) eol = end;
+        if (data_line(first, eol)) {
+          parse_value(first, eol, &nnodes);
+          break;
+        }
+        first = eol + 1;
+      }
+
+      // Lines following the nodal coordinates are cells
+      const mpm::Index nnode_lines = std::min(nnodes, chunks.nlines - 1);
+      coordinates.resize(nnode_lines);
+      cells.resize(chunks.nlines - 1 - nnode_lines);
+
+      this->parse_lines(
+          file, chunks,
+          [&](mpm::Index line, const char* first, const char* last) {
+            // Skip number of nodes and cells
+            if (line == 0) return;
+            if (line <= nnodes) {
+              // Read coordinates
+              VectorDim coords;
+              for (unsigned i = 0; i < Tdim; ++i)
+                first = parse_value(first, last, &coords[i]);
+              coordinates[line - 1] = coords;
+            } else {
+              // Read node ids of each cell
+              auto& nodes = cells[line - 1 - nnodes];
+              for (first = skip_whitespace(first, last); first != last;
+                   first = skip_whitespace(first, last)) {
+                mpm::Index nid;
+                first = parse_value(first, last, &nid);
+                nodes.emplace_back(nid);
+              }
+            }
+          });
+    }
+  } catch (std::exception& exception) {
+    console_->error("Read mesh: {}", exception.what());
+    coordinates.clear();
+    cells.clear();
+  }
+
+  return std::make_pair(std::move(coordinates), std::move(cells));
+}
+
+//! Return coordinates of particles
+template <unsigned Tdim>
+std::vector<Eigen::Matrix<double, Tdim, 1>>
+    mpm::ReadMeshAsciiParallel<Tdim>::read_particles(
+        const std::string& particles_file) {
+  // Particle coordinates
+  std::vector<VectorDim> coordinates;
+
+  try {
+    const mpm::MappedFile file(particles_file);
+    const auto chunks = this->split_chunks(file);
+    coordinates.resize(chunks.nlines);
+
+    this->parse_lines(
+        file, chunks,
+        [&](mpm::Index line, const char* first, const char* last) {
+          // Read coordinates
+          VectorDim coords;
+          for (unsigned i = 0; i < Tdim; ++i)
+            first = parse_value(first, last, &coords[i]);
+          coordinates[line] = coords;
+        });
+  } catch (std::exception& exception) {
+    console_->error("Read particle coordinates: {}", exception.what());
+    coordinates.clear();
+  }
+
+  return coordinates;
+}
+
+//! Return velocity constraints of nodes
+template <unsigned Tdim>
+std::vector<std::tuple<mpm::Index, unsigned, double>>
+    mpm::ReadMeshAsciiParallel<Tdim>::read_velocity_constraints(
+        const std::string& velocity_constraints_file) {
+  // Velocity constraints
+  std::vector<std::tuple<mpm::Index, unsigned, double>> constraints;
+
+  try {
+    const mpm::MappedFile file(velocity_constraints_file);
+    const auto chunks = this->split_chunks(file);
+    constraints.resize(chunks.nlines);
+
+    this->parse_lines(
+        file, chunks,
+        [&](mpm::Index line, const char* first, const char* last) {
+          // ID
+          mpm::Index id;
+          // Direction
+          mpm::Index dir;
+          // Velocity
+          double velocity;
+          first = parse_value(first, last, &id);
+          first = parse_value(first, last, &dir);
+          parse_value(first, last, &velocity);
+          constraints[line] =
+              std::make_tuple(id, static_cast<unsigned>(dir), velocity);
+        });
+  } catch (std::exception& exception) {
+    console_->error("Read velocity constraints: {}", exception.what());
+    constraints.clear();
+  }
+
+  return constraints;
+}
+
+//! Split a mapped file into line-aligned chunks and count data lines
+template <unsigned Tdim>
+typename mpm::ReadMeshAsciiParallel<Tdim>::Chunks
+    mpm::ReadMeshAsciiParallel<Tdim>::split_chunks(
+        const mpm::MappedFile& file) const {
+  Chunks chunks;
+  const char* data = file.data();
+  const std::size_t size = file.size();
+
+  // Move each chunk boundary to the beginning of the next line
+  chunks.offsets.emplace_back(0);
+  for (std::size_t offset = chunk_size_; offset < size;
+       offset += chunk_size_) {
+    if (offset < chunks.offsets.back()) continue;
+    const auto eol = static_cast<const char*>(
+        std::memchr(data + offset, '\n', size - offset));
+    if (eol == nullptr) break;
+    const std::size_t next = static_cast<std::size_t>(eol - data) + 1;
+    if (next >= size) break;
+    chunks.offsets.emplace_back(next);
+  }
+  chunks.offsets.emplace_back(size);
+
+  // Count data lines in each chunk
+  const std::size_t nchunks = chunks.offsets.size() - 1;
+  chunks.first_lines.resize(nchunks, 0);
+  tbb::parallel_for(std::size_t(0), nchunks, [&](std::size_t chunk) {
+    mpm::Index nlines = 0;
+    for_each_line(data + chunks.offsets[chunk],
+                  data + chunks.offsets[chunk + 1],
+                  [&nlines](const char* first, const char* last) {
+                    if (data_line(first, last)) ++nlines;
+                  });
+    chunks.first_lines[chunk] = nlines;
+  });
+
+  // Exclusive scan of counts gives the first data line of each chunk
+  for (std::size_t chunk = 0; chunk < nchunks; ++chunk) {
+    const mpm::Index nlines = chunks.first_lines[chunk];
+    chunks.first_lines[chunk] = chunks.nlines;
+    chunks.nlines += nlines;
+  }
+  return chunks;
+}
+
+//! Call a function on each data line in parallel
+template <unsigned Tdim>
+template <typename Tparse>
+void mpm::ReadMeshAsciiParallel<Tdim>::parse_lines(const mpm::MappedFile& file,
+                                                   const Chunks& chunks,
+                                                   Tparse parse_line) const {
+  const char* data = file.data();
+  tbb::parallel_for(
+      std::size_t(0), chunks.first_lines.size(), [&](std::size_t chunk) {
+        mpm::Index line = chunks.first_lines[chunk];
+        for_each_line(data + chunks.offsets[chunk],
+                      data + chunks.offsets[chunk + 1],
+                      [&](const char* first, const char* last) {
+                        if (data_line(first, last))
+                          parse_line(line++, first, last);
+                      });
+      });
+}
+
+//! Call a function on each line between first and last
+template <unsigned Tdim>
+template <typename Tfunction>
+void mpm::ReadMeshAsciiParallel<Tdim>::for_each_line(const char* first,
+                                                     const char* last,
+                                                     Tfunction function) {
+  while (first < last) {
+    auto eol =
+        static_cast<const char*>(std::memchr(first, '\n', last - first));
+    if (eol == nullptr) eol = last;
+    function(first, eol);
+    first = eol + 1;
+  }
+}
+
+//! Check if a line holds data
+template <unsigned Tdim>
+bool mpm::ReadMeshAsciiParallel<Tdim>::data_line(const char* first,
+                                                 const char* last) {
+  bool blank = true;
+  for (; first != last; ++first) {
+    // ignore comment lines (# or !)
+    if (*first == '#' || *first == '!') return false;
+    if (!std::isspace(static_cast<unsigned char>(*first))) blank = false;
+  }
+  return !blank;
+}
+
+//! Parse an unsigned integer
+template <unsigned Tdim>
+const char* mpm::ReadMeshAsciiParallel<Tdim>::parse_value(const char* first,
+                                                          const char* last,
+                                                          mpm::Index* value) {
+  first = skip_whitespace(first, last);
+  mpm::Index result = 0;
+  const char* next = first;
+  for (; next != last && *next >= '0' && *next <= '9'; ++next)
+    result = result * 10 + static_cast<mpm::Index>(*next - '0');
+
+  if (next == first)
+    throw std::runtime_error("Invalid integer: " +
+                             std::string(first, std::min(last, first + 32)));
+  *value = result;
+  return next;
+}
+
+//! Parse a floating point number
+//! Numbers with up to 19 significant digits and a small exponent are exact
+//! in double precision arithmetic, other numbers fall back to strtod
+template <unsigned Tdim>
+const char* mpm::ReadMeshAsciiParallel<Tdim>::parse_value(const char* first,
+                                                          const char* last,
+                                                          double* value) {
+  // Exact powers of ten in double precision
+  static const double powers[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                  1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                  1e18, 1e19, 1e20, 1e21, 1e22};
+  const auto digit = [](char c) { return c >= '0' && c <= '9'; };
+
+  first = skip_whitespace(first, last);
+  const char* next = first;
+
+  bool negative = false;
+  if (next != last && (*next == '-' || *next == '+'))
+    negative = (*next++ == '-');
+
+  // Significant digits and decimal exponent
+  unsigned long long mantissa = 0;
+  unsigned ndigits = 0;
+  int exponent = 0;
+  bool digits = false, exact = true;
+  for (; next != last && digit(*next); ++next) {
+    digits = true;
+    if (ndigits < 19) {
+      mantissa = mantissa * 10 + static_cast<unsigned>(*next - '0');
+      if (mantissa != 0) ++ndigits;
+    } else {
+      ++exponent;
+      exact = false;
+    }
+  }
+  if (next != last && *next == '.') {
+    for (++next; next != last && digit(*next); ++next) {
+      digits = true;
+      if (ndigits < 19) {
+        mantissa = mantissa * 10 + static_cast<unsigned>(*next - '0');
+        if (mantissa != 0) ++ndigits;
+        --exponent;
+      } else
+        exact = false;
+    }
+  }
+  if (digits && next != last && (*next == 'e' || *next == 'E')) {
+    const char* exp = next + 1;
+    bool negative_exp = false;
+    if (exp != last && (*exp == '-' || *exp == '+'))
+      negative_exp = (*exp++ == '-');
+    if (exp != last && digit(*exp)) {
+      int exp_value = 0;
+      for (; exp != last && digit(*exp); ++exp)
+        if (exp_value < 100000) exp_value = exp_value * 10 + (*exp - '0');
+      exponent += negative_exp ? -exp_value : exp_value;
+      next = exp;
+    }
+  }
+
+  if (digits && exact && mantissa <= (1ULL << 53) && exponent >= -22 &&
+      exponent <= 22) {
+    double result = static_cast<double>(mantissa);
+    result = (exponent < 0) ? result / powers[-exponent]
+                            : result * powers[exponent];
+    *value = negative ? -result : result;
+    return next;
+  }
+
+  // Fall back to strtod on a null terminated copy of the token
+  const char* token_end = first;
+  while (token_end != last &&
+         !std::isspace(static_cast<unsigned char>(*token_end)))
+    ++token_end;
+  const std::string token(first, token_end);
+  char* end = nullptr;
+  const double result = std::strtod(token.c_str(), &end);
+  if (end == token.c_str())
+    throw std::runtime_error("Invalid number: " + token);
+  *value = result;
+  return first + (end - token.c_str());
+}
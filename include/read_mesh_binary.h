@@ -0,0 +1,76 @@
+#ifndef MPM_READ_MESH_BINARY_H_
+#define MPM_READ_MESH_BINARY_H_
+
+#include <vector>
+
+#include "Eigen/Dense"
+#include "tbb/parallel_for.h"
+
+#include "mapped_file.h"
+#include "mesh_binary_format.h"
+#include "read_mesh.h"
+
+//! MPM namespace
+namespace mpm {
+
+//! Global index type for the cell
+using Index = unsigned long long;
+
+//! ReadMeshBinary class
+//! \brief Derived class that returns mesh and particles locations from
+//! memory-mapped binary files written by mpm::binary (see
+//! mesh_binary_format.h)
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+class ReadMeshBinary : public ReadMesh<Tdim> {
+ public:
+  //! Define a vector of size dimension
+  using VectorDim = Eigen::Matrix<double, Tdim, 1>;
+
+  //! Constructor
+  ReadMeshBinary() : mpm::ReadMesh<Tdim>() {
+    //! Logger
+    console_ = spdlog::get("ReadMeshBinary");
+  }
+
+  //! Destructor
+  ~ReadMeshBinary() override = default;
+
+  //! Read mesh nodes file
+  //! \param[in] mesh file name with nodes and cells
+  //! \retval coordinates Vector of nodal coordinates
+  std::vector<VectorDim> read_mesh_nodes(const std::string& mesh) override;
+
+  //! Read mesh cells file
+  //! \param[in] mesh file name with nodes and cells
+  //! \retval cells Vector of nodal indices of cells
+  std::vector<std::vector<mpm::Index>> read_mesh_cells(
+      const std::string& mesh) override;
+
+  //! Read particles file
+  //! \param[in] particles_files file name with particle coordinates
+  //! \retval coordinates Vector of particle coordinates
+  std::vector<VectorDim> read_particles(
+      const std::string& particles_file) override;
+
+  //! Read constraints file
+  //! \param[in] velocity_constraints_files file name with constraints
+  std::vector<std::tuple<mpm::Index, unsigned, double>>
+      read_velocity_constraints(
+          const std::string& velocity_constraints_file) override;
+
+ private:
+  //! Read coordinates array from a binary file
+  //! \param[in] filename Name of the binary file
+  //! \param[in] array Coordinates array
+  std::vector<VectorDim> read_coordinates(const std::string& filename,
+                                          mpm::binary::Array array);
+
+  //! Logger
+  std::shared_ptr<spdlog::logger> console_;
+};  // ReadMeshBinary class
+}  // namespace mpm
+
+#include "read_mesh_binary.tcc"
+
+#endif  // MPM_READ_MESH_BINARY_H_
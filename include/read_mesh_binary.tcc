@@ -0,0 +1,118 @@
+//! Return coordinates of nodes in a mesh from input file
+template <unsigned Tdim>
+std::vector<Eigen::Matrix<double, Tdim, 1>>
+    mpm::ReadMeshBinary<Tdim>::read_mesh_nodes(const std::string& mesh) {
+  return this->read_coordinates(mesh, mpm::binary::Array::NodeCoordinates);
+}
+
+//! Return indices of nodes of cells in a mesh from input file
+template <unsigned Tdim>
+std::vector<std::vector<mpm::Index>>
+    mpm::ReadMeshBinary<Tdim>::read_mesh_cells(const std::string& mesh) {
+  // Indices of nodes
+  std::vector<std::vector<mpm::Index>> cells;
+
+  try {
+    const mpm::MappedFile file(mesh);
+    const auto info = mpm::binary::find(file, Tdim,
+                                        mpm::binary::Array::CellNodes,
+                                        mpm::binary::Type::UInt64);
+    if (info == nullptr)
+      throw std::runtime_error("Cell nodes are not present in " + mesh);
+
+    const auto nodes =
+        reinterpret_cast<const std::uint64_t*>(file.data() + info->offset);
+    const std::size_t nnodes = info->cols;
+    cells.resize(info->rows);
+    tbb::parallel_for(std::size_t(0), cells.size(), [&](std::size_t i) {
+      cells[i].assign(nodes + i * nnodes, nodes + (i + 1) * nnodes);
+    });
+  } catch (std::exception& exception) {
+    console_->error("Read mesh cells: {}", exception.what());
+    cells.clear();
+  }
+
+  return cells;
+}
+
+//! Return coordinates of particles
+template <unsigned Tdim>
+std::vector<Eigen::Matrix<double, Tdim, 1>>
+    mpm::ReadMeshBinary<Tdim>::read_particles(
+        const std::string& particles_file) {
+  return this->read_coordinates(particles_file,
+                                mpm::binary::Array::ParticleCoordinates);
+}
+
+//! Return velocity constraints of nodes
+template <unsigned Tdim>
+std::vector<std::tuple<mpm::Index, unsigned, double>>
+    mpm::ReadMeshBinary<Tdim>::read_velocity_constraints(
+        const std::string& velocity_constraints_file) {
+  // Velocity constraints
+  std::vector<std::tuple<mpm::Index, unsigned, double>> constraints;
+
+  try {
+    const mpm::MappedFile file(velocity_constraints_file);
+    const auto nodes = mpm::binary::find(file, Tdim,
+                                         mpm::binary::Array::ConstraintNodes,
+                                         mpm::binary::Type::UInt64);
+    const auto directions = mpm::binary::find(
+        file, Tdim, mpm::binary::Array::ConstraintDirections,
+        mpm::binary::Type::UInt32);
+    const auto velocities = mpm::binary::find(
+        file, Tdim, mpm::binary::Array::ConstraintVelocities,
+        mpm::binary::Type::Float64);
+    if (nodes == nullptr || directions == nullptr || velocities == nullptr ||
+        nodes->rows != directions->rows || nodes->rows != velocities->rows)
+      throw std::runtime_error("Velocity constraints are not present in " +
+                               velocity_constraints_file);
+
+    const auto node_ids =
+        reinterpret_cast<const std::uint64_t*>(file.data() + nodes->offset);
+    const auto dirs = reinterpret_cast<const std::uint32_t*>(
+        file.data() + directions->offset);
+    const auto values =
+        reinterpret_cast<const double*>(file.data() + velocities->offset);
+    constraints.resize(nodes->rows);
+    tbb::parallel_for(std::size_t(0), constraints.size(), [&](std::size_t i) {
+      constraints[i] = std::make_tuple(node_ids[i], dirs[i], values[i]);
+    });
+  } catch (std::exception& exception) {
+    console_->error("Read velocity constraints: {}", exception.what());
+    constraints.clear();
+  }
+
+  return constraints;
+}
+
+//! Return coordinates array from a binary file
+template <unsigned Tdim>
+std::vector<Eigen::Matrix<double, Tdim, 1>>
+    mpm::ReadMeshBinary<Tdim>::read_coordinates(const std::string& filename,
+                                                mpm::binary::Array array) {
+  // Coordinates
+  std::vector<VectorDim> coordinates;
+
+  try {
+    const mpm::MappedFile file(filename);
+    const auto info =
+        mpm::binary::find(file, Tdim, array, mpm::binary::Type::Float64);
+    if (info == nullptr || info->cols != Tdim)
+      throw std::runtime_error("Coordinates are not present in " + filename);
+
+    // Coordinates are contiguous rows of Tdim values in the mapped file
+    const Eigen::Map<const Eigen::Matrix<double, Tdim, Eigen::Dynamic>> values(
+        reinterpret_cast<const double*>(file.data() + info->offset), Tdim,
+        info->rows);
+    coordinates.resize(info->rows);
+    tbb::parallel_for(std::size_t(0), coordinates.size(), [&](std::size_t i) {
+      coordinates[i] = values.col(i);
+    });
+  } catch (std::exception& exception) {
+    console_->error("Read coordinates: {}", exception.what());
+    coordinates.clear();
+  }
+
+  return coordinates;
+}
@@ -14,9 +14,21 @@
 #include <vtkXMLPolyDataWriter.h>
 #include <vtkZLibDataCompressor.h>
 
+#include <stdexcept>
 #include <string>
 #include <vector>
 
+//! VTK point data array
+//! \brief A named point data array wrapping a contiguous buffer
+struct VtkPointArray {
+  //! Name of the array
+  std::string name;
+  //! Number of components of a point
+  unsigned ncomponents;
+  //! Values of the points, ncomponents per point, the buffer is not copied
+  double* values;
+};
+
 //! VTK Writer class
 //! \brief VTK writer class
 class VtkWriter {
@@ -24,6 +36,13 @@ class VtkWriter {
   // Constructor with coordinates
   VtkWriter(const std::vector<Eigen::Matrix<double, 3, 1>>& coordinates);
 
+  //! Constructor with a contiguous buffer of coordinates
+  //! \details The buffer is wrapped without a copy and has to remain valid
+  //! while the writer is used
+  //! \param[in] coordinates Point coordinates, 3 values per point
+  //! \param[in] npoints Number of points
+  VtkWriter(double* coordinates, vtkIdType npoints);
+
   //! Write coordinates
   void write_geometry(const std::string& filename);
 
@@ -32,9 +51,31 @@ class VtkWriter {
                                const std::vector<Eigen::Vector3d>& data,
                                const std::string& data_fields);
 
+  //! Write points and point data arrays to a single file
+  //! \details Arrays wrap their buffers without a copy
+  //! \param[in] filename Output file
+  //! \param[in] arrays Point data arrays
+  void write_point_data(const std::string& filename,
+                        const std::vector<VtkPointArray>& arrays);
+
+  //! Write points and point data arrays as pieces written concurrently
+  //! \details Each piece holds a contiguous range of points and is written
+  //! to <stem>_<piece>.vtp next to the .pvtp file which references the
+  //! pieces. The writer has to be constructed with a contiguous buffer.
+  //! \param[in] filename Output .pvtp file
+  //! \param[in] arrays Point data arrays
+  //! \param[in] npieces Number of pieces
+  void write_parallel_point_data(const std::string& filename,
+                                 const std::vector<VtkPointArray>& arrays,
+                                 unsigned npieces);
+
  private:
   //! Vector of nodal coordinates
   vtkSmartPointer<vtkPoints> points_;
+  //! Contiguous buffer of coordinates, 3 values per point
+  double* coordinates_{nullptr};
+  //! Number of points in the buffer of coordinates
+  vtkIdType npoints_{0};
 };
 
 #endif  // VTK_WRITER_H_
@@ -0,0 +1,95 @@
+#include "allocation_tracker.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+
+#if defined(MPM_ALLOCATION_TRACKING) && defined(__GLIBC__)
+#define MPM_TRACK_ALLOCATIONS
+#endif
+
+namespace {
+//! Number of allocations
+std::atomic<unsigned long long> ncalls{0};
+//! Requested bytes
+std::atomic<unsigned long long> nbytes{0};
+//! Depth of untracked scopes of a thread, initial-exec TLS is read without
+//! calling into the allocator
+__attribute__((tls_model("initial-exec"))) thread_local unsigned untracked{
+    0};
+
+//! Count an allocation of a number of bytes of a tracked thread
+inline void count(std::size_t size) {
+  if (untracked == 0) {
+    ncalls.fetch_add(1, std::memory_order_relaxed);
+    nbytes.fetch_add(size, std::memory_order_relaxed);
+  }
+}
+}  // namespace
+
+#ifdef MPM_TRACK_ALLOCATIONS
+// Allocation functions of glibc. The replacements are found before those of
+// glibc by all objects of the process, operator new calls malloc.
+extern "C" {
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t n, std::size_t size);
+void* __libc_realloc(void* ptr, std::size_t size);
+void* __libc_memalign(std::size_t alignment, std::size_t size);
+
+void* malloc(std::size_t size) {
+  count(size);
+  return __libc_malloc(size);
+}
+
+void* calloc(std::size_t n, std::size_t size) {
+  count(n * size);
+  return __libc_calloc(n, size);
+}
+
+void* realloc(void* ptr, std::size_t size) {
+  count(size);
+  return __libc_realloc(ptr, size);
+}
+
+void* memalign(std::size_t alignment, std::size_t size) {
+  count(size);
+  return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(std::size_t alignment, std::size_t size) {
+  count(size);
+  return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** ptr, std::size_t alignment, std::size_t size) {
+  count(size);
+  void* memory = __libc_memalign(alignment, size);
+  if (memory == nullptr) return ENOMEM;
+  *ptr = memory;
+  return 0;
+}
+}
+#endif
+
+//! Return if heap allocations are tracked
+bool mpm::allocation_tracking() {
+#ifdef MPM_TRACK_ALLOCATIONS
+  return true;
+#else
+  return false;
+#endif
+}
+
+//! Return heap allocations of all tracked threads
+mpm::Allocations mpm::heap_allocations() {
+  Allocations allocations;
+  allocations.calls = ncalls.load(std::memory_order_relaxed);
+  allocations.bytes = nbytes.load(std::memory_order_relaxed);
+  return allocations;
+}
+
+//! Constructor stops counting allocations of the calling thread
+mpm::UntrackedAllocations::UntrackedAllocations() { ++untracked; }
+
+//! Destructor resumes counting
+mpm::UntrackedAllocations::~UntrackedAllocations() { --untracked; }
@@ -0,0 +1,70 @@
+#include "async_writer.h"
+
+#include <algorithm>
+#include <exception>
+
+#include "allocation_tracker.h"
+
+//! Constructor starts the writer thread
+mpm::AsyncWriter::AsyncWriter(unsigned queue_size)
+    : queue_size_{std::max(queue_size, 1u)} {
+  thread_ = std::thread(&AsyncWriter::run, this);
+}
+
+//! Destructor completes pending tasks and stops the writer thread
+mpm::AsyncWriter::~AsyncWriter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  task_added_.notify_one();
+  thread_.join();
+}
+
+//! Add a task to the queue, blocks while the queue is full
+void mpm::AsyncWriter::submit(std::function<void()> task) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  task_done_.wait(lock, [this] { return tasks_.size() < queue_size_; });
+  tasks_.emplace_back(std::move(task));
+  ++pending_;
+  lock.unlock();
+  task_added_.notify_one();
+}
+
+//! Wait for all submitted tasks to complete
+bool mpm::AsyncWriter::wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  task_done_.wait(lock, [this] { return pending_ == 0; });
+  const bool status = (failed_ == 0);
+  failed_ = 0;
+  return status;
+}
+
+//! Run tasks until stopped
+void mpm::AsyncWriter::run() {
+  // Output is not a heap allocation of the stages running meanwhile
+  UntrackedAllocations untracked;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    task_added_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+    // Queued tasks are completed before stopping
+    if (tasks_.empty()) break;
+
+    auto task = std::move(tasks_.front());
+    tasks_.pop_front();
+    lock.unlock();
+    task_done_.notify_all();
+
+    bool failed = false;
+    try {
+      task();
+    } catch (...) {
+      failed = true;
+    }
+
+    lock.lock();
+    --pending_;
+    if (failed) ++failed_;
+    task_done_.notify_all();
+  }
+}
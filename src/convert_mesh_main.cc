@@ -0,0 +1,85 @@
+#include <memory>
+#include <string>
+
+#include "spdlog/spdlog.h"
+#include "tclap/CmdLine.h"
+
+#include "mesh_binary_format.h"
+#include "read_mesh_ascii_parallel.h"
+
+//! Convert an ascii mesh, particles or velocity constraints file to binary
+//! \param[in] type File type (mesh, particles or velocity_constraints)
+//! \param[in] input Ascii input file
+//! \param[in] output Binary output file
+template <unsigned Tdim>
+void convert(const std::string& type, const std::string& input,
+             const std::string& output) {
+  auto reader = std::make_unique<mpm::ReadMeshAsciiParallel<Tdim>>();
+  if (type == "mesh") {
+    const auto mesh = reader->read_mesh(input);
+    if (mesh.first.empty()) throw std::runtime_error("No nodes in " + input);
+    if (mesh.second.empty()) throw std::runtime_error("No cells in " + input);
+    mpm::binary::write_mesh<Tdim>(output, mesh.first, mesh.second);
+  } else if (type == "particles") {
+    const auto particles = reader->read_particles(input);
+    if (particles.empty())
+      throw std::runtime_error("No particles in " + input);
+    mpm::binary::write_particles<Tdim>(output, particles);
+  } else if (type == "velocity_constraints") {
+    const auto constraints = reader->read_velocity_constraints(input);
+    if (constraints.empty())
+      throw std::runtime_error("No velocity constraints in " + input);
+    mpm::binary::write_velocity_constraints<Tdim>(output, constraints);
+  } else
+    throw std::runtime_error("Invalid file type: " + type);
+}
+
+int main(int argc, char** argv) {
+  // Initialise logger
+  auto console = spdlog::stdout_color_mt("main");
+
+  try {
+    TCLAP::CmdLine cmd("Convert ascii mesh input to binary (CB-Geo)", ' ',
+                       "Alpha V1.0");
+
+    // Dimension
+    TCLAP::ValueArg<unsigned> dim_arg("d", "dimension", "Dimension (2 or 3)",
+                                      true, 3, "dimension");
+    cmd.add(dim_arg);
+
+    // Type of file
+    TCLAP::ValueArg<std::string> type_arg(
+        "t", "type", "File type: mesh, particles or velocity_constraints",
+        true, "mesh", "type");
+    cmd.add(type_arg);
+
+    // Input file
+    TCLAP::ValueArg<std::string> input_arg("i", "input", "Ascii input file",
+                                           true, "", "input");
+    cmd.add(input_arg);
+
+    // Output file
+    TCLAP::ValueArg<std::string> output_arg("o", "output", "Binary output file",
+                                            true, "", "output");
+    cmd.add(output_arg);
+
+    cmd.parse(argc, argv);
+
+    if (dim_arg.getValue() == 2)
+      convert<2>(type_arg.getValue(), input_arg.getValue(),
+                 output_arg.getValue());
+    else if (dim_arg.getValue() == 3)
+      convert<3>(type_arg.getValue(), input_arg.getValue(),
+                 output_arg.getValue());
+    else
+      throw std::runtime_error("Dimension should be 2 or 3");
+
+  } catch (TCLAP::ArgException& except) {
+    console->error("error: {}  for arg {}", except.error(), except.argId());
+    return 1;
+  } catch (std::exception& exception) {
+    console->error("Convert mesh: {}", exception.what());
+    return 1;
+  }
+  return 0;
+}
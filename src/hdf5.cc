@@ -0,0 +1,700 @@
+#include "hdf5.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+#include <tbb/parallel_for.h>
+#include <zlib.h>
+
+//! Lock serialising HDF5 calls when the library is not thread-safe
+std::unique_lock<std::mutex> mpm::hdf5_lock() {
+  static std::mutex mutex;
+  static const bool threadsafe = [] {
+    hbool_t is_threadsafe = false;
+    H5is_library_threadsafe(&is_threadsafe);
+    return static_cast<bool>(is_threadsafe);
+  }();
+  if (threadsafe) return std::unique_lock<std::mutex>(mutex, std::defer_lock);
+  return std::unique_lock<std::mutex>(mutex);
+}
+
+//! Compress a chunk as the shuffle and deflate filters of HDF5 do
+//! \param[in] data Values of the chunk, padded to the chunk size
+//! \param[in] size Size of a value in bytes
+//! \param[in] shuffle Shuffle the bytes of the values before compressing
+//! \param[in] level Deflate compression level
+//! \param[out] shuffled Buffer of the shuffled chunk
+//! \param[out] compressed Compressed chunk
+static void compress_chunk(const std::vector<unsigned char>& data,
+                           std::size_t size, bool shuffle, int level,
+                           std::vector<unsigned char>* shuffled,
+                           std::vector<unsigned char>* compressed) {
+  // Byte i of each value is stored in the i-th block of the chunk
+  const std::vector<unsigned char>* input = &data;
+  if (shuffle && size > 1) {
+    const std::size_t nvalues = data.size() / size;
+    shuffled->resize(data.size());
+    for (std::size_t i = 0; i < nvalues; ++i)
+      for (std::size_t j = 0; j < size; ++j)
+        (*shuffled)[j * nvalues + i] = data[i * size + j];
+    input = shuffled;
+  }
+
+  uLongf length = compressBound(input->size());
+  compressed->resize(length);
+  if (compress2(compressed->data(), &length, input->data(), input->size(),
+                level) != Z_OK)
+    throw std::runtime_error("Compressing HDF5 chunk failed");
+  compressed->resize(length);
+}
+
+//! Write a chunked two-dimensional dataset of nrows x ncols
+bool mpm::write_hdf5_dataset(hid_t location, const std::string& name,
+                             hid_t type, const void* data, hsize_t nrows,
+                             hsize_t ncols, const HDF5Options& options) {
+  const hsize_t dims[2] = {nrows, ncols};
+  const hsize_t max_dims[2] = {H5S_UNLIMITED, ncols};
+  // Chunks must be non-empty, an extensible dataset allows them to exceed the
+  // current number of rows
+  const hsize_t chunk[2] = {std::max<hsize_t>(options.chunk_size, 1), ncols};
+
+  // HDF5 calls are serialised unless the library is thread-safe, chunks are
+  // compressed without the lock so concurrent writers compress in parallel
+  hid_t dataset;
+  herr_t status = -1;
+  bool compress = false;
+  std::size_t size = 0;
+  {
+    auto lock = mpm::hdf5_lock();
+    hid_t dcpl = H5Pcreate(H5P_DATASET_CREATE);
+    H5Pset_chunk(dcpl, 2, chunk);
+    if (options.compression > 0 && H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0) {
+      if (options.shuffle) H5Pset_shuffle(dcpl);
+      H5Pset_deflate(dcpl, std::min(options.compression, 9u));
+      compress = true;
+    }
+    hid_t space = H5Screate_simple(2, dims, max_dims);
+    dataset = H5Dcreate2(location, name.c_str(), type, space, H5P_DEFAULT,
+                         dcpl, H5P_DEFAULT);
+    size = H5Tget_size(type);
+    if (dataset >= 0 && (!compress || nrows == 0))
+      status = (nrows > 0) ? H5Dwrite(dataset, type, H5S_ALL, H5S_ALL,
+                                      H5P_DEFAULT, data)
+                           : 0;
+    H5Sclose(space);
+    H5Pclose(dcpl);
+  }
+
+  // Compressed chunks are written directly, filters of the dataset decode
+  // them when read
+  if (dataset >= 0 && compress && nrows > 0) {
+    const std::size_t row_bytes = ncols * size;
+    const int level = static_cast<int>(std::min(options.compression, 9u));
+    std::vector<unsigned char> raw(chunk[0] * row_bytes), shuffled,
+        compressed;
+    status = 0;
+    try {
+      for (hsize_t first = 0; first < nrows && status >= 0;
+           first += chunk[0]) {
+        // The last chunk is padded to the full chunk size
+        const hsize_t rows = std::min(chunk[0], nrows - first);
+        const auto begin =
+            static_cast<const unsigned char*>(data) + first * row_bytes;
+        std::copy(begin, begin + rows * row_bytes, raw.begin());
+        std::fill(raw.begin() + rows * row_bytes, raw.end(), 0);
+        compress_chunk(raw, size, options.shuffle, level, &shuffled,
+                       &compressed);
+
+        const hsize_t offset[2] = {first, 0};
+        auto lock = mpm::hdf5_lock();
+        status = H5Dwrite_chunk(dataset, H5P_DEFAULT, 0, offset,
+                                compressed.size(), compressed.data());
+      }
+    } catch (...) {
+      auto lock = mpm::hdf5_lock();
+      H5Dclose(dataset);
+      throw;
+    }
+  }
+
+  if (dataset >= 0) {
+    auto lock = mpm::hdf5_lock();
+    H5Dclose(dataset);
+  }
+
+  if (status < 0)
+    throw std::runtime_error("Writing HDF5 dataset " + name + " failed");
+  return true;
+}
+
+//! Write a virtual dataset concatenating the rows of a dataset in source files
+bool mpm::write_hdf5_virtual_dataset(hid_t location, const std::string& name,
+                                     hid_t type, hsize_t ncols,
+                                     const std::vector<std::string>& files,
+                                     const std::vector<hsize_t>& rows) {
+  const hsize_t nrows = std::accumulate(rows.begin(), rows.end(), hsize_t(0));
+  const hsize_t dims[2] = {nrows, ncols};
+  hid_t space = H5Screate_simple(2, dims, nullptr);
+  hid_t dcpl = H5Pcreate(H5P_DATASET_CREATE);
+
+  // Map the source datasets to consecutive blocks of rows
+  hsize_t offset = 0;
+  for (std::size_t i = 0; i < files.size(); ++i) {
+    if (rows[i] == 0) continue;
+    const hsize_t start[2] = {offset, 0};
+    const hsize_t count[2] = {rows[i], ncols};
+    hid_t source_space = H5Screate_simple(2, count, nullptr);
+    H5Sselect_hyperslab(space, H5S_SELECT_SET, start, nullptr, count, nullptr);
+    H5Pset_virtual(dcpl, space, files[i].c_str(), name.c_str(), source_space);
+    H5Sclose(source_space);
+    offset += rows[i];
+  }
+  H5Sselect_all(space);
+
+  hid_t dataset = H5Dcreate2(location, name.c_str(), type, space, H5P_DEFAULT,
+                             dcpl, H5P_DEFAULT);
+  if (dataset >= 0) H5Dclose(dataset);
+  H5Sclose(space);
+  H5Pclose(dcpl);
+
+  if (dataset < 0)
+    throw std::runtime_error("Writing HDF5 virtual dataset " + name +
+                             " failed");
+  return true;
+}
+
+//! Number of rows and columns of a dataset
+std::pair<hsize_t, hsize_t> mpm::hdf5_dataset_dims(hid_t location,
+                                                   const std::string& name) {
+  hid_t dataset = H5Dopen2(location, name.c_str(), H5P_DEFAULT);
+  if (dataset < 0)
+    throw std::runtime_error("HDF5 dataset " + name + " is not found");
+
+  hid_t space = H5Dget_space(dataset);
+  const int rank = H5Sget_simple_extent_ndims(space);
+  hsize_t dims[2] = {0, 1};
+  if (rank == 1 || rank == 2) H5Sget_simple_extent_dims(space, dims, nullptr);
+  H5Sclose(space);
+  H5Dclose(dataset);
+
+  if (rank != 1 && rank != 2)
+    throw std::runtime_error("HDF5 dataset " + name + " has invalid rank");
+  return std::make_pair(dims[0], dims[1]);
+}
+
+//! Read a dataset into a row-major buffer
+bool mpm::read_hdf5_dataset(hid_t location, const std::string& name,
+                            hid_t type, void* data) {
+  hid_t dataset = H5Dopen2(location, name.c_str(), H5P_DEFAULT);
+  if (dataset < 0)
+    throw std::runtime_error("HDF5 dataset " + name + " is not found");
+
+  hid_t space = H5Dget_space(dataset);
+  const hssize_t npoints = H5Sget_simple_extent_npoints(space);
+  H5Sclose(space);
+
+  const herr_t status =
+      (npoints > 0)
+          ? H5Dread(dataset, type, H5S_ALL, H5S_ALL, H5P_DEFAULT, data)
+          : 0;
+  H5Dclose(dataset);
+
+  if (status < 0)
+    throw std::runtime_error("Reading HDF5 dataset " + name + " failed");
+  return true;
+}
+
+//! Return the field of a dataset name
+unsigned mpm::hdf5_field(const std::string& name) {
+  static const std::map<std::string, unsigned> fields = {
+      {"mass", HDF5Field::Mass},
+      {"coordinates", HDF5Field::Coordinates},
+      {"velocity", HDF5Field::Velocity},
+      {"stress", HDF5Field::Stress},
+      {"strain", HDF5Field::Strain},
+      {"volumetric_strain", HDF5Field::VolumetricStrain},
+      {"status", HDF5Field::Status}};
+  const auto itr = fields.find(name);
+  if (itr == fields.end())
+    throw std::runtime_error("Invalid particle output field: " + name);
+  return itr->second;
+}
+
+//! Check if a particle is selected
+bool mpm::HDF5Selection::selects(mpm::Index id, const double* coordinates,
+                                 unsigned dim) const {
+  if (stride > 1 && id % stride != 0) return false;
+  if (!ids.empty() && !std::binary_search(ids.begin(), ids.end(), id))
+    return false;
+  if (regions.empty()) return true;
+  for (const auto& region : regions) {
+    bool inside = true;
+    for (unsigned i = 0; i < dim && inside; ++i)
+      inside = (coordinates[i] >= region.first[i] &&
+                coordinates[i] <= region.second[i]);
+    if (inside) return true;
+  }
+  return false;
+}
+
+//! Resize the fields of particles
+void mpm::HDF5ParticleColumns::resize(unsigned dimension, hsize_t nparticles,
+                                      unsigned selected_fields) {
+  fields = selected_fields;
+  dim = dimension;
+  // Fields not selected are emptied and keep their capacity
+  const auto size = [this](unsigned field, hsize_t n) {
+    return (fields & field) ? n : 0;
+  };
+  ids.resize(nparticles);
+  masses.resize(size(HDF5Field::Mass, nparticles));
+  coordinates.resize(size(HDF5Field::Coordinates, nparticles * dim));
+  velocities.resize(size(HDF5Field::Velocity, nparticles * dim));
+  stresses.resize(size(HDF5Field::Stress, nparticles * 6));
+  strains.resize(size(HDF5Field::Strain, nparticles * 6));
+  volumetric_strains.resize(
+      size(HDF5Field::VolumetricStrain, nparticles));
+  statuses.resize(size(HDF5Field::Status, nparticles));
+}
+
+//! Return the particle record of a row
+mpm::HDF5Particle mpm::HDF5ParticleColumns::particle(hsize_t i) const {
+  HDF5Particle particle;
+  particle.id = ids[i];
+  particle.mass = masses[i];
+
+  double coords[3] = {0., 0., 0.};
+  double velocity[3] = {0., 0., 0.};
+  for (unsigned j = 0; j < dim; ++j) {
+    coords[j] = coordinates[i * dim + j];
+    velocity[j] = velocities[i * dim + j];
+  }
+  particle.coord_x = coords[0];
+  particle.coord_y = coords[1];
+  particle.coord_z = coords[2];
+  particle.velocity_x = velocity[0];
+  particle.velocity_y = velocity[1];
+  particle.velocity_z = velocity[2];
+
+  const double* stress = &stresses[i * 6];
+  particle.stress_xx = stress[0];
+  particle.stress_yy = stress[1];
+  particle.stress_zz = stress[2];
+  particle.tau_xy = stress[3];
+  particle.tau_yz = stress[4];
+  particle.tau_xz = stress[5];
+
+  const double* strain = &strains[i * 6];
+  particle.strain_xx = strain[0];
+  particle.strain_yy = strain[1];
+  particle.strain_zz = strain[2];
+  particle.gamma_xy = strain[3];
+  particle.gamma_yz = strain[4];
+  particle.gamma_xz = strain[5];
+
+  particle.epsilon_v = volumetric_strains[i];
+  particle.status = statuses[i];
+  return particle;
+}
+
+//! Assign the particle record of a row
+void mpm::HDF5ParticleColumns::set_particle(hsize_t i,
+                                            const HDF5Particle& particle) {
+  ids[i] = particle.id;
+  masses[i] = particle.mass;
+
+  const double coords[3] = {particle.coord_x, particle.coord_y,
+                            particle.coord_z};
+  const double velocity[3] = {particle.velocity_x, particle.velocity_y,
+                              particle.velocity_z};
+  for (unsigned j = 0; j < dim; ++j) {
+    coordinates[i * dim + j] = coords[j];
+    velocities[i * dim + j] = velocity[j];
+  }
+
+  double* stress = &stresses[i * 6];
+  stress[0] = particle.stress_xx;
+  stress[1] = particle.stress_yy;
+  stress[2] = particle.stress_zz;
+  stress[3] = particle.tau_xy;
+  stress[4] = particle.tau_yz;
+  stress[5] = particle.tau_xz;
+
+  double* strain = &strains[i * 6];
+  strain[0] = particle.strain_xx;
+  strain[1] = particle.strain_yy;
+  strain[2] = particle.strain_zz;
+  strain[3] = particle.gamma_xy;
+  strain[4] = particle.gamma_yz;
+  strain[5] = particle.gamma_xz;
+
+  volumetric_strains[i] = particle.epsilon_v;
+  statuses[i] = particle.status;
+}
+
+//! Dataset of a particle field
+//! \tparam Tdata Type of the data, const void when only written
+template <typename Tdata>
+struct FieldDataset {
+  //! Dataset name
+  const char* name;
+  //! Field, 0 for ids which are always present
+  unsigned field;
+  //! HDF5 native type
+  hid_t type;
+  //! Number of columns
+  hsize_t ncols;
+  //! Size of a value in bytes
+  std::size_t size;
+  //! Row-major data
+  Tdata* data;
+};
+
+//! Return the datasets of the particle fields present in the buffer
+//! \tparam Tdata Type of the data, const void for a const buffer
+//! \tparam Tcolumns Type of the buffer of particle fields
+template <typename Tdata, typename Tcolumns>
+static std::vector<FieldDataset<Tdata>> make_field_datasets(
+    Tcolumns& columns) {
+  using mpm::HDF5Field;
+  const hsize_t dim = columns.dim;
+  std::vector<FieldDataset<Tdata>> datasets = {
+      {"id", 0, H5T_NATIVE_ULLONG, 1, sizeof(mpm::Index), columns.ids.data()},
+      {"mass", HDF5Field::Mass, H5T_NATIVE_DOUBLE, 1, sizeof(double),
+       columns.masses.data()},
+      {"coordinates", HDF5Field::Coordinates, H5T_NATIVE_DOUBLE, dim,
+       sizeof(double), columns.coordinates.data()},
+      {"velocity", HDF5Field::Velocity, H5T_NATIVE_DOUBLE, dim, sizeof(double),
+       columns.velocities.data()},
+      {"stress", HDF5Field::Stress, H5T_NATIVE_DOUBLE, 6, sizeof(double),
+       columns.stresses.data()},
+      {"strain", HDF5Field::Strain, H5T_NATIVE_DOUBLE, 6, sizeof(double),
+       columns.strains.data()},
+      {"volumetric_strain", HDF5Field::VolumetricStrain, H5T_NATIVE_DOUBLE, 1,
+       sizeof(double), columns.volumetric_strains.data()},
+      {"status", HDF5Field::Status, H5T_NATIVE_UINT8, 1, sizeof(std::uint8_t),
+       columns.statuses.data()}};
+  datasets.erase(std::remove_if(datasets.begin(), datasets.end(),
+                                [&columns](const FieldDataset<Tdata>& dataset) {
+                                  return dataset.field != 0 &&
+                                         !(columns.fields & dataset.field);
+                                }),
+                 datasets.end());
+  return datasets;
+}
+
+//! Return the datasets of the particle fields to be read into the buffer
+static std::vector<FieldDataset<void>> field_datasets(
+    mpm::HDF5ParticleColumns& columns) {
+  return make_field_datasets<void>(columns);
+}
+
+//! Return the datasets of the particle fields to be written from the buffer
+static std::vector<FieldDataset<const void>> field_datasets(
+    const mpm::HDF5ParticleColumns& columns) {
+  return make_field_datasets<const void>(columns);
+}
+
+//! Number of fields of a particle table
+static const hsize_t particle_table_nfields = 22;
+
+//! Offsets of the fields of a particle table record in memory
+static const size_t* particle_table_offsets() {
+  using mpm::HDF5Particle;
+  static const size_t offsets[particle_table_nfields] = {
+      HOFFSET(HDF5Particle, id),         HOFFSET(HDF5Particle, mass),
+      HOFFSET(HDF5Particle, coord_x),    HOFFSET(HDF5Particle, coord_y),
+      HOFFSET(HDF5Particle, coord_z),    HOFFSET(HDF5Particle, velocity_x),
+      HOFFSET(HDF5Particle, velocity_y), HOFFSET(HDF5Particle, velocity_z),
+      HOFFSET(HDF5Particle, stress_xx),  HOFFSET(HDF5Particle, stress_yy),
+      HOFFSET(HDF5Particle, stress_zz),  HOFFSET(HDF5Particle, tau_xy),
+      HOFFSET(HDF5Particle, tau_yz),     HOFFSET(HDF5Particle, tau_xz),
+      HOFFSET(HDF5Particle, strain_xx),  HOFFSET(HDF5Particle, strain_yy),
+      HOFFSET(HDF5Particle, strain_zz),  HOFFSET(HDF5Particle, gamma_xy),
+      HOFFSET(HDF5Particle, gamma_yz),   HOFFSET(HDF5Particle, gamma_xz),
+      HOFFSET(HDF5Particle, epsilon_v),  HOFFSET(HDF5Particle, status),
+  };
+  return offsets;
+}
+
+//! Write particle fields as a single HDF5 table
+static bool write_hdf5_particle_table(const std::string& filename,
+                                      const mpm::HDF5ParticleColumns& columns,
+                                      const mpm::HDF5Options& options) {
+  using mpm::HDF5Particle;
+
+  std::vector<HDF5Particle> particle_data(columns.size());
+  for (hsize_t i = 0; i < columns.size(); ++i)
+    particle_data[i] = columns.particle(i);
+
+  // Calculate the size and the offsets of our struct members in memory
+  const hsize_t NRECORDS = columns.size();
+
+  const hsize_t NFIELDS = particle_table_nfields;
+
+  size_t dst_size = sizeof(HDF5Particle);
+  const size_t* dst_offset = particle_table_offsets();
+
+  // Define particle field information
+  const char* field_names[NFIELDS] = {
+      "id",         "mass",       "coord_x",    "coord_y",   "coord_z",
+      "velocity_x", "velocity_y", "velocity_z", "stress_xx", "stress_yy",
+      "stress_zz",  "tau_xy",     "tau_yz",     "tau_xz",    "strain_xx",
+      "strain_yy",  "strain_zz",  "gamma_xy",   "gamma_yz",  "gamma_xz",
+      "epsilon_v",  "status"};
+
+  hid_t field_type[NFIELDS];
+  hsize_t chunk_size = std::max<hsize_t>(options.chunk_size, 1);
+  int* fill_data = NULL;
+  int compress = (options.compression > 0) ? 1 : 0;
+
+  // Initialize the field_type
+  field_type[0] = H5T_NATIVE_LLONG;
+  for (unsigned i = 1; i < NFIELDS - 1; ++i) field_type[i] = H5T_NATIVE_DOUBLE;
+  field_type[NFIELDS - 1] = H5T_NATIVE_HBOOL;
+
+  auto lock = mpm::hdf5_lock();
+  // Create a new file using default properties.
+  hid_t file_id =
+      H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+  if (file_id < 0)
+    throw std::runtime_error("Creating HDF5 file " + filename + " failed");
+
+  // make a table
+  const herr_t status = H5TBmake_table(
+      "Table Title", file_id, "table", NFIELDS, NRECORDS, dst_size, field_names,
+      dst_offset, field_type, chunk_size, fill_data, compress,
+      particle_data.data());
+
+  H5Fclose(file_id);
+  if (status < 0)
+    throw std::runtime_error("Writing HDF5 table " + filename + " failed");
+  return true;
+}
+
+//! Write partitions of particle fields to separate files concurrently and a
+//! master file with virtual datasets presenting them as one set of columns
+static bool write_hdf5_particle_partitions(
+    const std::string& filename, const mpm::HDF5ParticleColumns& columns,
+    const mpm::HDF5Options& options) {
+  const hsize_t nparticles = columns.size();
+  const unsigned npartitions = std::max(options.partitions, 1u);
+
+  // Partition files <stem>.p<partition><extension> next to the master file
+  const auto separator = filename.find_last_of('/');
+  const std::size_t base = (separator == std::string::npos) ? 0 : separator + 1;
+  std::size_t extension = filename.find_last_of('.');
+  if (extension == std::string::npos || extension < base)
+    extension = filename.size();
+  std::vector<std::string> files(npartitions);
+  std::vector<hsize_t> rows(npartitions);
+  for (unsigned i = 0; i < npartitions; ++i) {
+    files[i] = filename.substr(base, extension - base) + ".p" +
+               std::to_string(i) + filename.substr(extension);
+    rows[i] = (i + 1) * nparticles / npartitions - i * nparticles / npartitions;
+  }
+
+  // Writer threads take partitions in turn
+  unsigned nwriters = (options.writers > 0)
+                          ? options.writers
+                          : std::thread::hardware_concurrency();
+  nwriters = std::max(1u, std::min(nwriters, npartitions));
+  std::atomic<unsigned> next_partition{0};
+  std::atomic<bool> failed{false};
+  const auto writer = [&]() {
+    for (unsigned i = next_partition++; i < npartitions;
+         i = next_partition++) {
+      const hsize_t first = i * nparticles / npartitions;
+      const hsize_t last = (i + 1) * nparticles / npartitions;
+      const std::string file = filename.substr(0, base) + files[i];
+
+      hid_t file_id;
+      {
+        auto lock = mpm::hdf5_lock();
+        file_id =
+            H5Fcreate(file.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+      }
+      if (file_id < 0) {
+        failed = true;
+        continue;
+      }
+      try {
+        mpm::write_hdf5_particle_columns(file_id, columns, options, first,
+                                         last);
+      } catch (...) {
+        failed = true;
+      }
+      auto lock = mpm::hdf5_lock();
+      H5Fclose(file_id);
+    }
+  };
+  std::vector<std::thread> writers;
+  for (unsigned i = 1; i < nwriters; ++i) writers.emplace_back(writer);
+  writer();
+  for (auto& thread : writers) thread.join();
+
+  if (failed)
+    throw std::runtime_error("Writing HDF5 particle partitions failed");
+
+  // Master file with virtual datasets over the partitions
+  auto lock = mpm::hdf5_lock();
+  hid_t file_id =
+      H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+  if (file_id < 0)
+    throw std::runtime_error("Creating HDF5 file " + filename + " failed");
+  try {
+    for (const auto& dataset : field_datasets(columns))
+      mpm::write_hdf5_virtual_dataset(file_id, dataset.name, dataset.type,
+                                      dataset.ncols, files, rows);
+  } catch (...) {
+    H5Fclose(file_id);
+    throw;
+  }
+  H5Fclose(file_id);
+  return true;
+}
+
+//! Write particle fields to a file in the layout set in the options
+bool mpm::write_hdf5_particles(const std::string& filename,
+                               const HDF5ParticleColumns& columns,
+                               const HDF5Options& options) {
+  // Partitions written concurrently and tied together by a master file
+  if (options.partitions > 1)
+    return write_hdf5_particle_partitions(filename, columns, options);
+
+  // A single table of particle records holds all fields
+  if (!options.columns && columns.fields == HDF5Field::AllFields)
+    return write_hdf5_particle_table(filename, columns, options);
+
+  // One dataset per particle field
+  hid_t file_id;
+  {
+    auto lock = mpm::hdf5_lock();
+    file_id =
+        H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+  }
+  if (file_id < 0)
+    throw std::runtime_error("Creating HDF5 file " + filename + " failed");
+  try {
+    mpm::write_hdf5_particle_columns(file_id, columns, options, 0,
+                                     columns.size());
+  } catch (...) {
+    auto lock = mpm::hdf5_lock();
+    H5Fclose(file_id);
+    throw;
+  }
+  auto lock = mpm::hdf5_lock();
+  H5Fclose(file_id);
+  return true;
+}
+
+//! Write a range of rows of particle fields with one dataset per field
+bool mpm::write_hdf5_particle_columns(hid_t location,
+                                      const HDF5ParticleColumns& columns,
+                                      const HDF5Options& options,
+                                      hsize_t first, hsize_t last) {
+  const hsize_t nrows = last - first;
+
+  // Datasets take the HDF5 lock only around HDF5 calls
+  for (const auto& dataset : field_datasets(columns))
+    mpm::write_hdf5_dataset(
+        location, dataset.name, dataset.type,
+        static_cast<const char*>(dataset.data) +
+            first * dataset.ncols * dataset.size,
+        nrows, dataset.ncols, options);
+  return true;
+}
+
+//! Read particle fields stored with one dataset per field
+bool mpm::read_hdf5_particle_columns(hid_t location,
+                                     HDF5ParticleColumns* columns) {
+  const hsize_t nparticles = mpm::hdf5_dataset_dims(location, "id").first;
+
+  // Fields present in the file
+  unsigned fields = 0;
+  for (const std::string name : {"mass", "coordinates", "velocity", "stress",
+                                 "strain", "volumetric_strain", "status"})
+    if (H5Lexists(location, name.c_str(), H5P_DEFAULT) > 0)
+      fields |= mpm::hdf5_field(name);
+  hsize_t dim = 0;
+  if (fields & HDF5Field::Coordinates)
+    dim = mpm::hdf5_dataset_dims(location, "coordinates").second;
+  else if (fields & HDF5Field::Velocity)
+    dim = mpm::hdf5_dataset_dims(location, "velocity").second;
+  columns->resize(dim, nparticles, fields);
+
+  for (const auto& dataset : field_datasets(*columns))
+    mpm::read_hdf5_dataset(location, dataset.name, dataset.type, dataset.data);
+  return true;
+}
+
+//! Read particle fields of a table in chunks of records
+static bool read_hdf5_particle_table(hid_t file_id, unsigned dim,
+                                     hsize_t chunk_size,
+                                     mpm::HDF5ParticleColumns* columns) {
+  using mpm::HDF5Particle;
+
+  hsize_t nfields = 0, nrecords = 0;
+  if (H5TBget_table_info(file_id, "table", &nfields, &nrecords) < 0 ||
+      nfields != particle_table_nfields)
+    throw std::runtime_error("HDF5 particle table is invalid");
+
+  // Sizes of the fields of a record
+  HDF5Particle particle;
+  const size_t dst_sizes[particle_table_nfields] = {
+      sizeof(particle.id),         sizeof(particle.mass),
+      sizeof(particle.coord_x),    sizeof(particle.coord_y),
+      sizeof(particle.coord_z),    sizeof(particle.velocity_x),
+      sizeof(particle.velocity_y), sizeof(particle.velocity_z),
+      sizeof(particle.stress_xx),  sizeof(particle.stress_yy),
+      sizeof(particle.stress_zz),  sizeof(particle.tau_xy),
+      sizeof(particle.tau_yz),     sizeof(particle.tau_xz),
+      sizeof(particle.strain_xx),  sizeof(particle.strain_yy),
+      sizeof(particle.strain_zz),  sizeof(particle.gamma_xy),
+      sizeof(particle.gamma_yz),   sizeof(particle.gamma_xz),
+      sizeof(particle.epsilon_v),  sizeof(particle.status),
+  };
+
+  columns->resize(dim, nrecords);
+  chunk_size = std::max<hsize_t>(std::min(chunk_size, nrecords), 1);
+  std::vector<HDF5Particle> records(chunk_size);
+  for (hsize_t first = 0; first < nrecords; first += chunk_size) {
+    const hsize_t count = std::min(chunk_size, nrecords - first);
+    if (H5TBread_records(file_id, "table", first, count, sizeof(HDF5Particle),
+                         particle_table_offsets(), dst_sizes,
+                         records.data()) < 0)
+      throw std::runtime_error("Reading HDF5 particle table failed");
+    tbb::parallel_for(hsize_t(0), count, [&](hsize_t i) {
+      columns->set_particle(first + i, records[i]);
+    });
+  }
+  return true;
+}
+
+//! Read particle fields from a file written in any layout
+bool mpm::read_hdf5_particles(const std::string& filename, unsigned dim,
+                              HDF5ParticleColumns* columns,
+                              hsize_t chunk_size) {
+  auto lock = mpm::hdf5_lock();
+  hid_t file_id = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+  if (file_id < 0)
+    throw std::runtime_error("HDF5 particle file " + filename +
+                             " is not found");
+
+  try {
+    // Files without a table store one dataset per field
+    if (H5Lexists(file_id, "table", H5P_DEFAULT) > 0)
+      read_hdf5_particle_table(file_id, dim, chunk_size, columns);
+    else
+      mpm::read_hdf5_particle_columns(file_id, columns);
+  } catch (...) {
+    H5Fclose(file_id);
+    throw;
+  }
+  H5Fclose(file_id);
+  return true;
+}
@@ -0,0 +1,165 @@
+#include "hdf5_time_series.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+//! Number of index rows in a chunk
+static const hsize_t index_chunk = 1024;
+
+//! Constructor opens or creates the file
+mpm::HDF5TimeSeries::HDF5TimeSeries(const std::string& filename, bool append,
+                                    bool read_only, unsigned flush_interval)
+    : read_only_{read_only}, flush_interval_{std::max(flush_interval, 1u)} {
+  const bool exists = std::ifstream(filename).good();
+
+  if (read_only_ || (append && exists)) {
+    if (!exists)
+      throw std::runtime_error("HDF5 time series file is not found");
+    file_id_ = H5Fopen(filename.c_str(),
+                       read_only_ ? H5F_ACC_RDONLY : H5F_ACC_RDWR, H5P_DEFAULT);
+    if (file_id_ < 0)
+      throw std::runtime_error("HDF5 time series file is not found");
+
+    // Read the step and time index
+    try {
+      const hsize_t nsteps =
+          mpm::hdf5_dataset_dims(file_id_, "index/step").first;
+      std::vector<mpm::Index> steps(nsteps);
+      std::vector<double> times(nsteps);
+      mpm::read_hdf5_dataset(file_id_, "index/step", H5T_NATIVE_ULLONG,
+                             steps.data());
+      mpm::read_hdf5_dataset(file_id_, "index/time", H5T_NATIVE_DOUBLE,
+                             times.data());
+      index_.reserve(nsteps);
+      for (hsize_t i = 0; i < nsteps; ++i)
+        index_.emplace_back(std::make_pair(steps[i], times[i]));
+    } catch (...) {
+      H5Fclose(file_id_);
+      throw;
+    }
+    return;
+  }
+
+  file_id_ =
+      H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+  if (file_id_ < 0)
+    throw std::runtime_error("HDF5 time series file cannot be created");
+
+  // Groups of steps and an empty extensible index
+  H5Gclose(H5Gcreate2(file_id_, "steps", H5P_DEFAULT, H5P_DEFAULT,
+                      H5P_DEFAULT));
+  hid_t index_group =
+      H5Gcreate2(file_id_, "index", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  mpm::HDF5Options options;
+  options.chunk_size = index_chunk;
+  mpm::write_hdf5_dataset(index_group, "step", H5T_NATIVE_ULLONG, nullptr, 0,
+                          1, options);
+  mpm::write_hdf5_dataset(index_group, "time", H5T_NATIVE_DOUBLE, nullptr, 0,
+                          1, options);
+  H5Gclose(index_group);
+}
+
+//! Destructor flushes and closes the file
+mpm::HDF5TimeSeries::~HDF5TimeSeries() {
+  if (file_id_ >= 0) {
+    if (!read_only_) H5Fflush(file_id_, H5F_SCOPE_GLOBAL);
+    H5Fclose(file_id_);
+  }
+}
+
+//! Create the group of an output step and add it to the index
+hid_t mpm::HDF5TimeSeries::create_step(mpm::Index step, double time) {
+  if (read_only_)
+    throw std::runtime_error("HDF5 time series file is read only");
+
+  const std::string name = step_name(step);
+  // Replace a step written earlier
+  if (H5Lexists(file_id_, name.c_str(), H5P_DEFAULT) > 0)
+    H5Ldelete(file_id_, name.c_str(), H5P_DEFAULT);
+
+  hid_t group = H5Gcreate2(file_id_, name.c_str(), H5P_DEFAULT, H5P_DEFAULT,
+                           H5P_DEFAULT);
+  if (group < 0)
+    throw std::runtime_error("HDF5 step group cannot be created: " + name);
+
+  // Update the index
+  auto itr = std::find_if(
+      index_.begin(), index_.end(),
+      [step](const std::pair<mpm::Index, double>& row) {
+        return row.first == step;
+      });
+  if (itr == index_.end())
+    itr = index_.insert(index_.end(), std::make_pair(step, time));
+  itr->second = time;
+  this->write_index(std::distance(index_.begin(), itr));
+
+  return group;
+}
+
+//! Open the group of an output step
+hid_t mpm::HDF5TimeSeries::open_step(mpm::Index step) const {
+  const std::string name = step_name(step);
+  if (H5Lexists(file_id_, name.c_str(), H5P_DEFAULT) <= 0)
+    throw std::runtime_error("HDF5 step is not found: " + name);
+  return H5Gopen2(file_id_, name.c_str(), H5P_DEFAULT);
+}
+
+//! Close a step group
+void mpm::HDF5TimeSeries::close_step(hid_t group) {
+  H5Gclose(group);
+  if (read_only_) return;
+  if (++unflushed_steps_ >= flush_interval_) this->flush();
+}
+
+//! Flush the file to disk
+void mpm::HDF5TimeSeries::flush() {
+  H5Fflush(file_id_, H5F_SCOPE_GLOBAL);
+  unflushed_steps_ = 0;
+}
+
+//! Check if an output step is present
+bool mpm::HDF5TimeSeries::has_step(mpm::Index step) const {
+  return std::find_if(index_.begin(), index_.end(),
+                      [step](const std::pair<mpm::Index, double>& row) {
+                        return row.first == step;
+                      }) != index_.end();
+}
+
+//! Name of the group of a step
+std::string mpm::HDF5TimeSeries::step_name(mpm::Index step) {
+  // Zero padding keeps the groups in step order
+  std::ostringstream name;
+  name << "steps/" << std::setfill('0') << std::setw(10) << step;
+  return name.str();
+}
+
+//! Write a row of the step and time index
+void mpm::HDF5TimeSeries::write_index(hsize_t row) {
+  const hsize_t nrows = index_.size();
+  const hsize_t start[2] = {row, 0};
+  const hsize_t count[2] = {1, 1};
+  const hsize_t dims[2] = {nrows, 1};
+
+  const auto write_row = [&](const char* name, hid_t type, const void* value) {
+    hid_t dataset = H5Dopen2(file_id_, name, H5P_DEFAULT);
+    H5Dset_extent(dataset, dims);
+    hid_t file_space = H5Dget_space(dataset);
+    H5Sselect_hyperslab(file_space, H5S_SELECT_SET, start, nullptr, count,
+                        nullptr);
+    hid_t memory_space = H5Screate_simple(2, count, nullptr);
+    const herr_t status =
+        H5Dwrite(dataset, type, memory_space, file_space, H5P_DEFAULT, value);
+    H5Sclose(memory_space);
+    H5Sclose(file_space);
+    H5Dclose(dataset);
+    if (status < 0)
+      throw std::runtime_error(std::string("Writing HDF5 index failed: ") +
+                               name);
+  };
+
+  write_row("index/step", H5T_NATIVE_ULLONG, &index_[row].first);
+  write_row("index/time", H5T_NATIVE_DOUBLE, &index_[row].second);
+}
@@ -25,6 +25,12 @@ mpm::IO::IO(int argc, char** argv) {
 
     cmd.add(analysis_arg);
 
+    // Count hardware events of profiled stages
+    TCLAP::SwitchArg counters_arg(
+        "p", "perf_counters", "Count hardware events of profiled stages",
+        false);
+    cmd.add(counters_arg);
+
     // Parse arguments
     cmd.parse(argc, argv);
 
@@ -36,6 +42,9 @@ mpm::IO::IO(int argc, char** argv) {
 
     // Set Analysis Type
     analysis_ = analysis_arg.getValue();
+
+    // Set hardware event counters
+    perf_counters_ = counters_arg.getValue();
   } catch (TCLAP::ArgException& except) {  // catch any exceptions
     console_->error("error: {}  for arg {}", except.error(), except.argId());
   }
@@ -100,7 +109,6 @@ boost::filesystem::path mpm::IO::output_file(const std::string& attribute,
                                              unsigned step,
                                              unsigned max_steps) {
   std::stringstream file_name;
-  std::string path = this->output_folder();
 
   file_name.str(std::string());
   file_name << attribute;
@@ -110,6 +118,24 @@ boost::filesystem::path mpm::IO::output_file(const std::string& attribute,
   file_name << step;
   file_name << file_extension;
 
+  boost::filesystem::path file_path(this->analysis_folder(analysis_id) +
+                                    file_name.str().c_str());
+  return file_path;
+}
+
+//! Create output file name of a single file for the analysis
+boost::filesystem::path mpm::IO::output_file(const std::string& attribute,
+                                             const std::string& file_extension,
+                                             const std::string& analysis_id) {
+  boost::filesystem::path file_path(this->analysis_folder(analysis_id) +
+                                    attribute + file_extension);
+  return file_path;
+}
+
+//! Create the output folder of an analysis if not present
+std::string mpm::IO::analysis_folder(const std::string& analysis_id) {
+  std::string path = this->output_folder();
+
   // Include path
   if (!path.empty()) path = working_dir_ + path;
 
@@ -122,8 +148,7 @@ boost::filesystem::path mpm::IO::output_file(const std::string& attribute,
   dir = path;
   if (!boost::filesystem::exists(dir)) boost::filesystem::create_directory(dir);
 
-  boost::filesystem::path file_path(path + file_name.str().c_str());
-  return file_path;
+  return path;
 }
 
 //! Return output folder
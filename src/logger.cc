@@ -12,6 +12,14 @@ const std::shared_ptr<spdlog::logger> mpm::Logger::read_mesh =
 const std::shared_ptr<spdlog::logger> mpm::Logger::read_mesh_ascii =
     spdlog::stdout_color_st("ReadMeshAscii");
 
+// Create a logger for reading ascii mesh in parallel
+const std::shared_ptr<spdlog::logger> mpm::Logger::read_mesh_ascii_parallel =
+    spdlog::stdout_color_st("ReadMeshAsciiParallel");
+
+// Create a logger for reading binary mesh
+const std::shared_ptr<spdlog::logger> mpm::Logger::read_mesh_binary =
+    spdlog::stdout_color_st("ReadMeshBinary");
+
 // Create a logger for MPM
 const std::shared_ptr<spdlog::logger> mpm::Logger::mpm_logger =
     spdlog::stdout_color_st("MPM");
@@ -0,0 +1,40 @@
+#include "mapped_file.h"
+
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//! Map a file in read-only mode
+mpm::MappedFile::MappedFile(const std::string& filename) {
+  const int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) throw std::runtime_error("Unable to open file: " + filename);
+
+  struct stat file_stat;
+  if (::fstat(fd, &file_stat) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Unable to stat file: " + filename);
+  }
+  size_ = static_cast<std::size_t>(file_stat.st_size);
+
+  // An empty file cannot be mapped, it is treated as an empty buffer
+  if (size_ > 0) {
+    void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      ::close(fd);
+      throw std::runtime_error("Unable to map file: " + filename);
+    }
+    // Files are read front to back
+    ::madvise(data, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const char*>(data);
+  }
+  // Mapping remains valid after the descriptor is closed
+  ::close(fd);
+}
+
+//! Unmap file
+mpm::MappedFile::~MappedFile() {
+  if (data_ != nullptr) ::munmap(const_cast<char*>(data_), size_);
+}
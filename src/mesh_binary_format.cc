@@ -0,0 +1,178 @@
+#include "mesh_binary_format.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Source revision, generated by the build system at every build
+#ifdef MPM_REVISION_HEADER
+#include MPM_REVISION_HEADER
+#endif
+#ifndef MPM_REVISION
+#define MPM_REVISION "unknown"
+#endif
+
+//! Magic string of a binary file
+static const char magic[8] = {'M', 'P', 'M', 'B', 'I', 'N', '\0', '\0'};
+
+//! Return size of a value in bytes
+std::uint64_t mpm::binary::type_size(Type type) {
+  switch (type) {
+    case Type::UInt32:
+      return sizeof(std::uint32_t);
+    case Type::UInt64:
+      return sizeof(std::uint64_t);
+    case Type::Float64:
+      return sizeof(double);
+    case Type::UInt8:
+      return sizeof(std::uint8_t);
+  }
+  throw std::runtime_error("Invalid binary array type");
+}
+
+//! Write arrays to a binary file
+void mpm::binary::write(const std::string& filename, unsigned dim,
+                        const std::vector<ArrayData>& arrays) {
+  // Header
+  Header header;
+  std::memcpy(header.magic, magic, sizeof(magic));
+  header.version = version;
+  header.byte_order = byte_order;
+  header.dim = dim;
+  header.narrays = static_cast<std::uint32_t>(arrays.size());
+
+  // Offsets of arrays after the header and array descriptions
+  std::vector<ArrayInfo> infos;
+  std::uint64_t offset = sizeof(Header) + arrays.size() * sizeof(ArrayInfo);
+  for (const auto& array : arrays) {
+    offset = (offset + alignment - 1) / alignment * alignment;
+    infos.emplace_back(
+        ArrayInfo{array.array, array.type, array.rows, array.cols, offset});
+    offset += array.rows * array.cols * type_size(array.type);
+  }
+
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file.is_open())
+    throw std::runtime_error("Unable to open binary file: " + filename);
+
+  file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+  file.write(reinterpret_cast<const char*>(infos.data()),
+             infos.size() * sizeof(ArrayInfo));
+  for (unsigned i = 0; i < arrays.size(); ++i) {
+    // Pad to the aligned offset of the array
+    const std::uint64_t position = file.tellp();
+    const std::vector<char> padding(infos[i].offset - position, '\0');
+    file.write(padding.data(), padding.size());
+    file.write(static_cast<const char*>(arrays[i].data),
+               arrays[i].rows * arrays[i].cols * type_size(arrays[i].type));
+  }
+  if (!file.good())
+    throw std::runtime_error("Unable to write binary file: " + filename);
+}
+
+//! Write arrays to a temporary file and rename it over a binary file
+void mpm::binary::write_atomic(const std::string& filename, unsigned dim,
+                               const std::vector<ArrayData>& arrays) {
+  // Unique temporary file in the directory of the file
+  std::vector<char> temporary(filename.begin(), filename.end());
+  const std::string suffix = ".XXXXXX";
+  temporary.insert(temporary.end(), suffix.begin(), suffix.end());
+  temporary.emplace_back('\0');
+  const int descriptor = mkstemp(temporary.data());
+  if (descriptor < 0)
+    throw std::runtime_error("Unable to create temporary file for: " +
+                             filename);
+  // mkstemp creates the file readable only by the owner
+  fchmod(descriptor, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+  close(descriptor);
+
+  try {
+    mpm::binary::write(temporary.data(), dim, arrays);
+    if (std::rename(temporary.data(), filename.c_str()) != 0)
+      throw std::runtime_error("Unable to rename binary file: " + filename);
+  } catch (...) {
+    std::remove(temporary.data());
+    throw;
+  }
+}
+
+//! Find an array in a mapped binary file
+const mpm::binary::ArrayInfo* mpm::binary::find(const mpm::MappedFile& file,
+                                                unsigned dim, Array array,
+                                                Type type) {
+  if (file.size() < sizeof(Header))
+    throw std::runtime_error("Binary file is too small for a header");
+
+  const auto header = reinterpret_cast<const Header*>(file.data());
+  if (std::memcmp(header->magic, magic, sizeof(magic)) != 0)
+    throw std::runtime_error("Not an MPM binary file");
+  if (header->byte_order != byte_order)
+    throw std::runtime_error("Binary file byte order does not match");
+  if (header->version != version)
+    throw std::runtime_error("Unsupported binary file version: " +
+                             std::to_string(header->version));
+  if (header->dim != dim)
+    throw std::runtime_error("Binary file dimension does not match");
+  if (file.size() < sizeof(Header) + header->narrays * sizeof(ArrayInfo))
+    throw std::runtime_error("Binary file array descriptions are truncated");
+
+  const auto infos =
+      reinterpret_cast<const ArrayInfo*>(file.data() + sizeof(Header));
+  for (unsigned i = 0; i < header->narrays; ++i) {
+    if (infos[i].array != array) continue;
+    if (infos[i].type != type)
+      throw std::runtime_error("Binary file array type does not match");
+    if (infos[i].offset % alignment != 0 ||
+        infos[i].offset +
+                infos[i].rows * infos[i].cols * type_size(infos[i].type) >
+            file.size())
+      throw std::runtime_error("Binary file array is truncated");
+    return &infos[i];
+  }
+  return nullptr;
+}
+
+//! Return the key of a preprocessed mesh cache
+std::uint64_t mpm::binary::cache_key(const std::vector<std::string>& filenames,
+                                     const std::string& settings) {
+  // 64-bit FNV-1a hash
+  std::uint64_t hash = 14695981039346656037ULL;
+  const auto add = [&hash](const char* data, std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i) {
+      hash ^= static_cast<unsigned char>(data[i]);
+      hash *= 1099511628211ULL;
+    }
+  };
+
+  const std::string revision =
+      std::string(MPM_REVISION) + "/" + std::to_string(version);
+  add(revision.data(), revision.size() + 1);
+  add(settings.data(), settings.size() + 1);
+  for (const auto& filename : filenames) {
+    add(filename.data(), filename.size() + 1);
+    std::ifstream file(filename);
+    if (!file.is_open()) continue;
+    const mpm::MappedFile mapped(filename);
+    add(mapped.data(), mapped.size());
+  }
+  return hash;
+}
+
+//! Check if a file is a cache of a preprocessed mesh with a key
+bool mpm::binary::valid_cache(const std::string& filename, unsigned dim,
+                              std::uint64_t key) {
+  if (!std::ifstream(filename).is_open()) return false;
+  try {
+    const mpm::MappedFile file(filename);
+    const auto info = find(file, dim, Array::CacheKey, Type::UInt64);
+    return info != nullptr && info->rows * info->cols == 1 &&
+           *reinterpret_cast<const std::uint64_t*>(file.data() +
+                                                   info->offset) == key;
+  } catch (std::exception& exception) {
+    return false;
+  }
+}
@@ -0,0 +1,112 @@
+#include "perf_counters.h"
+
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+//! Return events of cycles, instructions, LLC misses and branch misses
+std::vector<mpm::PerfEvent> mpm::PerfCounters::hardware_events() {
+#ifdef __linux__
+  return {{"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+          {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+          {"llc_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+          {"branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES}};
+#else
+  return {};
+#endif
+}
+
+//! Constructor opens the counters of the calling thread
+mpm::PerfCounters::PerfCounters(const std::vector<PerfEvent>& events)
+    : events_{events} {
+  // Events the calling thread cannot count are left out for all threads
+  this->open_thread(true);
+  for (const auto& event : events_) names_.emplace_back(event.name);
+  if (!events_.empty()) this->observe(true);
+}
+
+//! Destructor closes the counters
+mpm::PerfCounters::~PerfCounters() {
+  this->observe(false);
+#ifdef __linux__
+  for (const auto& group : groups_)
+    for (const int fd : group) ::close(fd);
+#endif
+}
+
+//! Open the counters of a thread entering the scheduler
+void mpm::PerfCounters::on_scheduler_entry(bool /*worker*/) {
+  this->open_thread(false);
+}
+
+//! Open a counter group of the calling thread if it has none
+void mpm::PerfCounters::open_thread(bool drop) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!threads_.insert(std::this_thread::get_id()).second) return;
+
+#ifdef __linux__
+  std::vector<int> group;
+  std::vector<PerfEvent> opened;
+  for (const auto& event : events_) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = event.type;
+    attr.config = event.config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                       PERF_FORMAT_TOTAL_TIME_RUNNING;
+    // Counting starts with the leader, members follow it
+    attr.disabled = group.empty() ? 1 : 0;
+
+    const int fd = static_cast<int>(
+        ::syscall(__NR_perf_event_open, &attr, 0, -1,
+                  group.empty() ? -1 : group.front(), 0));
+    if (fd >= 0) {
+      group.emplace_back(fd);
+      opened.emplace_back(event);
+    } else if (!drop) {
+      // Other threads count the same events, or none
+      for (const int member : group) ::close(member);
+      return;
+    }
+  }
+  if (drop) events_ = opened;
+  if (group.empty()) return;
+
+  ::ioctl(group.front(), PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ::ioctl(group.front(), PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  groups_.emplace_back(std::move(group));
+#else
+  if (drop) events_.clear();
+#endif
+}
+
+//! Return counts of events summed over threads
+std::vector<double> mpm::PerfCounters::read() const {
+  std::vector<double> counts(events_.size(), 0.);
+#ifdef __linux__
+  std::lock_guard<std::mutex> lock(mutex_);
+  // Number of events, time enabled, time running and a value per event
+  std::vector<std::uint64_t> values(3 + events_.size());
+  for (const auto& group : groups_) {
+    const auto size = values.size() * sizeof(std::uint64_t);
+    if (::read(group.front(), values.data(), size) !=
+        static_cast<ssize_t>(size))
+      continue;
+    // Counts of multiplexed groups are scaled to the time enabled
+    const double scale = (values[2] > 0) ? static_cast<double>(values[1]) /
+                                               static_cast<double>(values[2])
+                                         : 0.;
+    for (std::size_t i = 0; i < counts.size(); ++i)
+      counts[i] += static_cast<double>(values[3 + i]) * scale;
+  }
+#endif
+  return counts;
+}
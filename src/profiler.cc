@@ -0,0 +1,171 @@
+#include "profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+
+//! Constructor
+mpm::Profiler::Profiler(bool trace) : trace_{trace}, origin_{Clock::now()} {}
+
+//! Record a stage
+void mpm::Profiler::record(const std::string& stage, Clock::time_point start,
+                           Clock::time_point end,
+                           const std::vector<double>& counts,
+                           const Allocations* allocations) {
+  const double duration =
+      std::chrono::duration<double, std::milli>(end - start).count();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto index = stage_index_.find(stage);
+  if (index == stage_index_.end()) {
+    index = stage_index_.emplace(stage, stages_.size()).first;
+    stages_.emplace_back(stage);
+    durations_.emplace_back();
+    counts_.emplace_back(counts.size(), 0.);
+    allocations_.emplace_back();
+    allocations_tracked_.emplace_back(false);
+  }
+  durations_[index->second].emplace_back(duration);
+  auto& totals = counts_[index->second];
+  for (std::size_t i = 0; i < std::min(counts.size(), totals.size()); ++i)
+    totals[i] += counts[i];
+  if (allocations) {
+    allocations_[index->second].calls += allocations->calls;
+    allocations_[index->second].bytes += allocations->bytes;
+    allocations_tracked_[index->second] = true;
+  }
+
+  if (trace_) {
+    const auto thread =
+        threads_.emplace(std::this_thread::get_id(), threads_.size()).first;
+    events_.emplace_back(Event{
+        index->second, thread->second,
+        std::chrono::duration<double, std::micro>(start - origin_).count(),
+        duration * 1000.});
+  }
+}
+
+//! Count events of stages
+bool mpm::Profiler::enable_counters(const std::vector<PerfEvent>& events) {
+  auto counters = std::make_unique<PerfCounters>(events);
+  if (counters->names().empty()) return false;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  counters_ = std::move(counters);
+  return true;
+}
+
+//! Return the summary of stages
+nlohmann::json mpm::Profiler::summary(const std::string& reference) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // Total of the reference stage
+  double reference_total = 0.;
+  const auto reference_index = stage_index_.find(reference);
+  if (reference_index != stage_index_.end())
+    reference_total =
+        std::accumulate(durations_[reference_index->second].cbegin(),
+                        durations_[reference_index->second].cend(), 0.);
+
+  // Index of a counted event
+  const auto event = [this](const std::string& name) {
+    if (!counters_) return -1;
+    const auto& names = counters_->names();
+    const auto it = std::find(names.cbegin(), names.cend(), name);
+    return (it != names.cend()) ? static_cast<int>(it - names.cbegin()) : -1;
+  };
+  const int cycles = event("cycles");
+  const int instructions = event("instructions");
+  const int llc_misses = event("llc_misses");
+
+  nlohmann::json stages = nlohmann::json::array();
+  for (unsigned i = 0; i < stages_.size(); ++i) {
+    std::vector<double> durations = durations_[i];
+    const double total =
+        std::accumulate(durations.cbegin(), durations.cend(), 0.);
+
+    // Nearest rank 99th percentile
+    const std::size_t rank = static_cast<std::size_t>(
+        std::ceil(0.99 * static_cast<double>(durations.size())));
+    const auto p99 = durations.begin() + std::max<std::size_t>(rank, 1) - 1;
+    std::nth_element(durations.begin(), p99, durations.end());
+
+    nlohmann::json entry = {
+        {"stage", stages_[i]},
+        {"calls", durations.size()},
+        {"total_ms", total},
+        {"mean_ms", total / static_cast<double>(durations.size())},
+        {"p99_ms", *p99},
+        {"share", (reference_total > 0.) ? total / reference_total : 0.}};
+
+    // Counts of events, stages recorded without counts are left out
+    const auto& counts = counts_[i];
+    if (counters_ && counts.size() == counters_->names().size()) {
+      for (std::size_t j = 0; j < counts.size(); ++j)
+        entry[counters_->names()[j]] = counts[j];
+      if (cycles >= 0 && instructions >= 0 && counts[cycles] > 0.)
+        entry["ipc"] = counts[instructions] / counts[cycles];
+      // Memory traffic is estimated as a cache line per LLC miss
+      if (llc_misses >= 0) {
+        const double bytes = counts[llc_misses] * 64.;
+        entry["llc_miss_bytes"] = bytes;
+        if (nparticles_ > 0)
+          entry["bytes_per_particle_update"] =
+              bytes / static_cast<double>(durations.size() * nparticles_);
+      }
+    }
+    // Heap allocations, stages recorded without tracking are left out
+    if (allocations_tracked_[i]) {
+      entry["allocations"] = allocations_[i].calls;
+      entry["allocated_bytes"] = allocations_[i].bytes;
+      entry["allocations_per_call"] =
+          static_cast<double>(allocations_[i].calls) /
+          static_cast<double>(durations.size());
+    }
+    stages.push_back(entry);
+  }
+  nlohmann::json summary = {{"reference", reference}, {"stages", stages}};
+  if (counters_) {
+    summary["counters"] = counters_->names();
+    summary["particles"] = nparticles_;
+  }
+  return summary;
+}
+
+//! Write the summary of stages to a JSON file
+void mpm::Profiler::write_summary(const std::string& filename,
+                                  const std::string& reference) const {
+  std::ofstream file(filename);
+  if (!file.is_open())
+    throw std::runtime_error("Unable to open profile file: " + filename);
+  file << this->summary(reference).dump(2) << '\n';
+  if (!file.good())
+    throw std::runtime_error("Unable to write profile file: " + filename);
+}
+
+//! Write recorded events as a Chrome trace
+void mpm::Profiler::write_trace(const std::string& filename) const {
+  std::ofstream file(filename);
+  if (!file.is_open())
+    throw std::runtime_error("Unable to open trace file: " + filename);
+
+  // Complete events, one row per thread recording stages
+  std::lock_guard<std::mutex> lock(mutex_);
+  file << "{\"traceEvents\":[";
+  for (std::size_t i = 0; i < events_.size(); ++i) {
+    const auto& event = events_[i];
+    file << (i == 0 ? "\n" : ",\n")
+         << nlohmann::json({{"name", stages_[event.stage]},
+                            {"ph", "X"},
+                            {"pid", 0},
+                            {"tid", event.thread},
+                            {"ts", event.start},
+                            {"dur", event.duration}})
+                .dump();
+  }
+  file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  if (!file.good())
+    throw std::runtime_error("Unable to write trace file: " + filename);
+}
@@ -1,6 +1,8 @@
 #include "read_mesh.h"
 #include "factory.h"
 #include "read_mesh_ascii.h"
+#include "read_mesh_ascii_parallel.h"
+#include "read_mesh_binary.h"
 
 // ReadMeshAscii
 static Register<mpm::ReadMesh<2>, mpm::ReadMeshAscii<2>> readmesh_ascii_2d(
@@ -9,3 +11,19 @@ static Register<mpm::ReadMesh<2>, mpm::ReadMeshAscii<2>> readmesh_ascii_2d(
 // ReadMeshAscii
 static Register<mpm::ReadMesh<3>, mpm::ReadMeshAscii<3>> readmesh_ascii_3d(
     "Ascii3D");
+
+// ReadMeshAsciiParallel
+static Register<mpm::ReadMesh<2>, mpm::ReadMeshAsciiParallel<2>>
+    readmesh_ascii_parallel_2d("AsciiParallel2D");
+
+// ReadMeshAsciiParallel
+static Register<mpm::ReadMesh<3>, mpm::ReadMeshAsciiParallel<3>>
+    readmesh_ascii_parallel_3d("AsciiParallel3D");
+
+// ReadMeshBinary
+static Register<mpm::ReadMesh<2>, mpm::ReadMeshBinary<2>> readmesh_binary_2d(
+    "Binary2D");
+
+// ReadMeshBinary
+static Register<mpm::ReadMesh<3>, mpm::ReadMeshBinary<3>> readmesh_binary_3d(
+    "Binary3D");
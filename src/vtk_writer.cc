@@ -1,5 +1,8 @@
 #include "vtk_writer.h"
 
+#include <boost/filesystem.hpp>
+#include <tbb/parallel_for.h>
+
 //! VTK Writer class Constructor with coordniates
 //! \param[in] coordinate Point coordinates
 //! \param[in] node_pairs Node ID pairs to form elements
@@ -15,6 +18,20 @@ VtkWriter::VtkWriter(
   }
 }
 
+//! VTK Writer class Constructor with a contiguous buffer of coordinates
+//! \param[in] coordinates Point coordinates, 3 values per point
+//! \param[in] npoints Number of points
+VtkWriter::VtkWriter(double* coordinates, vtkIdType npoints)
+    : coordinates_{coordinates}, npoints_{npoints} {
+  auto data = vtkSmartPointer<vtkDoubleArray>::New();
+  data->SetNumberOfComponents(3);
+  // Save flag 1 keeps VTK from freeing the buffer
+  data->SetArray(coordinates, npoints * 3, 1);
+
+  points_ = vtkSmartPointer<vtkPoints>::New();
+  points_->SetData(data);
+}
+
 //! Write coordinates
 //! \param[in] filename Output file to write geometry
 void VtkWriter::write_geometry(const std::string& filename) {
@@ -86,3 +103,105 @@ void VtkWriter::write_vector_point_data(
   writer->SetCompressor(vtkZLibDataCompressor::New());
   writer->Write();
 }
+
+//! \brief Write points and point data arrays to a single file
+//! \param[in] filename Output file
+//! \param[in] arrays Point data arrays
+void VtkWriter::write_point_data(const std::string& filename,
+                                 const std::vector<VtkPointArray>& arrays) {
+
+  // Create a polydata to store everything in it
+  auto pdata = vtkSmartPointer<vtkPolyData>::New();
+
+  // Add the points to the dataset
+  pdata->SetPoints(points_);
+
+  // Wrap the buffers of the arrays
+  for (const auto& array : arrays) {
+    auto data = vtkSmartPointer<vtkDoubleArray>::New();
+    data->SetNumberOfComponents(array.ncomponents);
+    data->SetArray(array.values,
+                   pdata->GetNumberOfPoints() * array.ncomponents, 1);
+    data->SetName(array.name.c_str());
+    pdata->GetPointData()->AddArray(data);
+  }
+
+  // Write file
+  auto writer = vtkSmartPointer<vtkXMLPolyDataWriter>::New();
+
+  writer->SetFileName(filename.c_str());
+
+  writer->SetDataModeToBinary();
+
+#if VTK_MAJOR_VERSION <= 5
+  writer->SetInput(pdata);
+#else
+  writer->SetInputData(pdata);
+#endif
+
+  auto compressor = vtkSmartPointer<vtkZLibDataCompressor>::New();
+  writer->SetCompressor(compressor);
+  writer->Write();
+}
+
+//! \brief Write points and point data arrays as pieces written concurrently
+//! \param[in] filename Output .pvtp file
+//! \param[in] arrays Point data arrays
+//! \param[in] npieces Number of pieces
+void VtkWriter::write_parallel_point_data(
+    const std::string& filename, const std::vector<VtkPointArray>& arrays,
+    unsigned npieces) {
+  if (coordinates_ == nullptr && npoints_ > 0)
+    throw std::runtime_error(
+        "Parallel VTK output requires a contiguous buffer of coordinates");
+  if (npieces == 0) npieces = 1;
+
+  const boost::filesystem::path path(filename);
+  const auto piece_file = [&path](unsigned piece) {
+    return path.stem().string() + "_" + std::to_string(piece) + ".vtp";
+  };
+
+  // Pieces wrap contiguous ranges of the buffers, each piece has its own
+  // pipeline so the pieces are serialised and compressed concurrently
+  tbb::parallel_for(0u, npieces, [&](unsigned piece) {
+    const vtkIdType first = npoints_ * piece / npieces;
+    const vtkIdType last = npoints_ * (piece + 1) / npieces;
+
+    std::vector<VtkPointArray> piece_arrays;
+    for (const auto& array : arrays)
+      piece_arrays.emplace_back(VtkPointArray{
+          array.name, array.ncomponents,
+          array.values + first * array.ncomponents});
+
+    VtkWriter piece_writer(coordinates_ + first * 3, last - first);
+    piece_writer.write_point_data(
+        (path.parent_path() / piece_file(piece)).string(), piece_arrays);
+  });
+
+  // Byte order of the pieces written by this host
+  const unsigned short one = 1;
+  const bool little_endian = *reinterpret_cast<const char*>(&one) == 1;
+
+  // Parallel file referencing the pieces relative to its directory
+  std::ofstream file(filename);
+  if (!file.is_open())
+    throw std::runtime_error("Parallel VTK file cannot be opened");
+  file << "<?xml version=\"1.0\"?>\n"
+       << "<VTKFile type=\"PPolyData\" version=\"0.1\" byte_order=\""
+       << (little_endian ? "LittleEndian" : "BigEndian") << "\">\n"
+       << "  <PPolyData GhostLevel=\"0\">\n"
+       << "    <PPointData>\n";
+  for (const auto& array : arrays)
+    file << "      <PDataArray type=\"Float64\" Name=\"" << array.name
+         << "\" NumberOfComponents=\"" << array.ncomponents << "\"/>\n";
+  file << "    </PPointData>\n"
+       << "    <PPoints>\n"
+       << "      <PDataArray type=\"Float64\" NumberOfComponents=\"3\"/>\n"
+       << "    </PPoints>\n";
+  for (unsigned piece = 0; piece < npieces; ++piece)
+    file << "    <Piece Source=\"" << piece_file(piece) << "\"/>\n";
+  file << "  </PPolyData>\n"
+       << "</VTKFile>\n";
+  if (!file.good())
+    throw std::runtime_error("Writing parallel VTK file failed");
+}
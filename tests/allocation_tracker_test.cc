@@ -0,0 +1,82 @@
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+
+#include "Eigen/Dense"
+
+#include "allocation_tracker.h"
+
+namespace {
+//! Pointers escape to a volatile, so that allocations are not elided
+void* volatile escaped = nullptr;
+}  // namespace
+
+// Check allocation tracking
+TEST_CASE("Allocation tracker is checked", "[AllocationTracker]") {
+
+  SECTION("Check difference of allocations") {
+    mpm::Allocations start;
+    start.calls = 2;
+    start.bytes = 64;
+    mpm::Allocations end;
+    end.calls = 5;
+    end.bytes = 160;
+    const auto allocations = end - start;
+    REQUIRE(allocations.calls == 3);
+    REQUIRE(allocations.bytes == 96);
+  }
+
+  SECTION("Check allocations of tracked threads") {
+    // Counts do not change in builds without tracking
+    const auto start = mpm::heap_allocations();
+    double sum = 0.;
+    {
+      auto value = std::make_unique<double>(1.);
+      std::vector<double> values(64, 1.);
+      Eigen::VectorXd vector = Eigen::VectorXd::Ones(16);
+      void* memory = std::malloc(32);
+      escaped = value.get();
+      escaped = values.data();
+      escaped = vector.data();
+      escaped = memory;
+      std::free(memory);
+      sum = *value + values.back() + vector.sum();
+    }
+    const auto allocations = mpm::heap_allocations() - start;
+    REQUIRE(sum == Approx(18.).epsilon(1.E-9));
+
+    if (mpm::allocation_tracking()) {
+      // operator new, Eigen temporaries and malloc are counted
+      REQUIRE(allocations.calls == 4);
+      REQUIRE(allocations.bytes == (1 + 64 + 16) * sizeof(double) + 32);
+    } else {
+      REQUIRE(allocations.calls == 0);
+      REQUIRE(allocations.bytes == 0);
+    }
+  }
+
+  SECTION("Check untracked allocations") {
+    const auto start = mpm::heap_allocations();
+    {
+      mpm::UntrackedAllocations untracked;
+      {
+        // Untracked scopes nest
+        mpm::UntrackedAllocations nested;
+        std::vector<double> values(64, 1.);
+      }
+      std::vector<double> values(64, 1.);
+    }
+    // Other threads are tracked
+    std::vector<double> values;
+    std::thread worker([&values]() { values.resize(64, 1.); });
+    worker.join();
+
+    const auto allocations = mpm::heap_allocations() - start;
+    if (mpm::allocation_tracking())
+      REQUIRE(allocations.bytes >= 64 * sizeof(double));
+    REQUIRE(allocations.bytes < 128 * sizeof(double));
+  }
+}
@@ -0,0 +1,76 @@
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+
+#include "async_writer.h"
+
+// Check AsyncWriter
+TEST_CASE("AsyncWriter is checked", "[AsyncWriter]") {
+
+  SECTION("Check tasks run in order") {
+    std::vector<unsigned> order;
+    mpm::AsyncWriter writer(2);
+    for (unsigned i = 0; i < 10; ++i)
+      writer.submit([&order, i]() { order.emplace_back(i); });
+    REQUIRE(writer.wait() == true);
+    REQUIRE(order.size() == 10);
+    for (unsigned i = 0; i < order.size(); ++i) REQUIRE(order[i] == i);
+  }
+
+  SECTION("Check back-pressure of a full queue") {
+    const unsigned queue_size = 2;
+    std::atomic<unsigned> started{0};
+    std::atomic<bool> release{false};
+    mpm::AsyncWriter writer(queue_size);
+
+    // Blocked task keeps the queue from draining
+    writer.submit([&]() {
+      ++started;
+      while (!release) std::this_thread::yield();
+    });
+    while (started == 0) std::this_thread::yield();
+    for (unsigned i = 0; i < queue_size; ++i) writer.submit([&]() {});
+
+    // Next submission waits until the blocked task completes
+    std::atomic<bool> submitted{false};
+    std::thread producer([&]() {
+      writer.submit([&]() {});
+      submitted = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    REQUIRE(submitted == false);
+
+    release = true;
+    producer.join();
+    REQUIRE(submitted == true);
+    REQUIRE(writer.wait() == true);
+  }
+
+  SECTION("Check failed tasks") {
+    std::atomic<unsigned> completed{0};
+    mpm::AsyncWriter writer;
+    writer.submit([]() { throw std::runtime_error("Task failed"); });
+    writer.submit([&]() { ++completed; });
+    REQUIRE(writer.wait() == false);
+    REQUIRE(completed == 1);
+    // Failures are reset by wait
+    REQUIRE(writer.wait() == true);
+  }
+
+  SECTION("Check pending tasks complete on destruction") {
+    std::atomic<unsigned> completed{0};
+    {
+      mpm::AsyncWriter writer(4);
+      for (unsigned i = 0; i < 4; ++i)
+        writer.submit([&]() {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          ++completed;
+        });
+    }
+    REQUIRE(completed == 4);
+  }
+}
@@ -1,5 +1,6 @@
 #include <limits>
 #include <memory>
+#include <vector>
 
 #include "Eigen/Dense"
 #include "catch.hpp"
@@ -10,6 +11,7 @@
 #include "hexahedron_element.h"
 #include "node.h"
 #include "quadrilateral_element.h"
+#include "quadrilateral_quadrature.h"
 
 //! \brief Check cell class for 2D case
 TEST_CASE("Cell is checked for 2D case", "[cell][2D]") {
@@ -135,6 +137,22 @@ TEST_CASE("Cell is checked for 2D case", "[cell][2D]") {
       REQUIRE(sf_ptr->nfunctions() == element->nfunctions());
     }
 
+    // Check quadrature points of a cell
+    SECTION("Check quadrature points") {
+      mpm::QuadrilateralQuadrature<Dim, 4> quadrature;
+      const auto points = cell->quadrature_points(quadrature.quadratures(),
+                                                  quadrature.weights());
+      REQUIRE(points.size() == 4);
+      // Gauss points of a 2 x 2 cell with a quarter of the cell volume
+      const double offset = 1. - 1. / std::sqrt(3.);
+      REQUIRE(points[0].first(0) == Approx(offset).epsilon(Tolerance));
+      REQUIRE(points[0].first(1) == Approx(offset).epsilon(Tolerance));
+      REQUIRE(points[2].first(0) == Approx(2. - offset).epsilon(Tolerance));
+      REQUIRE(points[2].first(1) == Approx(2. - offset).epsilon(Tolerance));
+      for (const auto& point : points)
+        REQUIRE(point.second == Approx(1.).epsilon(Tolerance));
+    }
+
     // Check centroid calculation
     SECTION("Compute centroid of a cell") {
       REQUIRE(cell->nfunctions() == 4);
@@ -389,21 +407,21 @@ TEST_CASE("Cell is checked for 2D case", "[cell][2D]") {
   }
 
   SECTION("Test particle addition deletion") {
-    mpm::Index pid = 0;
     auto cell = std::make_shared<mpm::Cell<Dim>>(0, Nnodes, element);
     REQUIRE(cell->nparticles() == 0);
     REQUIRE(cell->status() == false);
-    bool status = cell->add_particle_id(pid);
-    REQUIRE(status == true);
+    cell->add_particle();
     REQUIRE(cell->status() == true);
     REQUIRE(cell->nparticles() == 1);
-    cell->remove_particle_id(pid);
+    cell->add_particle();
+    REQUIRE(cell->nparticles() == 2);
+    cell->remove_particle();
+    cell->remove_particle();
     REQUIRE(cell->status() == false);
     REQUIRE(cell->nparticles() == 0);
   }
 
   SECTION("Test node status") {
-    mpm::Index pid = 0;
     auto cell = std::make_shared<mpm::Cell<Dim>>(0, Nnodes, element);
     cell->add_node(0, node0);
     cell->add_node(1, node1);
@@ -423,14 +441,14 @@ TEST_CASE("Cell is checked for 2D case", "[cell][2D]") {
     for (const auto& node : nodes) REQUIRE(node->status() == false);
 
     // Add a particle
-    REQUIRE(cell->add_particle_id(pid) == true);
+    cell->add_particle();
     REQUIRE(cell->status() == true);
     REQUIRE(cell->nparticles() == 1);
     cell->activate_nodes();
     for (const auto& node : nodes) REQUIRE(node->status() == true);
 
     // Remove a particle
-    cell->remove_particle_id(pid);
+    cell->remove_particle();
     REQUIRE(cell->status() == false);
     REQUIRE(cell->nparticles() == 0);
     // initialise nodes
@@ -1244,21 +1262,21 @@ TEST_CASE("Cell is checked for 3D case", "[cell][3D]") {
   }
 
   SECTION("Test particle addition deletion") {
-    mpm::Index pid = 0;
     auto cell = std::make_shared<mpm::Cell<Dim>>(0, Nnodes, element);
     REQUIRE(cell->status() == false);
     REQUIRE(cell->nparticles() == 0);
-    bool status = cell->add_particle_id(pid);
-    REQUIRE(status == true);
+    cell->add_particle();
     REQUIRE(cell->status() == true);
     REQUIRE(cell->nparticles() == 1);
-    cell->remove_particle_id(pid);
+    cell->add_particle();
+    REQUIRE(cell->nparticles() == 2);
+    cell->remove_particle();
+    cell->remove_particle();
     REQUIRE(cell->status() == false);
     REQUIRE(cell->nparticles() == 0);
   }
 
   SECTION("Test node status") {
-    mpm::Index pid = 0;
     auto cell = std::make_shared<mpm::Cell<Dim>>(0, Nnodes, element);
     cell->add_node(0, node0);
     cell->add_node(1, node1);
@@ -1286,14 +1304,14 @@ TEST_CASE("Cell is checked for 3D case", "[cell][3D]") {
     for (const auto& node : nodes) REQUIRE(node->status() == false);
 
     // Add a particle
-    REQUIRE(cell->add_particle_id(pid) == true);
+    cell->add_particle();
     REQUIRE(cell->status() == true);
     REQUIRE(cell->nparticles() == 1);
     cell->activate_nodes();
     for (const auto& node : nodes) REQUIRE(node->status() == true);
 
     // Remove a particle
-    cell->remove_particle_id(pid);
+    cell->remove_particle();
     REQUIRE(cell->status() == false);
     REQUIRE(cell->nparticles() == 0);
     // initialise nodes
@@ -0,0 +1,90 @@
+#include <vector>
+
+#include "catch.hpp"
+
+#include "hdf5_time_series.h"
+
+// Check HDF5TimeSeries
+TEST_CASE("HDF5TimeSeries is checked", "[HDF5][TimeSeries]") {
+  const std::string filename = "time-series.h5";
+
+  // Tolerance
+  const double Tolerance = 1.E-12;
+
+  // Write a dataset of a step
+  const auto write_step = [](mpm::HDF5TimeSeries& series, mpm::Index step,
+                             double time) {
+    hid_t group = series.create_step(step, time);
+    REQUIRE(group >= 0);
+    std::vector<double> values{static_cast<double>(step), time};
+    mpm::write_hdf5_dataset(group, "values", H5T_NATIVE_DOUBLE, values.data(),
+                            2, 1, mpm::HDF5Options());
+    series.close_step(group);
+  };
+
+  // Read the dataset of a step
+  const auto read_step = [](const mpm::HDF5TimeSeries& series,
+                            mpm::Index step) {
+    hid_t group = series.open_step(step);
+    std::vector<double> values(2);
+    mpm::read_hdf5_dataset(group, "values", H5T_NATIVE_DOUBLE, values.data());
+    H5Gclose(group);
+    return values;
+  };
+
+  SECTION("Check writing and appending steps") {
+    {
+      mpm::HDF5TimeSeries series(filename, false, false, 2);
+      REQUIRE(series.index().size() == 0);
+      write_step(series, 0, 0.0);
+      write_step(series, 5, 0.5);
+      write_step(series, 10, 1.0);
+      REQUIRE(series.index().size() == 3);
+      REQUIRE(series.has_step(5) == true);
+      REQUIRE(series.has_step(7) == false);
+    }
+
+    // Append to the file and replace a step
+    {
+      mpm::HDF5TimeSeries series(filename, true);
+      REQUIRE(series.index().size() == 3);
+      write_step(series, 10, 1.5);
+      write_step(series, 15, 2.0);
+      REQUIRE(series.index().size() == 4);
+    }
+
+    // Read steps
+    mpm::HDF5TimeSeries series(filename, true, true);
+    const auto& index = series.index();
+    REQUIRE(index.size() == 4);
+    std::vector<mpm::Index> steps{0, 5, 10, 15};
+    std::vector<double> times{0.0, 0.5, 1.5, 2.0};
+    for (unsigned i = 0; i < index.size(); ++i) {
+      REQUIRE(index[i].first == steps[i]);
+      REQUIRE(index[i].second == Approx(times[i]).epsilon(Tolerance));
+    }
+
+    auto values = read_step(series, 10);
+    REQUIRE(values[0] == Approx(10.).epsilon(Tolerance));
+    REQUIRE(values[1] == Approx(1.5).epsilon(Tolerance));
+    values = read_step(series, 15);
+    REQUIRE(values[0] == Approx(15.).epsilon(Tolerance));
+
+    // Missing step and writing to a read only file
+    REQUIRE_THROWS(series.open_step(7));
+    REQUIRE_THROWS(series.create_step(20, 2.5));
+  }
+
+  SECTION("Check truncating an existing file") {
+    {
+      mpm::HDF5TimeSeries series(filename, false);
+      write_step(series, 0, 0.0);
+    }
+    mpm::HDF5TimeSeries series(filename, false);
+    REQUIRE(series.index().size() == 0);
+  }
+
+  SECTION("Check missing file") {
+    REQUIRE_THROWS(mpm::HDF5TimeSeries("missing-time-series.h5", true, true));
+  }
+}
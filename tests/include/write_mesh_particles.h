@@ -1,4 +1,7 @@
 #include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "mpm.h"
 
@@ -7,6 +10,14 @@ namespace mpm_test {
 // Write JSON Configuration file
 bool write_json(unsigned dim, bool resume, const std::string& file_name);
 
+// Write a variant of a JSON configuration file to <uuid>.json, with the
+// analysis uuid set and a JSON merge patch applied, and return the IO of an
+// analysis reading it with any additional command line arguments
+std::unique_ptr<mpm::IO> write_json_variant(
+    const std::string& base, const std::string& uuid,
+    const std::string& analysis, const Json& patch,
+    const std::vector<std::string>& args = {});
+
 // Write Mesh file in 2D
 bool write_mesh_2d();
 // Write particles file in 2D
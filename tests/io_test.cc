@@ -121,6 +121,9 @@ TEST_CASE("IO is checked for input parsing", "[IO][JSON]") {
     auto meshfile =
         io->output_file(attribute, extension, uuid_, step, max_steps).string();
     REQUIRE(meshfile == "./results/MPM/geometry057.vtp");
+    // Check single output file name of the analysis
+    auto seriesfile = io->output_file("particles", ".h5", uuid_).string();
+    REQUIRE(seriesfile == "./results/MPM/particles.h5");
     // Check output folder
     REQUIRE(io->output_folder() == "results/");
   }
@@ -217,9 +217,8 @@ TEST_CASE("Bingham is checked in 2D", "[material][bingham][2D]") {
     std::shared_ptr<mpm::Element<Dim>> shapefn =
         Factory<mpm::Element<Dim>>::instance()->create("ED2Q4");
 
-    node0->assign_velocity_constraint(0, 0.02);
-    node0->assign_velocity_constraint(1, 0.03);
-    node0->apply_velocity_constraints();
+    node0->apply_velocity_constraint(0, 0.02);
+    node0->apply_velocity_constraint(1, 0.03);
 
     auto cell = std::make_shared<mpm::Cell<Dim>>(cell_id, Nnodes, shapefn);
 
@@ -315,9 +314,8 @@ TEST_CASE("Bingham is checked in 2D", "[material][bingham][2D]") {
     std::shared_ptr<mpm::Element<Dim>> shapefn =
         Factory<mpm::Element<Dim>>::instance()->create("ED2Q4");
 
-    node0->assign_velocity_constraint(0, 2);
-    node0->assign_velocity_constraint(1, 3);
-    node0->apply_velocity_constraints();
+    node0->apply_velocity_constraint(0, 2);
+    node0->apply_velocity_constraint(1, 3);
 
     auto cell = std::make_shared<mpm::Cell<Dim>>(cell_id, Nnodes, shapefn);
 
@@ -593,10 +591,9 @@ TEST_CASE("Bingham is checked in 3D", "[material][bingham][3D]") {
     std::shared_ptr<mpm::Element<Dim>> shapefn =
         Factory<mpm::Element<Dim>>::instance()->create("ED3H8");
 
-    node0->assign_velocity_constraint(0, 0.02);
-    node0->assign_velocity_constraint(1, 0.03);
-    node0->assign_velocity_constraint(2, 0.04);
-    node0->apply_velocity_constraints();
+    node0->apply_velocity_constraint(0, 0.02);
+    node0->apply_velocity_constraint(1, 0.03);
+    node0->apply_velocity_constraint(2, 0.04);
 
     auto cell = std::make_shared<mpm::Cell<Dim>>(cell_id, Nnodes, shapefn);
 
@@ -707,10 +704,9 @@ TEST_CASE("Bingham is checked in 3D", "[material][bingham][3D]") {
     std::shared_ptr<mpm::Element<Dim>> shapefn =
         Factory<mpm::Element<Dim>>::instance()->create("ED3H8");
 
-    node0->assign_velocity_constraint(0, 2);
-    node0->assign_velocity_constraint(1, 3);
-    node0->assign_velocity_constraint(2, 4);
-    node0->apply_velocity_constraints();
+    node0->apply_velocity_constraint(0, 2);
+    node0->apply_velocity_constraint(1, 3);
+    node0->apply_velocity_constraint(2, 4);
 
     auto cell = std::make_shared<mpm::Cell<Dim>>(cell_id, Nnodes, shapefn);
 
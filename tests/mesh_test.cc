@@ -1,5 +1,10 @@
+#include <algorithm>
+#include <atomic>
+#include <fstream>
 #include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
 
 #include "Eigen/Dense"
 #include "catch.hpp"
@@ -226,6 +231,15 @@ TEST_CASE("Mesh is checked for 2D case", "[mesh][2D]") {
         REQUIRE(check_coords[i] == Approx(1.).epsilon(Tolerance));
     }
 
+    // Find active nodes and check only node2 is listed
+    mesh->find_active_nodes();
+    REQUIRE(mesh->nactive_nodes() == 1);
+
+    // Check iterate over active nodes
+    mesh->iterate_over_active_nodes(std::bind(
+        &mpm::NodeBase<Dim>::assign_status, std::placeholders::_1, false));
+    REQUIRE(node2->status() == false);
+
     // Check iterate over functionality
     mesh->iterate_over_nodes(std::bind(&mpm::NodeBase<Dim>::assign_coordinates,
                                        std::placeholders::_1, coordinates));
@@ -385,6 +399,55 @@ TEST_CASE("Mesh is checked for 2D case", "[mesh][2D]") {
     REQUIRE(particle1->cell_id() == 0);
     // Check location of particle 2
     REQUIRE(particle2->cell_id() == 0);
+
+    // Check particle ids in cell are rebuilt from particle locations
+    REQUIRE(cell1->nparticles() == 2);
+    auto ids = mesh->cell_particles(cell1->id());
+    REQUIRE(ids.size() == 2);
+    REQUIRE(ids[0] == particle1->id());
+    REQUIRE(ids[1] == particle2->id());
+    // Particles update the number of particles in their cell
+    particle1->remove_cell();
+    REQUIRE(cell1->nparticles() == 1);
+    mesh->build_cell_particles();
+    ids = mesh->cell_particles(cell1->id());
+    REQUIRE(ids.size() == 1);
+    REQUIRE(ids[0] == particle2->id());
+    REQUIRE(particle1->assign_cell(cell1) == true);
+    REQUIRE(cell1->nparticles() == 2);
+    // Removed particles are removed from their cell
+    REQUIRE(mesh->remove_particle(particle2) == true);
+    REQUIRE(cell1->nparticles() == 1);
+    ids = mesh->cell_particles(cell1->id());
+    REQUIRE(ids.size() == 1);
+    REQUIRE(ids[0] == particle1->id());
+
+    // Check cell with particles is listed as active
+    REQUIRE(mesh->nactive_cells() == 1);
+
+    // Activate nodes of cells with particles
+    mesh->activate_nodes();
+    // Check all nodes of the cell are active
+    REQUIRE(mesh->nactive_nodes() == 4);
+
+    // Apply velocity constraint to a node set on active nodes
+    REQUIRE(mesh->assign_velocity_constraints({0, 1}, 0, 5.) == true);
+    REQUIRE(mesh->nvelocity_constraints() == 2);
+    mesh->apply_velocity_constraints();
+    REQUIRE(node0->velocity(0)(0) == Approx(5.).epsilon(Tolerance));
+    REQUIRE(node1->velocity(0)(0) == Approx(5.).epsilon(Tolerance));
+    REQUIRE(node0->acceleration(0)(0) == Approx(0.).epsilon(Tolerance));
+
+    // Update mass of an active node
+    const unsigned phase = 0;
+    node0->update_mass(true, phase, 10.);
+    REQUIRE(node0->mass(phase) == Approx(10.).epsilon(Tolerance));
+
+    // Initialise active nodes and check they are reset
+    mesh->initialise_active_nodes();
+    REQUIRE(mesh->nactive_nodes() == 0);
+    REQUIRE(node0->mass(phase) == Approx(0.).epsilon(Tolerance));
+    REQUIRE(node0->status() == false);
   }
 
   //! Check create nodes and cells in a mesh
@@ -430,7 +493,7 @@ TEST_CASE("Mesh is checked for 2D case", "[mesh][2D]") {
       // Check if mesh has added nodes
       REQUIRE(mesh->nnodes() == coordinates.size());
       // Try again this shouldn't add more coordinates
-      mesh->create_nodes(gnid, node_type, coordinates);
+      REQUIRE(mesh->create_nodes(gnid, node_type, coordinates) == false);
       // Check if mesh has added nodes
       REQUIRE(mesh->nnodes() == coordinates.size());
       // Clear coordinates and try creating a list of nodes with an empty list
@@ -476,6 +539,62 @@ TEST_CASE("Mesh is checked for 2D case", "[mesh][2D]") {
         mesh->create_cells(gcid, element, cells);
         REQUIRE(mesh->ncells() == ncells);
 
+        SECTION("Check generation of particles") {
+          // Particle type
+          const std::string particle_type = "P2D";
+          // Check invalid number of quadrature points and cell ids
+          REQUIRE(mesh->generate_particles(0, particle_type, 4, {}) == false);
+          REQUIRE(mesh->generate_particles(0, particle_type, 2, {5}) ==
+                  false);
+          REQUIRE(mesh->nparticles() == 0);
+
+          // Check cells in a box
+          Eigen::Matrix<double, Dim, 1> min, max;
+          min << 0.6, 0.;
+          max << 1.0, 0.5;
+          REQUIRE(mesh->cell_ids_in_box(min, max) ==
+                  std::vector<mpm::Index>{1});
+
+          // Generate 2 points per direction in all cells
+          REQUIRE(mesh->generate_particles(0, particle_type, 2, {}) == true);
+          REQUIRE(mesh->nparticles() == 8);
+          // Check particle ids are not reused
+          REQUIRE(mesh->generate_particles(0, particle_type, 1, {1}) ==
+                  false);
+          // Generate 3 points per direction in cell 1
+          REQUIRE(mesh->generate_particles(100, particle_type, 3, {1}) ==
+                  true);
+          REQUIRE(mesh->nparticles() == 17);
+
+          // Volumes of particles add up to the volume of cells
+          std::mutex volume_mutex;
+          double volume = 0.;
+          mesh->iterate_over_particles(
+              [&](std::shared_ptr<mpm::ParticleBase<Dim>> particle) {
+                std::lock_guard<std::mutex> guard(volume_mutex);
+                volume += particle->volume();
+              });
+          REQUIRE(volume == Approx(0.5 * 1.5).epsilon(Tolerance));
+
+          // Particles are assigned their cell and the reference location of
+          // their quadrature point without a search
+          std::atomic<bool> located{true};
+          mesh->iterate_over_particles(
+              [&](std::shared_ptr<mpm::ParticleBase<Dim>> particle) {
+                const Eigen::Matrix<double, Dim, 1> xi =
+                    particle->reference_location();
+                if (particle->cell_id() ==
+                        std::numeric_limits<mpm::Index>::max() ||
+                    !particle->compute_reference_location() ||
+                    (particle->reference_location() - xi).norm() > 1.E-9)
+                  located = false;
+              });
+          REQUIRE(located == true);
+          mesh->build_cell_particles();
+          mesh->find_active_cells();
+          REQUIRE(mesh->nactive_cells() == 2);
+        }
+
         SECTION("Check creation of particles") {
           // Vector of particle coordinates
           std::vector<Eigen::Matrix<double, Dim, 1>> coordinates;
@@ -521,7 +640,8 @@ TEST_CASE("Mesh is checked for 2D case", "[mesh][2D]") {
             // Check if mesh has added particles
             REQUIRE(mesh->nparticles() == coordinates.size());
             // Try again this shouldn't add more coordinates
-            mesh->create_particles(gpid, particle_type, coordinates);
+            REQUIRE(mesh->create_particles(gpid, particle_type, coordinates) ==
+                    false);
             // Check if mesh has added particles
             REQUIRE(mesh->nparticles() == coordinates.size());
             // Clear coordinates and try creating a list of particles with
@@ -532,9 +652,23 @@ TEST_CASE("Mesh is checked for 2D case", "[mesh][2D]") {
             mesh->create_particles(gpid, particle_type, coordinates);
             REQUIRE(mesh->nparticles() == nparticles);
 
+            // Particles outside the mesh are not added
+            const auto outside = Eigen::Matrix<double, Dim, 1>::Constant(100.);
+            coordinates.emplace_back(outside);
+            coordinates.emplace_back(particle);
+            REQUIRE(mesh->create_particles(100, particle_type, coordinates) ==
+                    false);
+            REQUIRE(mesh->nparticles() == ++nparticles);
+            coordinates.clear();
+
             const unsigned phase = 0;
             // Particles coordinates
-            REQUIRE(mesh->particle_coordinates().size() == mesh->nparticles());
+            const auto particle_coordinates = mesh->particle_coordinates();
+            REQUIRE(particle_coordinates.size() == mesh->nparticles());
+            // Coordinates are padded to 3 components
+            for (unsigned i = 0; i < 3; ++i)
+              REQUIRE(particle_coordinates.back()(i) ==
+                      Approx(i < Dim ? particle(i) : 0.).epsilon(Tolerance));
             // Particle stresses
             REQUIRE(mesh->particle_stresses(phase).size() ==
                     mesh->nparticles());
@@ -546,6 +680,8 @@ TEST_CASE("Mesh is checked for 2D case", "[mesh][2D]") {
 
               // Should find all particles in mesh
               REQUIRE(particles.size() == 0);
+              // Check both cells have particles
+              REQUIRE(mesh->nactive_cells() == 2);
 
               // Create particle 100
               Eigen::Vector2d coords;
@@ -569,6 +705,435 @@ TEST_CASE("Mesh is checked for 2D case", "[mesh][2D]") {
             SECTION("Write particles HDF5") {
               REQUIRE(mesh->write_particles_hdf5(0, "particles-2d.h5") == true);
             }
+
+            // Test HDF5 with one dataset per field
+            SECTION("Write and read particles HDF5 columns") {
+              const auto nparticles = mesh->nparticles();
+
+              // Distinct masses and stresses of each particle
+              mpm::HDF5ParticleColumns expected;
+              mesh->gather_particles_hdf5(0, &expected);
+              std::map<mpm::Index, mpm::HDF5Particle> records;
+              for (unsigned i = 0; i < nparticles; ++i) {
+                expected.masses[i] = 1. + expected.ids[i];
+                for (unsigned j = 0; j < 6; ++j)
+                  expected.stresses[i * 6 + j] = 10. * expected.ids[i] + j;
+                records[expected.ids[i]] = expected.particle(i);
+              }
+              mesh->iterate_over_particles(
+                  [&records](std::shared_ptr<mpm::ParticleBase<Dim>> particle) {
+                    particle->initialise_particle(records.at(particle->id()));
+                  });
+
+              mpm::HDF5Options options;
+              options.columns = true;
+              options.chunk_size = 1;
+              options.compression = 4;
+              options.shuffle = true;
+              REQUIRE(mesh->write_particles_hdf5(
+                          0, "particles-columns-2d.h5", options) == true);
+
+              // Check datasets
+              hid_t file_id = H5Fopen("particles-columns-2d.h5",
+                                      H5F_ACC_RDONLY, H5P_DEFAULT);
+              REQUIRE(file_id >= 0);
+              auto dims = mpm::hdf5_dataset_dims(file_id, "coordinates");
+              REQUIRE(dims.first == nparticles);
+              REQUIRE(dims.second == Dim);
+              dims = mpm::hdf5_dataset_dims(file_id, "stress");
+              REQUIRE(dims.first == nparticles);
+              REQUIRE(dims.second == 6);
+
+              // Check values of each field
+              std::vector<mpm::Index> ids(nparticles);
+              std::vector<double> masses(nparticles);
+              std::vector<double> coordinates(nparticles * Dim);
+              std::vector<double> stresses(nparticles * 6);
+              REQUIRE(mpm::read_hdf5_dataset(file_id, "id", H5T_NATIVE_ULLONG,
+                                             ids.data()) == true);
+              REQUIRE(mpm::read_hdf5_dataset(file_id, "mass",
+                                             H5T_NATIVE_DOUBLE,
+                                             masses.data()) == true);
+              REQUIRE(mpm::read_hdf5_dataset(file_id, "coordinates",
+                                             H5T_NATIVE_DOUBLE,
+                                             coordinates.data()) == true);
+              REQUIRE(mpm::read_hdf5_dataset(file_id, "stress",
+                                             H5T_NATIVE_DOUBLE,
+                                             stresses.data()) == true);
+              REQUIRE(ids == expected.ids);
+              for (unsigned i = 0; i < nparticles; ++i)
+                REQUIRE(masses[i] ==
+                        Approx(expected.masses[i]).epsilon(Tolerance));
+              for (unsigned i = 0; i < nparticles * Dim; ++i)
+                REQUIRE(coordinates[i] ==
+                        Approx(expected.coordinates[i]).epsilon(Tolerance));
+              for (unsigned i = 0; i < nparticles * 6; ++i)
+                REQUIRE(stresses[i] ==
+                        Approx(expected.stresses[i]).epsilon(Tolerance));
+
+              // Check chunks and filters of a dataset
+              hid_t dataset_id = H5Dopen(file_id, "stress", H5P_DEFAULT);
+              hid_t plist_id = H5Dget_create_plist(dataset_id);
+              REQUIRE(H5Pget_layout(plist_id) == H5D_CHUNKED);
+              hsize_t chunk[2];
+              REQUIRE(H5Pget_chunk(plist_id, 2, chunk) == 2);
+              REQUIRE(chunk[0] == options.chunk_size);
+              std::vector<H5Z_filter_t> filters;
+              for (int i = 0; i < H5Pget_nfilters(plist_id); ++i) {
+                unsigned flags, config;
+                std::size_t nvalues = 1;
+                unsigned values[1];
+                filters.emplace_back(H5Pget_filter2(plist_id, i, &flags,
+                                                    &nvalues, values, 0,
+                                                    nullptr, &config));
+              }
+              const std::vector<H5Z_filter_t> shuffle_deflate = {
+                  H5Z_FILTER_SHUFFLE, H5Z_FILTER_DEFLATE};
+              REQUIRE(filters == shuffle_deflate);
+              H5Pclose(plist_id);
+              H5Dclose(dataset_id);
+              H5Fclose(file_id);
+
+              // Read particles back
+              REQUIRE(mesh->read_particles_hdf5(
+                          0, "particles-columns-2d.h5") == true);
+              REQUIRE(mesh->nparticles() == nparticles);
+              mpm::HDF5ParticleColumns read;
+              mesh->gather_particles_hdf5(0, &read);
+              REQUIRE(read.ids == expected.ids);
+              for (unsigned i = 0; i < nparticles * 6; ++i)
+                REQUIRE(read.stresses[i] ==
+                        Approx(expected.stresses[i]).epsilon(Tolerance));
+            }
+
+            // Test partitioned HDF5 with a master file
+            SECTION("Write and read partitioned particles HDF5") {
+              const auto nparticles = mesh->nparticles();
+              mpm::HDF5Options options;
+              options.partitions = 3;
+              options.writers = 2;
+              REQUIRE(mesh->write_particles_hdf5(
+                          0, "particles-partitioned-2d.h5", options) == true);
+
+              // Check partition files and virtual datasets
+              for (unsigned i = 0; i < options.partitions; ++i)
+                REQUIRE(std::ifstream("particles-partitioned-2d.p" +
+                                      std::to_string(i) + ".h5")
+                            .good());
+              hid_t file_id = H5Fopen("particles-partitioned-2d.h5",
+                                      H5F_ACC_RDONLY, H5P_DEFAULT);
+              REQUIRE(file_id >= 0);
+              auto dims = mpm::hdf5_dataset_dims(file_id, "coordinates");
+              REQUIRE(dims.first == nparticles);
+              REQUIRE(dims.second == Dim);
+              std::vector<mpm::Index> ids(nparticles);
+              mpm::read_hdf5_dataset(file_id, "id", H5T_NATIVE_ULLONG,
+                                     ids.data());
+              H5Fclose(file_id);
+              std::sort(ids.begin(), ids.end());
+              REQUIRE(std::unique(ids.begin(), ids.end()) == ids.end());
+
+              // Read particles back through the master file
+              REQUIRE(mesh->read_particles_hdf5(
+                          0, "particles-partitioned-2d.h5") == true);
+              REQUIRE(mesh->nparticles() == nparticles);
+            }
+
+            // Test creation of particles from HDF5 in a mesh without them
+            SECTION("Create particles from HDF5") {
+              const auto nparticles = mesh->nparticles();
+              const auto coordinates = mesh->particle_coordinates();
+              mpm::HDF5Options options;
+              options.columns = true;
+              REQUIRE(mesh->write_particles_hdf5(
+                          0, "particles-create-2d.h5") == true);
+              REQUIRE(mesh->write_particles_hdf5(
+                          0, "particles-create-columns-2d.h5", options) ==
+                      true);
+
+              for (const std::string filename :
+                   {"particles-create-2d.h5",
+                    "particles-create-columns-2d.h5"}) {
+                // Mesh with the same cells and no particles
+                auto created = std::make_shared<mpm::Mesh<Dim>>(1);
+                std::mutex cells_mutex;
+                std::vector<std::shared_ptr<mpm::Cell<Dim>>> mesh_cells;
+                mesh->iterate_over_cells(
+                    [&](std::shared_ptr<mpm::Cell<Dim>> cell) {
+                      std::lock_guard<std::mutex> guard(cells_mutex);
+                      mesh_cells.emplace_back(cell);
+                    });
+                // Cells are shared, particles are added to them again
+                for (const auto& cell : mesh_cells) created->add_cell(cell);
+
+                REQUIRE(created->create_particles_hdf5("P2D", filename) ==
+                        true);
+                REQUIRE(created->nparticles() == nparticles);
+                const auto created_coordinates =
+                    created->particle_coordinates();
+                for (unsigned i = 0; i < nparticles; ++i)
+                  for (unsigned j = 0; j < 3; ++j)
+                    REQUIRE(created_coordinates[i](j) ==
+                            Approx(coordinates[i](j)).epsilon(Tolerance));
+                // Particles are located in cells
+                REQUIRE(created->locate_particles_mesh().size() == 0);
+
+                // Particle ids are already in the mesh
+                REQUIRE(created->create_particles_hdf5("P2D", filename) ==
+                        false);
+                REQUIRE(created->nparticles() == nparticles);
+              }
+
+              // Missing file
+              auto created = std::make_shared<mpm::Mesh<Dim>>(1);
+              REQUIRE(created->create_particles_hdf5(
+                          "P2D", "particles-missing-2d.h5") == false);
+            }
+
+            // Test cache of the preprocessed mesh and particle cells
+            SECTION("Write and read mesh cache") {
+              const auto nparticles = mesh->nparticles();
+              const std::uint64_t key = mpm::binary::cache_key(
+                  {"missing-mesh-2d.txt"}, "mesh-cache-2d");
+              REQUIRE(key != mpm::binary::cache_key({"missing-mesh-2d.txt"},
+                                                    "mesh-cache-3d"));
+              const std::vector<std::tuple<mpm::Index, unsigned, double>>
+                  constraints{std::make_tuple(0, 1, 0.5)};
+              REQUIRE(mesh->write_cache("mesh-cache-2d.bin", key, {}, {},
+                                        constraints) == true);
+              REQUIRE(mpm::binary::valid_cache("mesh-cache-2d.bin", Dim,
+                                               key) == true);
+              REQUIRE(mpm::binary::valid_cache("mesh-cache-2d.bin", Dim,
+                                               key + 1) == false);
+              REQUIRE(mpm::binary::valid_cache("missing-mesh-cache-2d.bin",
+                                               Dim, key) == false);
+
+              // Mesh with the same cells and no particles
+              auto restored = std::make_shared<mpm::Mesh<Dim>>(1);
+              std::mutex cells_mutex;
+              std::vector<std::shared_ptr<mpm::Cell<Dim>>> mesh_cells;
+              mesh->iterate_over_cells(
+                  [&](std::shared_ptr<mpm::Cell<Dim>> cell) {
+                    std::lock_guard<std::mutex> guard(cells_mutex);
+                    mesh_cells.emplace_back(cell);
+                  });
+              for (const auto& cell : mesh_cells) restored->add_cell(cell);
+
+              REQUIRE(restored->read_cache_particles("mesh-cache-2d.bin",
+                                                     particle_type) == true);
+              REQUIRE(restored->nparticles() == nparticles);
+              REQUIRE(restored->nactive_cells() == 2);
+              const auto expected = mesh->particle_coordinates();
+              const auto coordinates = restored->particle_coordinates();
+              for (unsigned i = 0; i < nparticles; ++i)
+                for (unsigned j = 0; j < Dim; ++j)
+                  REQUIRE(coordinates[i](j) ==
+                          Approx(expected[i](j)).epsilon(Tolerance));
+
+              // Particles are only added to a mesh without particles
+              REQUIRE(restored->read_cache_particles("mesh-cache-2d.bin",
+                                                     particle_type) == false);
+            }
+
+            // Test checkpoint of the state of particles
+            SECTION("Write and read checkpoint") {
+              const auto nparticles = mesh->nparticles();
+
+              // Distinct state of each particle with a material
+              unsigned mid = 1;
+              auto material =
+                  Factory<mpm::Material<Dim>, unsigned>::instance()->create(
+                      "LinearElastic2D", std::move(mid));
+              Json jmaterial;
+              jmaterial["density"] = 1000.;
+              jmaterial["youngs_modulus"] = 1.0E+7;
+              jmaterial["poisson_ratio"] = 0.3;
+              material->properties(jmaterial);
+              const std::map<unsigned, std::shared_ptr<mpm::Material<Dim>>>
+                  materials = {{1, material}};
+              mesh->iterate_over_particles(
+                  [&material](
+                      std::shared_ptr<mpm::ParticleBase<Dim>> particle) {
+                    const auto id = particle->id();
+                    mpm::HDF5Particle state;
+                    state.id = id;
+                    state.mass = 1. + id;
+                    state.coord_x = particle->coordinates()(0);
+                    state.coord_y = particle->coordinates()(1);
+                    state.coord_z = particle->coordinates()(Dim - 1);
+                    state.velocity_x = 0.1 * id;
+                    state.velocity_y = -0.2 * id;
+                    state.velocity_z = 0.3 * id;
+                    state.stress_xx = 10. * id;
+                    state.stress_yy = 11. * id;
+                    state.stress_zz = 12. * id;
+                    state.tau_xy = 13. * id;
+                    state.tau_yz = 14. * id;
+                    state.tau_xz = 15. * id;
+                    state.strain_xx = 0.01 * id;
+                    state.strain_yy = 0.02 * id;
+                    state.strain_zz = 0.03 * id;
+                    state.gamma_xy = 0.04 * id;
+                    state.gamma_yz = 0.05 * id;
+                    state.gamma_xz = 0.06 * id;
+                    state.epsilon_v = 0.07 * id;
+                    particle->initialise_particle(state);
+                    particle->assign_volume(2. + id);
+                    particle->assign_material(material);
+                  });
+
+              mpm::binary::Checkpoint checkpoint;
+              checkpoint.step = 5;
+              checkpoint.time = 0.05;
+              checkpoint.uuid = "mesh-checkpoint-2d";
+              REQUIRE(mesh->write_checkpoint(0, "checkpoint-2d.bin",
+                                             checkpoint) == true);
+
+              // Mesh with the same cells and no particles
+              auto restored = std::make_shared<mpm::Mesh<Dim>>(1);
+              std::mutex cells_mutex;
+              std::vector<std::shared_ptr<mpm::Cell<Dim>>> mesh_cells;
+              mesh->iterate_over_cells(
+                  [&](std::shared_ptr<mpm::Cell<Dim>> cell) {
+                    std::lock_guard<std::mutex> guard(cells_mutex);
+                    mesh_cells.emplace_back(cell);
+                  });
+              for (const auto& cell : mesh_cells) restored->add_cell(cell);
+
+              mpm::binary::Checkpoint read;
+              REQUIRE(restored->read_checkpoint(0, "checkpoint-2d.bin",
+                                                particle_type, materials,
+                                                &read) == true);
+              REQUIRE(read.step == 5);
+              REQUIRE(read.time == Approx(0.05).epsilon(Tolerance));
+              REQUIRE(read.uuid == "mesh-checkpoint-2d");
+
+              // Particles are restored in order and in their cells
+              REQUIRE(restored->nparticles() == nparticles);
+              REQUIRE(restored->nactive_cells() == 2);
+              const auto expected = mesh->particle_coordinates();
+              const auto coordinates = restored->particle_coordinates();
+              for (unsigned i = 0; i < nparticles; ++i)
+                for (unsigned j = 0; j < Dim; ++j)
+                  REQUIRE(coordinates[i](j) ==
+                          Approx(expected[i](j)).epsilon(Tolerance));
+              restored->iterate_over_particles(
+                  [](std::shared_ptr<mpm::ParticleBase<Dim>> particle) {
+                    REQUIRE(particle->cell_id() !=
+                            std::numeric_limits<mpm::Index>::max());
+                  });
+
+              // State of each particle is restored field by field
+              std::mutex particles_mutex;
+              std::map<mpm::Index, std::shared_ptr<mpm::ParticleBase<Dim>>>
+                  originals, restored_particles;
+              mesh->iterate_over_particles(
+                  [&](std::shared_ptr<mpm::ParticleBase<Dim>> particle) {
+                    std::lock_guard<std::mutex> guard(particles_mutex);
+                    originals[particle->id()] = particle;
+                  });
+              restored->iterate_over_particles(
+                  [&](std::shared_ptr<mpm::ParticleBase<Dim>> particle) {
+                    std::lock_guard<std::mutex> guard(particles_mutex);
+                    restored_particles[particle->id()] = particle;
+                  });
+              REQUIRE(restored_particles.size() == originals.size());
+              for (const auto& original : originals) {
+                const auto& particle = restored_particles.at(original.first);
+                const auto& expected_particle = original.second;
+                REQUIRE(particle->cell_id() == expected_particle->cell_id());
+                REQUIRE(particle->material_id() == 1);
+                REQUIRE(particle->mass(0) ==
+                        Approx(expected_particle->mass(0)).epsilon(Tolerance));
+                REQUIRE(particle->volume() ==
+                        Approx(expected_particle->volume()).epsilon(Tolerance));
+                REQUIRE(particle->volumetric_strain_centroid(0) ==
+                        Approx(expected_particle->volumetric_strain_centroid(0))
+                            .epsilon(Tolerance));
+                for (unsigned j = 0; j < Dim; ++j) {
+                  REQUIRE(particle->velocity(0)(j) ==
+                          Approx(expected_particle->velocity(0)(j))
+                              .epsilon(Tolerance));
+                  REQUIRE(particle->reference_location()(j) ==
+                          Approx(expected_particle->reference_location()(j))
+                              .epsilon(Tolerance));
+                }
+                for (unsigned j = 0; j < 6; ++j) {
+                  REQUIRE(particle->stress(0)(j) ==
+                          Approx(expected_particle->stress(0)(j))
+                              .epsilon(Tolerance));
+                  REQUIRE(particle->strain(0)(j) ==
+                          Approx(expected_particle->strain(0)(j))
+                              .epsilon(Tolerance));
+                }
+              }
+
+              // Particles are only added to a mesh without particles
+              REQUIRE(restored->read_checkpoint(0, "checkpoint-2d.bin",
+                                                particle_type, materials,
+                                                &read) == false);
+              REQUIRE(restored->nparticles() == nparticles);
+            }
+
+            // Test selection of particles and fields for HDF5 output
+            SECTION("Gather selected particles and fields") {
+              const auto nparticles = mesh->nparticles();
+              mpm::HDF5Selection selection;
+              selection.fields =
+                  mpm::HDF5Field::Coordinates | mpm::HDF5Field::Stress;
+
+              // Only the requested fields are gathered
+              mpm::HDF5ParticleColumns columns;
+              mesh->gather_particles_hdf5(0, &columns, selection);
+              REQUIRE(columns.size() == nparticles);
+              REQUIRE(columns.coordinates.size() == nparticles * Dim);
+              REQUIRE(columns.stresses.size() == nparticles * 6);
+              REQUIRE(columns.masses.empty());
+              REQUIRE(columns.velocities.empty());
+
+              // Region around the particles of cell 0
+              selection.regions.emplace_back(std::make_pair(
+                  std::vector<double>{0., 0.}, std::vector<double>{0.5, 0.5}));
+              mesh->gather_particles_hdf5(0, &columns, selection);
+              REQUIRE(columns.size() == 4);
+              for (unsigned i = 0; i < columns.size(); ++i)
+                REQUIRE(columns.coordinates[i * Dim] <= 0.5);
+
+              // Decimation by stride of ids
+              selection.stride = 2;
+              mesh->gather_particles_hdf5(0, &columns, selection);
+              REQUIRE(columns.size() == 2);
+              for (unsigned i = 0; i < columns.size(); ++i)
+                REQUIRE(columns.ids[i] % 2 == 0);
+
+              // Decimation by a set of ids
+              selection.regions.clear();
+              selection.stride = 1;
+              selection.ids = {1, 5, 101};
+              mesh->gather_particles_hdf5(0, &columns, selection);
+              REQUIRE(columns.size() == 3);
+
+              // A subset of fields is written as datasets
+              REQUIRE(mpm::write_hdf5_particles("particles-selected-2d.h5",
+                                                columns,
+                                                mpm::HDF5Options()) == true);
+              hid_t file_id = H5Fopen("particles-selected-2d.h5",
+                                      H5F_ACC_RDONLY, H5P_DEFAULT);
+              REQUIRE(file_id >= 0);
+              REQUIRE(H5Lexists(file_id, "table", H5P_DEFAULT) == 0);
+              REQUIRE(H5Lexists(file_id, "mass", H5P_DEFAULT) == 0);
+              REQUIRE(mpm::hdf5_dataset_dims(file_id, "stress").first == 3);
+              mpm::HDF5ParticleColumns read_columns;
+              mpm::read_hdf5_particle_columns(file_id, &read_columns);
+              REQUIRE(read_columns.fields == selection.fields);
+              REQUIRE(read_columns.ids == columns.ids);
+              REQUIRE(read_columns.coordinates == columns.coordinates);
+              H5Fclose(file_id);
+
+              // Resume needs all fields
+              REQUIRE(mesh->read_particles_hdf5(
+                          0, "particles-selected-2d.h5") == false);
+            }
           }
         }
         // Test assign velocity constraints
@@ -584,10 +1149,16 @@ TEST_CASE("Mesh is checked for 2D case", "[mesh][2D]") {
 
           REQUIRE(mesh->assign_velocity_constraints(velocity_constraints) ==
                   true);
+          REQUIRE(mesh->nvelocity_constraints() == 4);
           // When constraints fail
           velocity_constraints.emplace_back(std::make_tuple(3, 2, 0.0));
           REQUIRE(mesh->assign_velocity_constraints(velocity_constraints) ==
                   false);
+          REQUIRE(mesh->nvelocity_constraints() == 4);
+
+          // Node set constraints retain the first constraint on a direction
+          REQUIRE(mesh->assign_velocity_constraints({0, 1}, 0, 2.5) == true);
+          REQUIRE(mesh->nvelocity_constraints() == 5);
         }
       }
     }
@@ -785,6 +1356,15 @@ TEST_CASE("Mesh is checked for 3D case", "[mesh][3D]") {
         REQUIRE(check_coords[i] == Approx(7.).epsilon(Tolerance));
     }
 
+    // Find active nodes and check only node2 is listed
+    mesh->find_active_nodes();
+    REQUIRE(mesh->nactive_nodes() == 1);
+
+    // Check iterate over active nodes
+    mesh->iterate_over_active_nodes(std::bind(
+        &mpm::NodeBase<Dim>::assign_status, std::placeholders::_1, false));
+    REQUIRE(node2->status() == false);
+
     // Check iterate over functionality
     mesh->iterate_over_nodes(std::bind(&mpm::NodeBase<Dim>::assign_coordinates,
                                        std::placeholders::_1, coordinates));
@@ -915,6 +1495,11 @@ TEST_CASE("Mesh is checked for 3D case", "[mesh][3D]") {
 
     REQUIRE(cell1->nnodes() == 8);
 
+    // Add nodes to mesh
+    for (const auto& node :
+         {node0, node1, node2, node3, node4, node5, node6, node7})
+      REQUIRE(mesh->add_node(node) == true);
+
     // Compute cell volume
     cell1->compute_volume();
 
@@ -949,6 +1534,55 @@ TEST_CASE("Mesh is checked for 3D case", "[mesh][3D]") {
     REQUIRE(particle1->cell_id() == 0);
     // Check location of particle 2
     REQUIRE(particle2->cell_id() == 0);
+
+    // Check particle ids in cell are rebuilt from particle locations
+    REQUIRE(cell1->nparticles() == 2);
+    auto ids = mesh->cell_particles(cell1->id());
+    REQUIRE(ids.size() == 2);
+    REQUIRE(ids[0] == particle1->id());
+    REQUIRE(ids[1] == particle2->id());
+    // Particles update the number of particles in their cell
+    particle1->remove_cell();
+    REQUIRE(cell1->nparticles() == 1);
+    mesh->build_cell_particles();
+    ids = mesh->cell_particles(cell1->id());
+    REQUIRE(ids.size() == 1);
+    REQUIRE(ids[0] == particle2->id());
+    REQUIRE(particle1->assign_cell(cell1) == true);
+    REQUIRE(cell1->nparticles() == 2);
+    // Removed particles are removed from their cell
+    REQUIRE(mesh->remove_particle(particle2) == true);
+    REQUIRE(cell1->nparticles() == 1);
+    ids = mesh->cell_particles(cell1->id());
+    REQUIRE(ids.size() == 1);
+    REQUIRE(ids[0] == particle1->id());
+
+    // Check cell with particles is listed as active
+    REQUIRE(mesh->nactive_cells() == 1);
+
+    // Activate nodes of cells with particles
+    mesh->activate_nodes();
+    // Check all nodes of the cell are active
+    REQUIRE(mesh->nactive_nodes() == 8);
+
+    // Apply velocity constraint to a node set on active nodes
+    REQUIRE(mesh->assign_velocity_constraints({0, 1}, 0, 5.) == true);
+    REQUIRE(mesh->nvelocity_constraints() == 2);
+    mesh->apply_velocity_constraints();
+    REQUIRE(node0->velocity(0)(0) == Approx(5.).epsilon(Tolerance));
+    REQUIRE(node1->velocity(0)(0) == Approx(5.).epsilon(Tolerance));
+    REQUIRE(node0->acceleration(0)(0) == Approx(0.).epsilon(Tolerance));
+
+    // Update mass of an active node
+    const unsigned phase = 0;
+    node0->update_mass(true, phase, 10.);
+    REQUIRE(node0->mass(phase) == Approx(10.).epsilon(Tolerance));
+
+    // Initialise active nodes and check they are reset
+    mesh->initialise_active_nodes();
+    REQUIRE(mesh->nactive_nodes() == 0);
+    REQUIRE(node0->mass(phase) == Approx(0.).epsilon(Tolerance));
+    REQUIRE(node0->status() == false);
   }
 
   //! Check create nodes and cells in a mesh
@@ -1012,7 +1646,7 @@ TEST_CASE("Mesh is checked for 3D case", "[mesh][3D]") {
       // Check if mesh has added nodes
       REQUIRE(mesh->nnodes() == coordinates.size());
       // Try again this shouldn't add more coordinates
-      mesh->create_nodes(gnid, node_type, coordinates);
+      REQUIRE(mesh->create_nodes(gnid, node_type, coordinates) == false);
       // Check if mesh has added nodes
       REQUIRE(mesh->nnodes() == coordinates.size());
       // Clear coordinates and try creating a list of nodes with an empty list
@@ -1058,6 +1692,62 @@ TEST_CASE("Mesh is checked for 3D case", "[mesh][3D]") {
         mesh->create_cells(gcid, element, cells);
         REQUIRE(mesh->ncells() == ncells);
 
+        SECTION("Check generation of particles") {
+          // Particle type
+          const std::string particle_type = "P3D";
+          // Check invalid number of quadrature points and cell ids
+          REQUIRE(mesh->generate_particles(0, particle_type, 4, {}) == false);
+          REQUIRE(mesh->generate_particles(0, particle_type, 2, {5}) ==
+                  false);
+          REQUIRE(mesh->nparticles() == 0);
+
+          // Check cells in a box
+          Eigen::Matrix<double, Dim, 1> min, max;
+          min << 0.6, 0., 0.;
+          max << 1.0, 0.5, 0.5;
+          REQUIRE(mesh->cell_ids_in_box(min, max) ==
+                  std::vector<mpm::Index>{1});
+
+          // Generate 2 points per direction in all cells
+          REQUIRE(mesh->generate_particles(0, particle_type, 2, {}) == true);
+          REQUIRE(mesh->nparticles() == 16);
+          // Check particle ids are not reused
+          REQUIRE(mesh->generate_particles(0, particle_type, 1, {1}) ==
+                  false);
+          // Generate 3 points per direction in cell 1
+          REQUIRE(mesh->generate_particles(100, particle_type, 3, {1}) ==
+                  true);
+          REQUIRE(mesh->nparticles() == 43);
+
+          // Volumes of particles add up to the volume of cells
+          std::mutex volume_mutex;
+          double volume = 0.;
+          mesh->iterate_over_particles(
+              [&](std::shared_ptr<mpm::ParticleBase<Dim>> particle) {
+                std::lock_guard<std::mutex> guard(volume_mutex);
+                volume += particle->volume();
+              });
+          REQUIRE(volume == Approx(0.25 * 1.5).epsilon(Tolerance));
+
+          // Particles are assigned their cell and the reference location of
+          // their quadrature point without a search
+          std::atomic<bool> located{true};
+          mesh->iterate_over_particles(
+              [&](std::shared_ptr<mpm::ParticleBase<Dim>> particle) {
+                const Eigen::Matrix<double, Dim, 1> xi =
+                    particle->reference_location();
+                if (particle->cell_id() ==
+                        std::numeric_limits<mpm::Index>::max() ||
+                    !particle->compute_reference_location() ||
+                    (particle->reference_location() - xi).norm() > 1.E-9)
+                  located = false;
+              });
+          REQUIRE(located == true);
+          mesh->build_cell_particles();
+          mesh->find_active_cells();
+          REQUIRE(mesh->nactive_cells() == 2);
+        }
+
         SECTION("Check creation of particles") {
           // Vector of particle coordinates
           std::vector<Eigen::Matrix<double, Dim, 1>> coordinates;
@@ -1127,7 +1817,8 @@ TEST_CASE("Mesh is checked for 3D case", "[mesh][3D]") {
             // Check if mesh has added particles
             REQUIRE(mesh->nparticles() == coordinates.size());
             // Try again this shouldn't add more coordinates
-            mesh->create_particles(gpid, particle_type, coordinates);
+            REQUIRE(mesh->create_particles(gpid, particle_type, coordinates) ==
+                    false);
             // Check if mesh has added particles
             REQUIRE(mesh->nparticles() == coordinates.size());
             // Clear coordinates and try creating a list of particles with an
@@ -1138,9 +1829,23 @@ TEST_CASE("Mesh is checked for 3D case", "[mesh][3D]") {
             mesh->create_particles(gpid, particle_type, coordinates);
             REQUIRE(mesh->nparticles() == nparticles);
 
+            // Particles outside the mesh are not added
+            const auto outside = Eigen::Matrix<double, Dim, 1>::Constant(100.);
+            coordinates.emplace_back(outside);
+            coordinates.emplace_back(particle);
+            REQUIRE(mesh->create_particles(100, particle_type, coordinates) ==
+                    false);
+            REQUIRE(mesh->nparticles() == ++nparticles);
+            coordinates.clear();
+
             const unsigned phase = 0;
             // Particles coordinates
-            REQUIRE(mesh->particle_coordinates().size() == mesh->nparticles());
+            const auto particle_coordinates = mesh->particle_coordinates();
+            REQUIRE(particle_coordinates.size() == mesh->nparticles());
+            // Coordinates are padded to 3 components
+            for (unsigned i = 0; i < 3; ++i)
+              REQUIRE(particle_coordinates.back()(i) ==
+                      Approx(i < Dim ? particle(i) : 0.).epsilon(Tolerance));
             // Particle stresses
             REQUIRE(mesh->particle_stresses(phase).size() ==
                     mesh->nparticles());
@@ -1151,6 +1856,8 @@ TEST_CASE("Mesh is checked for 3D case", "[mesh][3D]") {
 
               // Should find all particles in mesh
               REQUIRE(particles.size() == 0);
+              // Check both cells have particles
+              REQUIRE(mesh->nactive_cells() == 2);
               // Create particle 100
               Eigen::Vector3d coords;
               coords << 100., 100., 100.;
@@ -1172,6 +1879,330 @@ TEST_CASE("Mesh is checked for 3D case", "[mesh][3D]") {
             SECTION("Write particles HDF5") {
               REQUIRE(mesh->write_particles_hdf5(0, "particles-3d.h5") == true);
             }
+
+            // Test HDF5 with one dataset per field
+            SECTION("Write and read particles HDF5 columns") {
+              const auto nparticles = mesh->nparticles();
+
+              // Distinct masses and stresses of each particle
+              mpm::HDF5ParticleColumns expected;
+              mesh->gather_particles_hdf5(0, &expected);
+              std::map<mpm::Index, mpm::HDF5Particle> records;
+              for (unsigned i = 0; i < nparticles; ++i) {
+                expected.masses[i] = 1. + expected.ids[i];
+                for (unsigned j = 0; j < 6; ++j)
+                  expected.stresses[i * 6 + j] = 10. * expected.ids[i] + j;
+                records[expected.ids[i]] = expected.particle(i);
+              }
+              mesh->iterate_over_particles(
+                  [&records](std::shared_ptr<mpm::ParticleBase<Dim>> particle) {
+                    particle->initialise_particle(records.at(particle->id()));
+                  });
+
+              mpm::HDF5Options options;
+              options.columns = true;
+              options.chunk_size = 1;
+              options.compression = 4;
+              options.shuffle = true;
+              REQUIRE(mesh->write_particles_hdf5(
+                          0, "particles-columns-3d.h5", options) == true);
+
+              // Check datasets
+              hid_t file_id = H5Fopen("particles-columns-3d.h5",
+                                      H5F_ACC_RDONLY, H5P_DEFAULT);
+              REQUIRE(file_id >= 0);
+              auto dims = mpm::hdf5_dataset_dims(file_id, "coordinates");
+              REQUIRE(dims.first == nparticles);
+              REQUIRE(dims.second == Dim);
+              dims = mpm::hdf5_dataset_dims(file_id, "stress");
+              REQUIRE(dims.first == nparticles);
+              REQUIRE(dims.second == 6);
+
+              // Check values of each field
+              std::vector<mpm::Index> ids(nparticles);
+              std::vector<double> masses(nparticles);
+              std::vector<double> coordinates(nparticles * Dim);
+              std::vector<double> stresses(nparticles * 6);
+              REQUIRE(mpm::read_hdf5_dataset(file_id, "id", H5T_NATIVE_ULLONG,
+                                             ids.data()) == true);
+              REQUIRE(mpm::read_hdf5_dataset(file_id, "mass",
+                                             H5T_NATIVE_DOUBLE,
+                                             masses.data()) == true);
+              REQUIRE(mpm::read_hdf5_dataset(file_id, "coordinates",
+                                             H5T_NATIVE_DOUBLE,
+                                             coordinates.data()) == true);
+              REQUIRE(mpm::read_hdf5_dataset(file_id, "stress",
+                                             H5T_NATIVE_DOUBLE,
+                                             stresses.data()) == true);
+              REQUIRE(ids == expected.ids);
+              for (unsigned i = 0; i < nparticles; ++i)
+                REQUIRE(masses[i] ==
+                        Approx(expected.masses[i]).epsilon(Tolerance));
+              for (unsigned i = 0; i < nparticles * Dim; ++i)
+                REQUIRE(coordinates[i] ==
+                        Approx(expected.coordinates[i]).epsilon(Tolerance));
+              for (unsigned i = 0; i < nparticles * 6; ++i)
+                REQUIRE(stresses[i] ==
+                        Approx(expected.stresses[i]).epsilon(Tolerance));
+
+              // Check chunks and filters of a dataset
+              hid_t dataset_id = H5Dopen(file_id, "stress", H5P_DEFAULT);
+              hid_t plist_id = H5Dget_create_plist(dataset_id);
+              REQUIRE(H5Pget_layout(plist_id) == H5D_CHUNKED);
+              hsize_t chunk[2];
+              REQUIRE(H5Pget_chunk(plist_id, 2, chunk) == 2);
+              REQUIRE(chunk[0] == options.chunk_size);
+              std::vector<H5Z_filter_t> filters;
+              for (int i = 0; i < H5Pget_nfilters(plist_id); ++i) {
+                unsigned flags, config;
+                std::size_t nvalues = 1;
+                unsigned values[1];
+                filters.emplace_back(H5Pget_filter2(plist_id, i, &flags,
+                                                    &nvalues, values, 0,
+                                                    nullptr, &config));
+              }
+              const std::vector<H5Z_filter_t> shuffle_deflate = {
+                  H5Z_FILTER_SHUFFLE, H5Z_FILTER_DEFLATE};
+              REQUIRE(filters == shuffle_deflate);
+              H5Pclose(plist_id);
+              H5Dclose(dataset_id);
+              H5Fclose(file_id);
+
+              // Read particles back
+              REQUIRE(mesh->read_particles_hdf5(
+                          0, "particles-columns-3d.h5") == true);
+              REQUIRE(mesh->nparticles() == nparticles);
+              mpm::HDF5ParticleColumns read;
+              mesh->gather_particles_hdf5(0, &read);
+              REQUIRE(read.ids == expected.ids);
+              for (unsigned i = 0; i < nparticles * 6; ++i)
+                REQUIRE(read.stresses[i] ==
+                        Approx(expected.stresses[i]).epsilon(Tolerance));
+            }
+
+            // Test partitioned HDF5 with a master file
+            SECTION("Write and read partitioned particles HDF5") {
+              const auto nparticles = mesh->nparticles();
+              mpm::HDF5Options options;
+              options.partitions = 3;
+              options.writers = 2;
+              REQUIRE(mesh->write_particles_hdf5(
+                          0, "particles-partitioned-3d.h5", options) == true);
+
+              // Check partition files and virtual datasets
+              for (unsigned i = 0; i < options.partitions; ++i)
+                REQUIRE(std::ifstream("particles-partitioned-3d.p" +
+                                      std::to_string(i) + ".h5")
+                            .good());
+              hid_t file_id = H5Fopen("particles-partitioned-3d.h5",
+                                      H5F_ACC_RDONLY, H5P_DEFAULT);
+              REQUIRE(file_id >= 0);
+              auto dims = mpm::hdf5_dataset_dims(file_id, "coordinates");
+              REQUIRE(dims.first == nparticles);
+              REQUIRE(dims.second == Dim);
+              std::vector<mpm::Index> ids(nparticles);
+              mpm::read_hdf5_dataset(file_id, "id", H5T_NATIVE_ULLONG,
+                                     ids.data());
+              H5Fclose(file_id);
+              std::sort(ids.begin(), ids.end());
+              REQUIRE(std::unique(ids.begin(), ids.end()) == ids.end());
+
+              // Read particles back through the master file
+              REQUIRE(mesh->read_particles_hdf5(
+                          0, "particles-partitioned-3d.h5") == true);
+              REQUIRE(mesh->nparticles() == nparticles);
+            }
+
+            // Test creation of particles from HDF5 in a mesh without them
+            SECTION("Create particles from HDF5") {
+              const auto nparticles = mesh->nparticles();
+              const auto coordinates = mesh->particle_coordinates();
+              mpm::HDF5Options options;
+              options.columns = true;
+              REQUIRE(mesh->write_particles_hdf5(
+                          0, "particles-create-3d.h5") == true);
+              REQUIRE(mesh->write_particles_hdf5(
+                          0, "particles-create-columns-3d.h5", options) ==
+                      true);
+
+              for (const std::string filename :
+                   {"particles-create-3d.h5",
+                    "particles-create-columns-3d.h5"}) {
+                // Mesh with the same cells and no particles
+                auto created = std::make_shared<mpm::Mesh<Dim>>(1);
+                std::mutex cells_mutex;
+                std::vector<std::shared_ptr<mpm::Cell<Dim>>> mesh_cells;
+                mesh->iterate_over_cells(
+                    [&](std::shared_ptr<mpm::Cell<Dim>> cell) {
+                      std::lock_guard<std::mutex> guard(cells_mutex);
+                      mesh_cells.emplace_back(cell);
+                    });
+                // Cells are shared, particles are added to them again
+                for (const auto& cell : mesh_cells) created->add_cell(cell);
+
+                REQUIRE(created->create_particles_hdf5("P3D", filename) ==
+                        true);
+                REQUIRE(created->nparticles() == nparticles);
+                const auto created_coordinates =
+                    created->particle_coordinates();
+                for (unsigned i = 0; i < nparticles; ++i)
+                  for (unsigned j = 0; j < 3; ++j)
+                    REQUIRE(created_coordinates[i](j) ==
+                            Approx(coordinates[i](j)).epsilon(Tolerance));
+                // Particles are located in cells
+                REQUIRE(created->locate_particles_mesh().size() == 0);
+
+                // Particle ids are already in the mesh
+                REQUIRE(created->create_particles_hdf5("P3D", filename) ==
+                        false);
+                REQUIRE(created->nparticles() == nparticles);
+              }
+
+              // Missing file
+              auto created = std::make_shared<mpm::Mesh<Dim>>(1);
+              REQUIRE(created->create_particles_hdf5(
+                          "P3D", "particles-missing-3d.h5") == false);
+            }
+
+            // Test checkpoint of the state of particles
+            SECTION("Write and read checkpoint") {
+              const auto nparticles = mesh->nparticles();
+
+              // Distinct state of each particle with a material
+              unsigned mid = 1;
+              auto material =
+                  Factory<mpm::Material<Dim>, unsigned>::instance()->create(
+                      "LinearElastic3D", std::move(mid));
+              Json jmaterial;
+              jmaterial["density"] = 1000.;
+              jmaterial["youngs_modulus"] = 1.0E+7;
+              jmaterial["poisson_ratio"] = 0.3;
+              material->properties(jmaterial);
+              const std::map<unsigned, std::shared_ptr<mpm::Material<Dim>>>
+                  materials = {{1, material}};
+              mesh->iterate_over_particles(
+                  [&material](
+                      std::shared_ptr<mpm::ParticleBase<Dim>> particle) {
+                    const auto id = particle->id();
+                    mpm::HDF5Particle state;
+                    state.id = id;
+                    state.mass = 1. + id;
+                    state.coord_x = particle->coordinates()(0);
+                    state.coord_y = particle->coordinates()(1);
+                    state.coord_z = particle->coordinates()(Dim - 1);
+                    state.velocity_x = 0.1 * id;
+                    state.velocity_y = -0.2 * id;
+                    state.velocity_z = 0.3 * id;
+                    state.stress_xx = 10. * id;
+                    state.stress_yy = 11. * id;
+                    state.stress_zz = 12. * id;
+                    state.tau_xy = 13. * id;
+                    state.tau_yz = 14. * id;
+                    state.tau_xz = 15. * id;
+                    state.strain_xx = 0.01 * id;
+                    state.strain_yy = 0.02 * id;
+                    state.strain_zz = 0.03 * id;
+                    state.gamma_xy = 0.04 * id;
+                    state.gamma_yz = 0.05 * id;
+                    state.gamma_xz = 0.06 * id;
+                    state.epsilon_v = 0.07 * id;
+                    particle->initialise_particle(state);
+                    particle->assign_volume(2. + id);
+                    particle->assign_material(material);
+                  });
+
+              mpm::binary::Checkpoint checkpoint;
+              checkpoint.step = 5;
+              checkpoint.time = 0.05;
+              checkpoint.uuid = "mesh-checkpoint-3d";
+              REQUIRE(mesh->write_checkpoint(0, "checkpoint-3d.bin",
+                                             checkpoint) == true);
+
+              // Mesh with the same cells and no particles
+              auto restored = std::make_shared<mpm::Mesh<Dim>>(1);
+              std::mutex cells_mutex;
+              std::vector<std::shared_ptr<mpm::Cell<Dim>>> mesh_cells;
+              mesh->iterate_over_cells(
+                  [&](std::shared_ptr<mpm::Cell<Dim>> cell) {
+                    std::lock_guard<std::mutex> guard(cells_mutex);
+                    mesh_cells.emplace_back(cell);
+                  });
+              for (const auto& cell : mesh_cells) restored->add_cell(cell);
+
+              mpm::binary::Checkpoint read;
+              REQUIRE(restored->read_checkpoint(0, "checkpoint-3d.bin",
+                                                particle_type, materials,
+                                                &read) == true);
+              REQUIRE(read.step == 5);
+              REQUIRE(read.time == Approx(0.05).epsilon(Tolerance));
+              REQUIRE(read.uuid == "mesh-checkpoint-3d");
+
+              // Particles are restored in order and in their cells
+              REQUIRE(restored->nparticles() == nparticles);
+              REQUIRE(restored->nactive_cells() == 2);
+              const auto expected = mesh->particle_coordinates();
+              const auto coordinates = restored->particle_coordinates();
+              for (unsigned i = 0; i < nparticles; ++i)
+                for (unsigned j = 0; j < Dim; ++j)
+                  REQUIRE(coordinates[i](j) ==
+                          Approx(expected[i](j)).epsilon(Tolerance));
+              restored->iterate_over_particles(
+                  [](std::shared_ptr<mpm::ParticleBase<Dim>> particle) {
+                    REQUIRE(particle->cell_id() !=
+                            std::numeric_limits<mpm::Index>::max());
+                  });
+
+              // State of each particle is restored field by field
+              std::mutex particles_mutex;
+              std::map<mpm::Index, std::shared_ptr<mpm::ParticleBase<Dim>>>
+                  originals, restored_particles;
+              mesh->iterate_over_particles(
+                  [&](std::shared_ptr<mpm::ParticleBase<Dim>> particle) {
+                    std::lock_guard<std::mutex> guard(particles_mutex);
+                    originals[particle->id()] = particle;
+                  });
+              restored->iterate_over_particles(
+                  [&](std::shared_ptr<mpm::ParticleBase<Dim>> particle) {
+                    std::lock_guard<std::mutex> guard(particles_mutex);
+                    restored_particles[particle->id()] = particle;
+                  });
+              REQUIRE(restored_particles.size() == originals.size());
+              for (const auto& original : originals) {
+                const auto& particle = restored_particles.at(original.first);
+                const auto& expected_particle = original.second;
+                REQUIRE(particle->cell_id() == expected_particle->cell_id());
+                REQUIRE(particle->material_id() == 1);
+                REQUIRE(particle->mass(0) ==
+                        Approx(expected_particle->mass(0)).epsilon(Tolerance));
+                REQUIRE(particle->volume() ==
+                        Approx(expected_particle->volume()).epsilon(Tolerance));
+                REQUIRE(particle->volumetric_strain_centroid(0) ==
+                        Approx(expected_particle->volumetric_strain_centroid(0))
+                            .epsilon(Tolerance));
+                for (unsigned j = 0; j < Dim; ++j) {
+                  REQUIRE(particle->velocity(0)(j) ==
+                          Approx(expected_particle->velocity(0)(j))
+                              .epsilon(Tolerance));
+                  REQUIRE(particle->reference_location()(j) ==
+                          Approx(expected_particle->reference_location()(j))
+                              .epsilon(Tolerance));
+                }
+                for (unsigned j = 0; j < 6; ++j) {
+                  REQUIRE(particle->stress(0)(j) ==
+                          Approx(expected_particle->stress(0)(j))
+                              .epsilon(Tolerance));
+                  REQUIRE(particle->strain(0)(j) ==
+                          Approx(expected_particle->strain(0)(j))
+                              .epsilon(Tolerance));
+                }
+              }
+
+              // Particles are only added to a mesh without particles
+              REQUIRE(restored->read_checkpoint(0, "checkpoint-3d.bin",
+                                                particle_type, materials,
+                                                &read) == false);
+              REQUIRE(restored->nparticles() == nparticles);
+            }
           }
         }
         // Test assign velocity constraints
@@ -1187,11 +2218,17 @@ TEST_CASE("Mesh is checked for 3D case", "[mesh][3D]") {
 
           REQUIRE(mesh->assign_velocity_constraints(velocity_constraints) ==
                   true);
+          REQUIRE(mesh->nvelocity_constraints() == 4);
 
           // When constraints fail
           velocity_constraints.emplace_back(std::make_tuple(3, 3, 0.0));
           REQUIRE(mesh->assign_velocity_constraints(velocity_constraints) ==
                   false);
+          REQUIRE(mesh->nvelocity_constraints() == 4);
+
+          // Node set constraints retain the first constraint on a direction
+          REQUIRE(mesh->assign_velocity_constraints({0, 1}, 0, 2.5) == true);
+          REQUIRE(mesh->nvelocity_constraints() == 5);
         }
       }
     }
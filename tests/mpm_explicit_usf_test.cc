@@ -1,3 +1,5 @@
+#include <cstdio>
+
 #include "catch.hpp"
 
 //! Alias for JSON
@@ -36,6 +38,10 @@ TEST_CASE("MPM 2D Explicit implementation is checked",
                   (char*)"-i",  (char*)"mpm-explicit-usf-2d.json"};
   // clang-format on
 
+  // Configuration and analysis of variants of the problem
+  const std::string base = "mpm-explicit-usf-2d.json";
+  const std::string analysis = "MPMExplicitUSF2D";
+
   SECTION("Check initialisation") {
     // Create an IO object
     auto io = std::make_unique<mpm::IO>(argc, argv);
@@ -55,6 +61,20 @@ TEST_CASE("MPM 2D Explicit implementation is checked",
     REQUIRE(mpm->initialise_materials() == false);
   }
 
+  SECTION("Check particle generation") {
+    // Generate particles in cells instead of reading a particles file
+    Json patch;
+    patch["mesh"]["generate_particles"] = {
+        {"points_per_direction", 2},
+        {"regions", {{{"min", {0., 0.}}, {"max", {1., 1.}}}}}};
+    auto io = mpm_test::write_json_variant(
+        base, "mpm-explicit-usf-generate-2d", analysis, patch);
+    // Run explicit MPM
+    auto mpm = std::make_unique<mpm::MPMExplicitUSF<Dim>>(std::move(io));
+    // Solve with generated particles
+    REQUIRE(mpm->solve() == true);
+  }
+
   SECTION("Check solver") {
     // Create an IO object
     auto io = std::make_unique<mpm::IO>(argc, argv);
@@ -66,19 +86,338 @@ TEST_CASE("MPM 2D Explicit implementation is checked",
     REQUIRE(mpm->checkpoint_resume() == false);
   }
 
+  SECTION("Check asynchronous output") {
+    // Write HDF5 output on a background thread
+    Json patch;
+    patch["post_processing"]["async_output"] = {{"queue_size", 2}};
+    patch["post_processing"]["hdf5"] = {{"layout", "columns"}};
+    auto io = mpm_test::write_json_variant(
+        base, "mpm-explicit-usf-async-2d", analysis, patch);
+    // Run explicit MPM
+    auto mpm = std::make_unique<mpm::MPMExplicitUSF<Dim>>(std::move(io));
+    // Solve
+    REQUIRE(mpm->solve() == true);
+
+    // Output is complete when solve returns
+    for (const std::string step : {"00", "05"}) {
+      hid_t file_id = H5Fopen(
+          ("./results/mpm-explicit-usf-async-2d/particles" + step + ".h5")
+              .c_str(),
+          H5F_ACC_RDONLY, H5P_DEFAULT);
+      REQUIRE(file_id >= 0);
+      REQUIRE(mpm::hdf5_dataset_dims(file_id, "coordinates").second == Dim);
+      H5Fclose(file_id);
+    }
+  }
+
+  SECTION("Check parallel VTK output") {
+    // Write VTK output in pieces referenced by a parallel file
+    Json patch;
+    patch["post_processing"]["vtk"] = {{"pieces", 3}};
+    auto io = mpm_test::write_json_variant(base, "mpm-explicit-usf-pvtp-2d",
+                                           analysis, patch);
+    // Run explicit MPM
+    auto mpm = std::make_unique<mpm::MPMExplicitUSF<Dim>>(std::move(io));
+    // Solve
+    REQUIRE(mpm->solve() == true);
+
+    // Parallel file references each piece
+    std::ifstream pvtp("./results/mpm-explicit-usf-pvtp-2d/particles05.pvtp");
+    REQUIRE(pvtp.is_open());
+    const std::string contents((std::istreambuf_iterator<char>(pvtp)),
+                               std::istreambuf_iterator<char>());
+    for (const std::string piece : {"0", "1", "2"})
+      REQUIRE(contents.find("<Piece Source=\"particles05_" + piece +
+                            ".vtp\"/>") != std::string::npos);
+    REQUIRE(contents.find("Name=\"stresses\" NumberOfComponents=\"6\"") !=
+            std::string::npos);
+  }
+
+  SECTION("Check output selection") {
+    // Write selected fields of decimated particles
+    Json patch;
+    patch["post_processing"]["fields"] = {{"coordinates", 1}, {"stress", 10}};
+    patch["post_processing"]["regions"] = {
+        {{"min", {-1., -1.}}, {"max", {10., 10.}}}};
+    patch["post_processing"]["decimation"] = {{"stride", 2}};
+    auto io = mpm_test::write_json_variant(
+        base, "mpm-explicit-usf-selection-2d", analysis, patch);
+    // Run explicit MPM
+    auto mpm = std::make_unique<mpm::MPMExplicitUSF<Dim>>(std::move(io));
+    // Solve
+    REQUIRE(mpm->solve() == true);
+
+    // Stress is written every 10 steps, other fields are not written
+    const std::string path = "./results/mpm-explicit-usf-selection-2d/";
+    hid_t file_id = H5Fopen((path + "particles00.h5").c_str(), H5F_ACC_RDONLY,
+                            H5P_DEFAULT);
+    REQUIRE(file_id >= 0);
+    REQUIRE(H5Lexists(file_id, "coordinates", H5P_DEFAULT) > 0);
+    REQUIRE(H5Lexists(file_id, "stress", H5P_DEFAULT) > 0);
+    REQUIRE(H5Lexists(file_id, "velocity", H5P_DEFAULT) == 0);
+    mpm::HDF5ParticleColumns columns;
+    mpm::read_hdf5_particle_columns(file_id, &columns);
+    for (const auto id : columns.ids) REQUIRE(id % 2 == 0);
+    H5Fclose(file_id);
+
+    file_id = H5Fopen((path + "particles05.h5").c_str(), H5F_ACC_RDONLY,
+                      H5P_DEFAULT);
+    REQUIRE(file_id >= 0);
+    REQUIRE(H5Lexists(file_id, "coordinates", H5P_DEFAULT) > 0);
+    REQUIRE(H5Lexists(file_id, "stress", H5P_DEFAULT) == 0);
+    H5Fclose(file_id);
+  }
+
+  SECTION("Check invalid output selection") {
+    // An unknown field is a configuration error
+    Json patch;
+    patch["post_processing"]["fields"] = {"coordinates", "pressure"};
+    auto io = mpm_test::write_json_variant(
+        base, "mpm-explicit-usf-invalid-2d", analysis, patch);
+    REQUIRE_THROWS(std::make_unique<mpm::MPMExplicitUSF<Dim>>(std::move(io)));
+  }
+
+  SECTION("Check resume from selected output") {
+    // Output of selected fields can not be resumed from
+    const std::string uuid = "mpm-explicit-usf-resume-selection-2d";
+    Json patch;
+    patch["post_processing"]["fields"] = {"coordinates"};
+
+    {
+      auto io = mpm_test::write_json_variant(base, uuid, analysis, patch);
+      // Run explicit MPM
+      auto mpm = std::make_unique<mpm::MPMExplicitUSF<Dim>>(std::move(io));
+      // Solve
+      REQUIRE(mpm->solve() == true);
+    }
+
+    // Resume from step 5
+    patch["analysis"]["resume"] = {
+        {"resume", true}, {"uuid", uuid}, {"step", 5}};
+    auto io = mpm_test::write_json_variant(base, uuid, analysis, patch);
+    // Run explicit MPM
+    auto mpm = std::make_unique<mpm::MPMExplicitUSF<Dim>>(std::move(io));
+    // Initialise mesh and particles to read the step into
+    REQUIRE(mpm->initialise_materials() == true);
+    REQUIRE(mpm->initialise_mesh_particles() == true);
+    // Test check point restart
+    REQUIRE(mpm->checkpoint_resume() == false);
+  }
+
+  SECTION("Check single file output and resume") {
+    // Append output steps to a single HDF5 file
+    const std::string uuid = "mpm-explicit-usf-series-2d";
+    Json patch;
+    patch["post_processing"]["hdf5"] = {{"time_series", true},
+                                        {"flush_interval", 2}};
+
+    {
+      auto io = mpm_test::write_json_variant(base, uuid, analysis, patch);
+      // Run explicit MPM
+      auto mpm = std::make_unique<mpm::MPMExplicitUSF<Dim>>(std::move(io));
+      // Solve
+      REQUIRE(mpm->solve() == true);
+    }
+
+    // Check steps in the file
+    {
+      mpm::HDF5TimeSeries series(
+          "./results/mpm-explicit-usf-series-2d/particles.h5", true, true);
+      REQUIRE(series.index().size() == 2);
+      REQUIRE(series.has_step(0) == true);
+      REQUIRE(series.has_step(5) == true);
+    }
+
+    // Resume from step 5 of the file
+    patch["analysis"]["resume"] = {
+        {"resume", true}, {"uuid", uuid}, {"step", 5}};
+    auto io = mpm_test::write_json_variant(base, uuid, analysis, patch);
+    // Run explicit MPM
+    auto mpm = std::make_unique<mpm::MPMExplicitUSF<Dim>>(std::move(io));
+    // Initialise mesh and particles to read the step into
+    REQUIRE(mpm->initialise_materials() == true);
+    REQUIRE(mpm->initialise_mesh_particles() == true);
+    // Test check point restart
+    REQUIRE(mpm->checkpoint_resume() == true);
+  }
+
+  SECTION("Check checkpoint and restart") {
+    // Write checkpoints independent of output steps
+    const std::string uuid = "mpm-explicit-usf-checkpoint-2d";
+    Json patch;
+    patch["analysis"]["checkpoint_steps"] = 4;
+    patch["post_processing"]["output_steps"] = 4;
+
+    {
+      auto io = mpm_test::write_json_variant(base, uuid, analysis, patch);
+      // Run explicit MPM
+      auto mpm = std::make_unique<mpm::MPMExplicitUSF<Dim>>(std::move(io));
+      // Solve
+      REQUIRE(mpm->solve() == true);
+    }
+    for (const std::string step : {"00", "04", "08"})
+      REQUIRE(std::ifstream("./results/mpm-explicit-usf-checkpoint-2d/"
+                            "checkpoint" +
+                            step + ".bin")
+                  .good());
+
+    // Output of step 8 of the uninterrupted run
+    const std::string path = "./results/mpm-explicit-usf-checkpoint-2d/";
+    mpm::HDF5ParticleColumns expected;
+    REQUIRE(mpm::read_hdf5_particles(path + "particles08.h5", Dim,
+                                     &expected) == true);
+    std::remove((path + "particles08.h5").c_str());
+
+    // Restart from the checkpoint of step 4
+    patch["analysis"]["resume"] = {
+        {"resume", true}, {"uuid", uuid}, {"step", 4}, {"checkpoint", true}};
+
+    {
+      auto io = mpm_test::write_json_variant(base, uuid, analysis, patch);
+      auto mpm = std::make_unique<mpm::MPMExplicitUSF<Dim>>(std::move(io));
+      // Particles are restored with the mesh
+      REQUIRE(mpm->initialise_materials() == true);
+      REQUIRE(mpm->initialise_mesh_particles() == true);
+      REQUIRE(mpm->checkpoint_resume() == true);
+    }
+
+    auto io = mpm_test::write_json_variant(base, uuid, analysis, patch);
+    // Run explicit MPM
+    auto mpm = std::make_unique<mpm::MPMExplicitUSF<Dim>>(std::move(io));
+    // Solve the remaining steps
+    REQUIRE(mpm->solve() == true);
+
+    // Step 8 of the restarted run matches the uninterrupted run
+    mpm::HDF5ParticleColumns columns;
+    REQUIRE(mpm::read_hdf5_particles(path + "particles08.h5", Dim,
+                                     &columns) == true);
+    REQUIRE(columns.fields == expected.fields);
+    REQUIRE(columns.ids == expected.ids);
+    const double Tolerance = 1.E-9;
+    const auto compare = [&](const std::vector<double>& values,
+                             const std::vector<double>& expected_values) {
+      REQUIRE(values.size() == expected_values.size());
+      for (unsigned i = 0; i < values.size(); ++i)
+        REQUIRE(values[i] == Approx(expected_values[i]).epsilon(Tolerance));
+    };
+    compare(columns.masses, expected.masses);
+    compare(columns.coordinates, expected.coordinates);
+    compare(columns.velocities, expected.velocities);
+    compare(columns.stresses, expected.stresses);
+    compare(columns.strains, expected.strains);
+    compare(columns.volumetric_strains, expected.volumetric_strains);
+    REQUIRE(columns.statuses == expected.statuses);
+  }
+
+  SECTION("Check profile of stages") {
+    // Profile stages with a trace
+    Json patch;
+    patch["post_processing"]["profile"] = {{"trace", true}};
+
+    const std::string folder = "./results/mpm-explicit-usf-profile-2d/";
+    boost::filesystem::remove_all(folder);
+    {
+      // Count hardware events of stages from the command line
+      auto io = mpm_test::write_json_variant(
+          base, "mpm-explicit-usf-profile-2d", analysis, patch, {"-p"});
+      // Run explicit MPM
+      auto mpm = std::make_unique<mpm::MPMExplicitUSF<Dim>>(std::move(io));
+      // Solve
+      REQUIRE(mpm->solve() == true);
+    }
+
+#ifdef MPM_PROFILING
+    // Summary has a record of each step and startup phase
+    Json profile;
+    std::ifstream profile_file(folder + "profile.json");
+    profile_file >> profile;
+    std::map<std::string, unsigned> calls;
+    for (const auto& stage : profile["stages"])
+      calls[stage["stage"].template get<std::string>()] =
+          stage["calls"].template get<unsigned>();
+    REQUIRE(calls.at("step") == 10);
+    REQUIRE(calls.at("stress") == 10);
+    REQUIRE(calls.at("output") == 2);
+    REQUIRE(calls.at("Read mesh") == 1);
+    REQUIRE(std::ifstream(folder + "trace.json").good());
+
+    // Counts of events are reported when the hardware provides them
+    if (profile.find("counters") != profile.end()) {
+      REQUIRE(profile["particles"] == 8);
+      for (const auto& stage : profile["stages"])
+        if (stage["stage"] == "step")
+          REQUIRE(stage.find("cycles") != stage.end());
+    }
+#else
+    // Profiling is compiled out
+    REQUIRE(!std::ifstream(folder + "profile.json").good());
+#endif
+  }
+
+  SECTION("Check mesh cache") {
+    // Tolerance
+    const double Tolerance = 1.E-12;
+
+    // Cache the preprocessed mesh
+    Json patch;
+    patch["mesh"]["cache"] = true;
+    boost::filesystem::remove_all("./results/cache/");
+
+    // Run an analysis which writes the cache and one which reads it
+    for (const std::string uuid : {"mpm-explicit-usf-cache-write-2d",
+                                   "mpm-explicit-usf-cache-read-2d"}) {
+      auto io = mpm_test::write_json_variant(base, uuid, analysis, patch);
+      // Run explicit MPM
+      auto mpm = std::make_unique<mpm::MPMExplicitUSF<Dim>>(std::move(io));
+      // Solve
+      REQUIRE(mpm->solve() == true);
+
+      // Inputs are cached once
+      unsigned ncaches = 0;
+      for (boost::filesystem::directory_iterator file("./results/cache/"), end;
+           file != end; ++file)
+        ++ncaches;
+      REQUIRE(ncaches == 1);
+    }
+
+    // Cached mesh gives the same results
+    mpm::HDF5ParticleColumns written, read;
+    mpm::read_hdf5_particles(
+        "./results/mpm-explicit-usf-cache-write-2d/particles05.h5", Dim,
+        &written);
+    mpm::read_hdf5_particles(
+        "./results/mpm-explicit-usf-cache-read-2d/particles05.h5", Dim, &read);
+    REQUIRE(read.size() == written.size());
+    for (unsigned i = 0; i < read.coordinates.size(); ++i)
+      REQUIRE(read.coordinates[i] ==
+              Approx(written.coordinates[i]).epsilon(Tolerance));
+    for (unsigned i = 0; i < read.stresses.size(); ++i)
+      REQUIRE(read.stresses[i] ==
+              Approx(written.stresses[i]).epsilon(Tolerance));
+  }
+
   SECTION("Check resume") {
     // Write JSON file
     const std::string fname = "mpm-explicit-usf";
     bool resume = true;
     bool status = mpm_test::write_json(2, resume, fname);
 
+    {
+      // Create an IO object
+      auto io = std::make_unique<mpm::IO>(argc, argv);
+      // Run explicit MPM
+      auto mpm = std::make_unique<mpm::MPMExplicitUSF<Dim>>(std::move(io));
+      // Initialise mesh and particles to read the step into
+      REQUIRE(mpm->initialise_materials() == true);
+      REQUIRE(mpm->initialise_mesh_particles() == true);
+      // Test check point restart
+      REQUIRE(mpm->checkpoint_resume() == true);
+    }
+
     // Create an IO object
     auto io = std::make_unique<mpm::IO>(argc, argv);
     // Run explicit MPM
     auto mpm = std::make_unique<mpm::MPMExplicitUSF<Dim>>(std::move(io));
-
-    // Test check point restart
-    REQUIRE(mpm->checkpoint_resume() == true);
     // Solve
     REQUIRE(mpm->solve() == true);
   }
@@ -149,13 +488,22 @@ TEST_CASE("MPM 3D Explicit implementation is checked",
     bool resume = true;
     bool status = mpm_test::write_json(3, resume, fname);
 
+    {
+      // Create an IO object
+      auto io = std::make_unique<mpm::IO>(argc, argv);
+      // Run explicit MPM
+      auto mpm = std::make_unique<mpm::MPMExplicitUSF<Dim>>(std::move(io));
+      // Initialise mesh and particles to read the step into
+      REQUIRE(mpm->initialise_materials() == true);
+      REQUIRE(mpm->initialise_mesh_particles() == true);
+      // Test check point restart
+      REQUIRE(mpm->checkpoint_resume() == true);
+    }
+
     // Create an IO object
     auto io = std::make_unique<mpm::IO>(argc, argv);
     // Run explicit MPM
     auto mpm = std::make_unique<mpm::MPMExplicitUSF<Dim>>(std::move(io));
-
-    // Test check point restart
-    REQUIRE(mpm->checkpoint_resume() == true);
     // Solve
     REQUIRE(mpm->solve() == true);
   }
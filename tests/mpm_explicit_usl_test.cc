@@ -72,13 +72,22 @@ TEST_CASE("MPM 2D Explicit USL implementation is checked",
     bool resume = true;
     bool status = mpm_test::write_json(2, resume, fname);
 
+    {
+      // Create an IO object
+      auto io = std::make_unique<mpm::IO>(argc, argv);
+      // Run explicit MPM
+      auto mpm = std::make_unique<mpm::MPMExplicitUSL<Dim>>(std::move(io));
+      // Initialise mesh and particles to read the step into
+      REQUIRE(mpm->initialise_materials() == true);
+      REQUIRE(mpm->initialise_mesh_particles() == true);
+      // Test check point restart
+      REQUIRE(mpm->checkpoint_resume() == true);
+    }
+
     // Create an IO object
     auto io = std::make_unique<mpm::IO>(argc, argv);
     // Run explicit MPM
     auto mpm = std::make_unique<mpm::MPMExplicitUSL<Dim>>(std::move(io));
-
-    // Test check point restart
-    REQUIRE(mpm->checkpoint_resume() == true);
     // Solve
     REQUIRE(mpm->solve() == true);
   }
@@ -149,13 +158,22 @@ TEST_CASE("MPM 3D Explicit USL implementation is checked",
     bool resume = true;
     bool status = mpm_test::write_json(3, resume, fname);
 
+    {
+      // Create an IO object
+      auto io = std::make_unique<mpm::IO>(argc, argv);
+      // Run explicit MPM
+      auto mpm = std::make_unique<mpm::MPMExplicitUSL<Dim>>(std::move(io));
+      // Initialise mesh and particles to read the step into
+      REQUIRE(mpm->initialise_materials() == true);
+      REQUIRE(mpm->initialise_mesh_particles() == true);
+      // Test check point restart
+      REQUIRE(mpm->checkpoint_resume() == true);
+    }
+
     // Create an IO object
     auto io = std::make_unique<mpm::IO>(argc, argv);
     // Run explicit MPM
     auto mpm = std::make_unique<mpm::MPMExplicitUSL<Dim>>(std::move(io));
-
-    // Test check point restart
-    REQUIRE(mpm->checkpoint_resume() == true);
     // Solve
     REQUIRE(mpm->solve() == true);
   }
@@ -238,8 +238,8 @@ TEST_CASE("Node is checked for 1D case", "[node][1D]") {
                 Approx(velocity(i)).epsilon(Tolerance));
 
       // Apply velocity constraints
-      REQUIRE(node->assign_velocity_constraint(0, 10.5) == true);
       REQUIRE(node->compute_acceleration_velocity(Nphase, dt) == true);
+      node->apply_velocity_constraint(0, 10.5);
 
       // Test velocity with constraints
       velocity[0] = 10.5;
@@ -321,10 +321,6 @@ TEST_CASE("Node is checked for 1D case", "[node][1D]") {
       status = node->update_momentum(false, Nphase, momentum);
       REQUIRE(status == false);
 
-      // Apply velocity constraints
-      REQUIRE(node->assign_velocity_constraint(0, 10.5) == true);
-      // Check out of bounds condition
-      REQUIRE(node->assign_velocity_constraint(1, 0) == false);
 
       // Check velocity before constraints
       Eigen::Matrix<double, Dim, 1> velocity;
@@ -334,7 +330,7 @@ TEST_CASE("Node is checked for 1D case", "[node][1D]") {
                 Approx(velocity(i)).epsilon(Tolerance));
 
       // Apply constraints
-      node->apply_velocity_constraints();
+      node->apply_velocity_constraint(0, 10.5);
 
       // Check apply constraints
       velocity << 10.5;
@@ -369,10 +365,6 @@ TEST_CASE("Node is checked for 1D case", "[node][1D]") {
       status = node->update_acceleration(false, Nphase, acceleration);
       REQUIRE(status == false);
 
-      // Apply velocity constraints
-      REQUIRE(node->assign_velocity_constraint(0, 10.5) == true);
-      // Check out of bounds condition
-      REQUIRE(node->assign_velocity_constraint(1, 12.5) == false);
 
       // Check acceleration before constraints
       acceleration.resize(Dim);
@@ -382,7 +374,7 @@ TEST_CASE("Node is checked for 1D case", "[node][1D]") {
                 Approx(acceleration(i)).epsilon(Tolerance));
 
       // Apply constraints
-      node->apply_velocity_constraints();
+      node->apply_velocity_constraint(0, 10.5);
 
       // Check apply constraints
       acceleration << 0.0;
@@ -641,8 +633,8 @@ TEST_CASE("Node is checked for 2D case", "[node][2D]") {
                 Approx(velocity(i)).epsilon(Tolerance));
 
       // Apply velocity constraints
-      REQUIRE(node->assign_velocity_constraint(0, 10.5) == true);
       REQUIRE(node->compute_acceleration_velocity(Nphase, dt) == true);
+      node->apply_velocity_constraint(0, 10.5);
 
       // Test velocity with constraints
       // TODO: Check this velocity
@@ -725,10 +717,6 @@ TEST_CASE("Node is checked for 2D case", "[node][2D]") {
       status = node->update_momentum(false, Nphase, momentum);
       REQUIRE(status == false);
 
-      // Apply velocity constraints
-      REQUIRE(node->assign_velocity_constraint(0, -12.5) == true);
-      // Check out of bounds condition
-      REQUIRE(node->assign_velocity_constraint(2, 0.) == false);
 
       // Check velocity before constraints
       Eigen::Matrix<double, Dim, 1> velocity;
@@ -738,7 +726,7 @@ TEST_CASE("Node is checked for 2D case", "[node][2D]") {
                 Approx(velocity(i)).epsilon(Tolerance));
 
       // Apply constraints
-      node->apply_velocity_constraints();
+      node->apply_velocity_constraint(0, -12.5);
 
       // Check apply constraints
       velocity << -12.5, 0.1;
@@ -769,10 +757,6 @@ TEST_CASE("Node is checked for 2D case", "[node][2D]") {
       status = node->update_acceleration(true, Nphase, acceleration);
       REQUIRE(status == false);
 
-      // Apply velocity constraints
-      REQUIRE(node->assign_velocity_constraint(0, -12.5) == true);
-      // Check out of bounds condition
-      REQUIRE(node->assign_velocity_constraint(2, 0.) == false);
 
       // Check acceleration before constraints
       acceleration.resize(Dim);
@@ -782,7 +766,7 @@ TEST_CASE("Node is checked for 2D case", "[node][2D]") {
                 Approx(acceleration(i)).epsilon(Tolerance));
 
       // Apply constraints
-      node->apply_velocity_constraints();
+      node->apply_velocity_constraint(0, -12.5);
 
       // Check apply constraints
       acceleration << 0., 5.;
@@ -998,8 +982,8 @@ TEST_CASE("Node is checked for 3D case", "[node][3D]") {
                 Approx(velocity(i)).epsilon(Tolerance));
 
       // Apply velocity constraints
-      REQUIRE(node->assign_velocity_constraint(0, 10.5) == true);
       REQUIRE(node->compute_acceleration_velocity(Nphase, dt) == true);
+      node->apply_velocity_constraint(0, 10.5);
 
       // Test velocity with constraints
       // TODO: Check velocity
@@ -1068,11 +1052,6 @@ TEST_CASE("Node is checked for 3D case", "[node][3D]") {
       for (unsigned i = 0; i < Dim; ++i)
         REQUIRE(node->velocity(Nphase)(i) == Approx(0.1).epsilon(Tolerance));
 
-      // Apply velocity constraints
-      REQUIRE(node->assign_velocity_constraint(0, 10.5) == true);
-      REQUIRE(node->assign_velocity_constraint(1, -12.5) == true);
-      // Check out of bounds condition
-      REQUIRE(node->assign_velocity_constraint(4, 0.) == false);
 
       // Check velocity before constraints
       Eigen::Matrix<double, Dim, 1> velocity;
@@ -1082,7 +1061,8 @@ TEST_CASE("Node is checked for 3D case", "[node][3D]") {
                 Approx(velocity(i)).epsilon(Tolerance));
 
       // Apply constraints
-      node->apply_velocity_constraints();
+      node->apply_velocity_constraint(0, 10.5);
+      node->apply_velocity_constraint(1, -12.5);
 
       // Check apply constraints
       velocity << 10.5, -12.5, 0.1;
@@ -1117,11 +1097,6 @@ TEST_CASE("Node is checked for 3D case", "[node][3D]") {
       status = node->update_acceleration(false, Nphase, acceleration);
       REQUIRE(status == false);
 
-      // Apply velocity constraints
-      REQUIRE(node->assign_velocity_constraint(0, 10.5) == true);
-      REQUIRE(node->assign_velocity_constraint(1, -12.5) == true);
-      // Check out of bounds condition
-      REQUIRE(node->assign_velocity_constraint(4, 0.) == false);
 
       // Check acceleration before constraints
       acceleration.resize(Dim);
@@ -1131,7 +1106,8 @@ TEST_CASE("Node is checked for 3D case", "[node][3D]") {
                 Approx(acceleration(i)).epsilon(Tolerance));
 
       // Apply constraints
-      node->apply_velocity_constraints();
+      node->apply_velocity_constraint(0, 10.5);
+      node->apply_velocity_constraint(1, -12.5);
 
       // Check apply constraints
       acceleration << 0.0, 0.0, 5.;
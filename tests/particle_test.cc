@@ -1,4 +1,5 @@
 #include <limits>
+#include <vector>
 
 #include "catch.hpp"
 
@@ -337,8 +338,10 @@ TEST_CASE("Particle is checked for 2D case", "[particle][2D]") {
     REQUIRE(cell->status() == false);
     // Assign particle to cell
     REQUIRE(particle->assign_cell(cell) == true);
+    REQUIRE(particle->cell_id() == cell->id());
     // Check cell status on addition of particle
     REQUIRE(cell->status() == true);
+    REQUIRE(cell->nparticles() == 1);
 
     // Create cell
     auto cell2 = std::make_shared<mpm::Cell<Dim>>(20, Nnodes, element);
@@ -363,10 +366,26 @@ TEST_CASE("Particle is checked for 2D case", "[particle][2D]") {
     REQUIRE(cell2->status() == false);
     // Check cell status because this should not have removed the particle
     REQUIRE(cell->status() == true);
+    REQUIRE(particle->cell_id() == cell->id());
 
     // Remove assigned cell
     particle->remove_cell();
+    REQUIRE(cell->status() == false);
+    REQUIRE(particle->assign_cell(cell) == true);
+    // Assigning the same cell again does not add the particle twice
     REQUIRE(particle->assign_cell(cell) == true);
+    REQUIRE(cell->nparticles() == 1);
+
+    // Assign a cell and reference location without a search
+    const Eigen::Matrix<double, Dim, 1> xi = particle->reference_location();
+    particle->remove_cell();
+    REQUIRE(particle->assign_cell_xi(cell, xi) == true);
+    REQUIRE(particle->cell_id() == cell->id());
+    REQUIRE(cell->nparticles() == 1);
+    for (unsigned i = 0; i < Dim; ++i)
+      REQUIRE(particle->reference_location()(i) ==
+              Approx(xi(i)).epsilon(Tolerance));
+    REQUIRE(particle->assign_cell_xi(nullptr, xi) == false);
   }
 
   //! Test particle, cell and node functions
@@ -1049,8 +1068,10 @@ TEST_CASE("Particle is checked for 3D case", "[particle][3D]") {
     REQUIRE(cell->status() == false);
     // Assign particle to cell
     REQUIRE(particle->assign_cell(cell) == true);
+    REQUIRE(particle->cell_id() == cell->id());
     // Check cell status on addition of particle
     REQUIRE(cell->status() == true);
+    REQUIRE(cell->nparticles() == 1);
 
     // Create cell
     auto cell2 = std::make_shared<mpm::Cell<Dim>>(20, Nnodes, element);
@@ -1079,10 +1100,26 @@ TEST_CASE("Particle is checked for 3D case", "[particle][3D]") {
     REQUIRE(cell2->status() == false);
     // Check cell status because this should not have removed the particle
     REQUIRE(cell->status() == true);
+    REQUIRE(particle->cell_id() == cell->id());
 
     // Remove assigned cell
     particle->remove_cell();
+    REQUIRE(cell->status() == false);
+    REQUIRE(particle->assign_cell(cell) == true);
+    // Assigning the same cell again does not add the particle twice
     REQUIRE(particle->assign_cell(cell) == true);
+    REQUIRE(cell->nparticles() == 1);
+
+    // Assign a cell and reference location without a search
+    const Eigen::Matrix<double, Dim, 1> xi = particle->reference_location();
+    particle->remove_cell();
+    REQUIRE(particle->assign_cell_xi(cell, xi) == true);
+    REQUIRE(particle->cell_id() == cell->id());
+    REQUIRE(cell->nparticles() == 1);
+    for (unsigned i = 0; i < Dim; ++i)
+      REQUIRE(particle->reference_location()(i) ==
+              Approx(xi(i)).epsilon(Tolerance));
+    REQUIRE(particle->assign_cell_xi(nullptr, xi) == false);
   }
 
   //! Test particle, cell and node functions
@@ -0,0 +1,250 @@
+#include <chrono>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#endif
+
+#include <tbb/parallel_for.h>
+
+#include "catch.hpp"
+
+#include "json.hpp"
+#include "perf_counters.h"
+#include "profiler.h"
+
+namespace {
+//! Pointers escape to a volatile, so that allocations are not elided
+void* volatile escaped = nullptr;
+}  // namespace
+
+// Check Profiler
+TEST_CASE("Profiler is checked", "[Profiler]") {
+  using Clock = mpm::Profiler::Clock;
+  using std::chrono::milliseconds;
+
+  // Tolerance
+  const double Tolerance = 1.E-9;
+
+  SECTION("Check summary of stages") {
+    mpm::Profiler profiler;
+    const auto start = Clock::now();
+    // Two steps of 10 ms with a stage of 1 ms and 3 ms
+    for (unsigned i = 0; i < 2; ++i) {
+      profiler.record("step", start, start + milliseconds(10));
+      profiler.record("stress", start, start + milliseconds(1 + 2 * i));
+    }
+
+    const auto summary = profiler.summary();
+    REQUIRE(summary["reference"] == "step");
+    const auto stages = summary["stages"];
+    REQUIRE(stages.size() == 2);
+
+    // Stages are in the order of their first record
+    REQUIRE(stages[0]["stage"] == "step");
+    REQUIRE(stages[0]["calls"] == 2);
+    REQUIRE(stages[0]["share"].get<double>() ==
+            Approx(1.).epsilon(Tolerance));
+
+    REQUIRE(stages[1]["stage"] == "stress");
+    REQUIRE(stages[1]["calls"] == 2);
+    REQUIRE(stages[1]["total_ms"].get<double>() ==
+            Approx(4.).epsilon(Tolerance));
+    REQUIRE(stages[1]["mean_ms"].get<double>() ==
+            Approx(2.).epsilon(Tolerance));
+    REQUIRE(stages[1]["p99_ms"].get<double>() ==
+            Approx(3.).epsilon(Tolerance));
+    REQUIRE(stages[1]["share"].get<double>() ==
+            Approx(0.2).epsilon(Tolerance));
+
+    // Shares are zero without the reference stage
+    REQUIRE(profiler.summary("missing")["stages"][1]["share"] == 0.);
+
+    // Write summary
+    profiler.write_summary("profile-summary.json");
+    std::ifstream file("profile-summary.json");
+    nlohmann::json written;
+    file >> written;
+    REQUIRE(written == summary);
+
+    // Profiler without a trace keeps no events
+    REQUIRE(profiler.trace() == false);
+    profiler.write_trace("profile-empty-trace.json");
+    std::ifstream trace_file("profile-empty-trace.json");
+    nlohmann::json trace;
+    trace_file >> trace;
+    REQUIRE(trace["traceEvents"].size() == 0);
+  }
+
+  SECTION("Check trace of threads") {
+    mpm::Profiler profiler(true);
+    {
+      mpm::ScopedTimer timer(&profiler, "main");
+      std::thread worker([&profiler]() {
+        mpm::ScopedTimer timer(&profiler, "worker");
+      });
+      worker.join();
+    }
+    // A null profiler records nothing
+    { mpm::ScopedTimer timer(nullptr, "ignored"); }
+
+    profiler.write_trace("profile-trace.json");
+    std::ifstream file("profile-trace.json");
+    nlohmann::json trace;
+    file >> trace;
+    const auto events = trace["traceEvents"];
+    REQUIRE(events.size() == 2);
+
+    // Worker completes first, threads have their own rows
+    REQUIRE(events[0]["name"] == "worker");
+    REQUIRE(events[1]["name"] == "main");
+    REQUIRE(events[0]["ph"] == "X");
+    REQUIRE(events[0]["tid"] != events[1]["tid"]);
+    // Worker is nested in main
+    REQUIRE(events[0]["ts"].get<double>() >= events[1]["ts"].get<double>());
+    REQUIRE(events[0]["dur"].get<double>() <= events[1]["dur"].get<double>());
+  }
+
+  SECTION("Check summary of allocations") {
+    mpm::Profiler profiler;
+    const auto start = Clock::now();
+    mpm::Allocations allocations;
+    allocations.calls = 3;
+    allocations.bytes = 96;
+    for (unsigned i = 0; i < 2; ++i) {
+      profiler.record("step", start, start + milliseconds(10), {},
+                      &allocations);
+      profiler.record("stress", start, start + milliseconds(1));
+    }
+
+    const auto stages = profiler.summary()["stages"];
+    REQUIRE(stages[0]["allocations"] == 6);
+    REQUIRE(stages[0]["allocated_bytes"] == 192);
+    REQUIRE(stages[0]["allocations_per_call"].get<double>() ==
+            Approx(3.).epsilon(Tolerance));
+    // Stages recorded without allocations have durations only
+    REQUIRE(stages[1].count("allocations") == 0);
+  }
+
+  SECTION("Check allocations of timed stages") {
+    mpm::Profiler profiler;
+    double value = 0.;
+    {
+      mpm::ScopedTimer timer(&profiler, "allocate");
+      std::vector<double> values(128, 1.);
+      escaped = values.data();
+      value = values.back();
+    }
+    REQUIRE(value == Approx(1.).epsilon(Tolerance));
+    // Bookkeeping of nested timers is not counted
+    {
+      mpm::ScopedTimer timer(&profiler, "outer");
+      mpm::ScopedTimer inner(&profiler, "inner_stage_with_a_long_name");
+    }
+
+    const auto stages = profiler.summary()["stages"];
+    if (mpm::allocation_tracking()) {
+      REQUIRE(stages[0]["allocations"] == 1);
+      REQUIRE(stages[0]["allocated_bytes"] == 128 * sizeof(double));
+      REQUIRE(stages[1]["stage"] == "inner_stage_with_a_long_name");
+      REQUIRE(stages[1]["allocations"] == 0);
+      REQUIRE(stages[2]["allocations"] == 0);
+    } else {
+      for (const auto& stage : stages) REQUIRE(stage.count("allocations") == 0);
+    }
+  }
+
+  SECTION("Check failed writes") {
+    mpm::Profiler profiler;
+    REQUIRE_THROWS(profiler.write_summary("missing-folder/profile.json"));
+    REQUIRE_THROWS(profiler.write_trace("missing-folder/trace.json"));
+  }
+
+  // Software events stand in for hardware events, which are unavailable in
+  // virtual machines and restricted containers
+#ifdef __linux__
+  const std::vector<mpm::PerfEvent> events = {
+      {"cycles", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+      {"instructions", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_CLOCK},
+      {"unknown", PERF_TYPE_SOFTWARE, 1000},
+      {"llc_misses", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS}};
+#else
+  const std::vector<mpm::PerfEvent> events;
+#endif
+
+  SECTION("Check counters of threads") {
+    mpm::PerfCounters counters(events);
+    // Counting is unsupported without perf_event_open
+    if (counters.names().empty()) {
+      REQUIRE(counters.read().empty());
+      return;
+    }
+
+    // Unknown events are left out
+    REQUIRE(counters.names() == std::vector<std::string>(
+                                    {"cycles", "instructions", "llc_misses"}));
+
+    // Counts of threads of the scheduler are summed
+    const auto start = counters.read();
+    REQUIRE(start.size() == 3);
+    tbb::parallel_for(0, 64, [](int) {
+      const auto end = std::chrono::steady_clock::now() + milliseconds(2);
+      while (std::chrono::steady_clock::now() < end) {
+      }
+    });
+    const auto end = counters.read();
+    // Task clock in nanoseconds, workers count from their first task
+    REQUIRE(end[0] - start[0] >= 2.E6);
+    for (unsigned i = 0; i < 3; ++i) REQUIRE(end[i] >= start[i]);
+
+    // Hardware events of any system have names
+    for (const auto& event : mpm::PerfCounters::hardware_events())
+      REQUIRE(!event.name.empty());
+  }
+
+  SECTION("Check summary of counters") {
+    mpm::Profiler profiler;
+    // Without counters stages have durations only
+    profiler.record("step", Clock::now(), Clock::now(), {1., 2., 3.});
+    REQUIRE(profiler.counters() == nullptr);
+    REQUIRE(profiler.summary()["stages"][0].count("cycles") == 0);
+    REQUIRE(profiler.summary().count("counters") == 0);
+
+    if (!profiler.enable_counters(events)) {
+      REQUIRE(profiler.counters() == nullptr);
+      return;
+    }
+
+    // Two steps of 100 particles
+    profiler.assign_particles(100);
+    const auto start = Clock::now();
+    for (unsigned i = 0; i < 2; ++i)
+      profiler.record("stress", start, start + milliseconds(1),
+                      {1000., 1500., 25.});
+    // Stages recorded without counts have durations only
+    profiler.record("output", start, start + milliseconds(1));
+    { mpm::ScopedTimer timer(&profiler, "scope"); }
+
+    const auto summary = profiler.summary();
+    REQUIRE(summary["particles"] == 100);
+    REQUIRE(summary["counters"].size() == 3);
+
+    const auto stress = summary["stages"][1];
+    REQUIRE(stress["stage"] == "stress");
+    REQUIRE(stress["cycles"].get<double>() == Approx(2000.).epsilon(Tolerance));
+    REQUIRE(stress["instructions"].get<double>() ==
+            Approx(3000.).epsilon(Tolerance));
+    REQUIRE(stress["ipc"].get<double>() == Approx(1.5).epsilon(Tolerance));
+    // A cache line per miss
+    REQUIRE(stress["llc_miss_bytes"].get<double>() ==
+            Approx(3200.).epsilon(Tolerance));
+    REQUIRE(stress["bytes_per_particle_update"].get<double>() ==
+            Approx(16.).epsilon(Tolerance));
+
+    REQUIRE(summary["stages"][2].count("cycles") == 0);
+    REQUIRE(summary["stages"][3].count("cycles") == 1);
+    REQUIRE(summary["stages"][3]["cycles"].get<double>() >= 0.);
+  }
+}
@@ -0,0 +1,195 @@
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+
+#include "catch.hpp"
+
+#include "read_mesh_ascii.h"
+#include "read_mesh_ascii_parallel.h"
+
+// Check ReadMeshAsciiParallel
+TEST_CASE("ReadMeshAsciiParallel is checked for 2D",
+          "[ReadMesh][ReadMeshAsciiParallel][2D]") {
+
+  // Dimension
+  const unsigned dim = 2;
+  // Tolerance
+  const double Tolerance = 1.E-7;
+
+  SECTION("Check mesh file") {
+    // Nodal coordinates
+    std::vector<Eigen::Matrix<double, dim, 1>> coordinates;
+    Eigen::Matrix<double, dim, 1> node;
+    node << 0., 0.;
+    coordinates.emplace_back(node);
+    node << 0.5, 0.;
+    coordinates.emplace_back(node);
+    node << 0.5, 0.5;
+    coordinates.emplace_back(node);
+    node << 0., 0.5;
+    coordinates.emplace_back(node);
+    node << 1.0, 0.;
+    coordinates.emplace_back(node);
+    node << 1.0, 0.5;
+    coordinates.emplace_back(node);
+
+    // Cell with node ids
+    std::vector<std::vector<mpm::Index>> cells{// cell #0
+                                               {0, 1, 2, 3},
+                                               // cell #1
+                                               {1, 4, 5, 2}};
+
+    // Dump mesh file with comments and blank lines as an input file
+    std::ofstream file;
+    file.open("mesh-parallel-2d.txt");
+    file << "! elementShape quadrilateral\n";
+    file << "! elementNumPoints 4\n";
+    file << coordinates.size() << "\t" << cells.size() << "\n";
+    for (const auto& coord : coordinates) {
+      for (unsigned i = 0; i < coord.size(); ++i) file << coord[i] << "\t";
+      file << "\n";
+    }
+    file << "\n# cells\n";
+    for (const auto& cell : cells) {
+      for (auto nid : cell) file << nid << "\t";
+      file << "\n";
+    }
+    file.close();
+
+    // Chunk sizes smaller than a line and larger than the file
+    for (const std::size_t chunk_size : {1, 7, 16, 1 << 20}) {
+      auto read_mesh =
+          std::make_unique<mpm::ReadMeshAsciiParallel<dim>>(chunk_size);
+
+      // Try to read mesh from a non-existant file
+      auto mesh = read_mesh->read_mesh("mesh-missing.txt");
+      REQUIRE(mesh.first.size() == 0);
+      REQUIRE(mesh.second.size() == 0);
+
+      // Read nodes and cells in a single pass
+      mesh = read_mesh->read_mesh("mesh-parallel-2d.txt");
+      REQUIRE(mesh.first.size() == coordinates.size());
+      for (unsigned i = 0; i < coordinates.size(); ++i)
+        for (unsigned j = 0; j < dim; ++j)
+          REQUIRE(mesh.first[i][j] ==
+                  Approx(coordinates[i][j]).epsilon(Tolerance));
+
+      REQUIRE(mesh.second == cells);
+
+      // Read nodes and cells separately
+      REQUIRE(read_mesh->read_mesh_nodes("mesh-parallel-2d.txt").size() ==
+              coordinates.size());
+      REQUIRE(read_mesh->read_mesh_cells("mesh-parallel-2d.txt") == cells);
+    }
+
+    // Check results match the serial ascii reader
+    auto read_mesh_ascii = std::make_unique<mpm::ReadMeshAscii<dim>>();
+    auto read_mesh = std::make_unique<mpm::ReadMeshAsciiParallel<dim>>();
+    REQUIRE(read_mesh->read_mesh_cells("mesh-parallel-2d.txt") ==
+            read_mesh_ascii->read_mesh_cells("mesh-parallel-2d.txt"));
+  }
+
+  SECTION("Check particles file") {
+    // Particle coordinates written with different notations
+    std::ofstream file;
+    file.open("particles-parallel-2d.txt");
+    file << "0.125\t0.125\n";
+    file << "  -2.5E-1 1.25e+2\n";
+    file << "# comment\n";
+    file << "0.12345678901234567890123 3\r\n";
+    file << "1e400\t+4.";
+    file.close();
+
+    for (const std::size_t chunk_size : {1, 10, 1 << 20}) {
+      auto read_mesh =
+          std::make_unique<mpm::ReadMeshAsciiParallel<dim>>(chunk_size);
+
+      // Try to read particles from a non-existant file
+      REQUIRE(read_mesh->read_particles("particles-missing.txt").size() == 0);
+
+      auto particles = read_mesh->read_particles("particles-parallel-2d.txt");
+      REQUIRE(particles.size() == 4);
+      REQUIRE(particles[0][0] == 0.125);
+      REQUIRE(particles[0][1] == 0.125);
+      REQUIRE(particles[1][0] == -0.25);
+      REQUIRE(particles[1][1] == 125.);
+      REQUIRE(particles[2][0] ==
+              std::strtod("0.12345678901234567890123", nullptr));
+      REQUIRE(particles[2][1] == 3.);
+      REQUIRE(std::isinf(particles[3][0]));
+      REQUIRE(particles[3][1] == 4.);
+    }
+
+    // Invalid numbers return no particles
+    file.open("particles-invalid-2d.txt");
+    file << "0.125\tx\n";
+    file.close();
+    auto read_mesh = std::make_unique<mpm::ReadMeshAsciiParallel<dim>>();
+    REQUIRE(read_mesh->read_particles("particles-invalid-2d.txt").size() == 0);
+  }
+
+  SECTION("Check velocity constraints file") {
+    std::ofstream file;
+    file.open("velocity-constraints-parallel-2d.txt");
+    file << "0\t0\t10.5\n";
+    file << "1\t1\t-10.5\n";
+    file << "2\t0\t-12.5\n";
+    file << "3\t1\t0\n";
+    file.close();
+
+    auto read_mesh = std::make_unique<mpm::ReadMeshAsciiParallel<dim>>(8);
+    auto constraints = read_mesh->read_velocity_constraints(
+        "velocity-constraints-parallel-2d.txt");
+    REQUIRE(constraints.size() == 4);
+    REQUIRE(constraints[1] == std::make_tuple(1ULL, 1U, -10.5));
+    REQUIRE(constraints[2] == std::make_tuple(2ULL, 0U, -12.5));
+    REQUIRE(constraints[3] == std::make_tuple(3ULL, 1U, 0.));
+  }
+}
+
+// Check ReadMeshAsciiParallel
+TEST_CASE("ReadMeshAsciiParallel is checked for 3D",
+          "[ReadMesh][ReadMeshAsciiParallel][3D]") {
+
+  // Dimension
+  const unsigned dim = 3;
+
+  // Structured mesh of nx x nx x nx cells
+  const unsigned nx = 6;
+  const unsigned np = nx + 1;
+
+  // Dump mesh file as an input file to be read
+  std::ofstream file;
+  file.open("mesh-parallel-3d.txt");
+  file << "! elementShape hexahedron\n";
+  file << np * np * np << "\t" << nx * nx * nx << "\n";
+  for (unsigned k = 0; k < np; ++k)
+    for (unsigned j = 0; j < np; ++j)
+      for (unsigned i = 0; i < np; ++i)
+        file << i * 0.25 << "\t" << j * 0.25 << "\t" << k * 0.25 << "\n";
+  for (unsigned k = 0; k < nx; ++k)
+    for (unsigned j = 0; j < nx; ++j)
+      for (unsigned i = 0; i < nx; ++i) {
+        const unsigned n0 = k * np * np + j * np + i;
+        file << n0 << "\t" << n0 + 1 << "\t" << n0 + np + 1 << "\t" << n0 + np
+             << "\t" << n0 + np * np << "\t" << n0 + np * np + 1 << "\t"
+             << n0 + np * np + np + 1 << "\t" << n0 + np * np + np << "\n";
+      }
+  file.close();
+
+  // Read mesh with the serial ascii reader
+  auto read_mesh_ascii = std::make_unique<mpm::ReadMeshAscii<dim>>();
+  const auto coordinates =
+      read_mesh_ascii->read_mesh_nodes("mesh-parallel-3d.txt");
+  const auto cells = read_mesh_ascii->read_mesh_cells("mesh-parallel-3d.txt");
+  REQUIRE(coordinates.size() == np * np * np);
+  REQUIRE(cells.size() == nx * nx * nx);
+
+  // Read mesh in parallel with many chunks
+  auto read_mesh = std::make_unique<mpm::ReadMeshAsciiParallel<dim>>(256);
+  const auto mesh = read_mesh->read_mesh("mesh-parallel-3d.txt");
+  REQUIRE(mesh.first.size() == coordinates.size());
+  for (unsigned i = 0; i < coordinates.size(); ++i)
+    REQUIRE(mesh.first[i] == coordinates[i]);
+  REQUIRE(mesh.second == cells);
+}
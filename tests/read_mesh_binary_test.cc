@@ -0,0 +1,134 @@
+#include <fstream>
+
+#include "catch.hpp"
+
+#include "mesh_binary_format.h"
+#include "read_mesh_binary.h"
+
+// Check ReadMeshBinary
+TEST_CASE("ReadMeshBinary is checked for 2D",
+          "[ReadMesh][ReadMeshBinary][2D]") {
+
+  // Dimension
+  const unsigned dim = 2;
+
+  SECTION("Check mesh file") {
+    // Nodal coordinates
+    std::vector<Eigen::Matrix<double, dim, 1>> coordinates;
+    Eigen::Matrix<double, dim, 1> node;
+    node << 0., 0.;
+    coordinates.emplace_back(node);
+    node << 0.5, 0.;
+    coordinates.emplace_back(node);
+    node << 0.5, 0.5;
+    coordinates.emplace_back(node);
+    node << 0., 0.5;
+    coordinates.emplace_back(node);
+    node << 1.0, 0.;
+    coordinates.emplace_back(node);
+    node << 1.0, 0.5;
+    coordinates.emplace_back(node);
+
+    // Cell with node ids
+    std::vector<std::vector<mpm::Index>> cells{// cell #0
+                                               {0, 1, 2, 3},
+                                               // cell #1
+                                               {1, 4, 5, 2}};
+
+    mpm::binary::write_mesh<dim>("mesh-2d.bin", coordinates, cells);
+
+    auto read_mesh = std::make_unique<mpm::ReadMeshBinary<dim>>();
+
+    // Try to read mesh from a non-existant file
+    REQUIRE(read_mesh->read_mesh_nodes("mesh-missing.bin").size() == 0);
+    REQUIRE(read_mesh->read_mesh_cells("mesh-missing.bin").size() == 0);
+
+    // Check nodes and cells
+    REQUIRE(read_mesh->read_mesh_nodes("mesh-2d.bin") == coordinates);
+    REQUIRE(read_mesh->read_mesh_cells("mesh-2d.bin") == cells);
+    const auto mesh = read_mesh->read_mesh("mesh-2d.bin");
+    REQUIRE(mesh.first == coordinates);
+    REQUIRE(mesh.second == cells);
+
+    // Check a 2D file is not read as 3D
+    auto read_mesh_3d = std::make_unique<mpm::ReadMeshBinary<3>>();
+    REQUIRE(read_mesh_3d->read_mesh_nodes("mesh-2d.bin").size() == 0);
+
+    // Check particles are not present in a mesh file
+    REQUIRE(read_mesh->read_particles("mesh-2d.bin").size() == 0);
+
+    // Check cells with different number of nodes are not written
+    cells.emplace_back(std::vector<mpm::Index>{1, 4, 5});
+    REQUIRE_THROWS(
+        mpm::binary::write_mesh<dim>("mesh-invalid.bin", coordinates, cells));
+  }
+
+  SECTION("Check ascii files are not read") {
+    std::ofstream file;
+    file.open("mesh-ascii-2d.bin");
+    file << "2\t1\n0.\t0.\n1.\t0.\n0\t1\n";
+    file.close();
+
+    auto read_mesh = std::make_unique<mpm::ReadMeshBinary<dim>>();
+    REQUIRE(read_mesh->read_mesh_nodes("mesh-ascii-2d.bin").size() == 0);
+  }
+
+  SECTION("Check particles file") {
+    std::vector<Eigen::Matrix<double, dim, 1>> coordinates;
+    Eigen::Matrix<double, dim, 1> particle;
+    particle << 0.125, 0.125;
+    coordinates.emplace_back(particle);
+    particle << 0.25, 0.125;
+    coordinates.emplace_back(particle);
+    particle << 0.675, 0.25;
+    coordinates.emplace_back(particle);
+
+    mpm::binary::write_particles<dim>("particles-2d.bin", coordinates);
+
+    auto read_mesh = std::make_unique<mpm::ReadMeshBinary<dim>>();
+    REQUIRE(read_mesh->read_particles("particles-2d.bin") == coordinates);
+  }
+
+  SECTION("Check velocity constraints file") {
+    std::vector<std::tuple<mpm::Index, unsigned, double>> velocity_constraints;
+    velocity_constraints.emplace_back(std::make_tuple(0, 0, 10.5));
+    velocity_constraints.emplace_back(std::make_tuple(1, 1, -10.5));
+    velocity_constraints.emplace_back(std::make_tuple(2, 0, -12.5));
+    velocity_constraints.emplace_back(std::make_tuple(3, 1, 0.0));
+
+    mpm::binary::write_velocity_constraints<dim>("velocity-constraints-2d.bin",
+                                                 velocity_constraints);
+
+    auto read_mesh = std::make_unique<mpm::ReadMeshBinary<dim>>();
+    REQUIRE(read_mesh->read_velocity_constraints(
+                "velocity-constraints-2d.bin") == velocity_constraints);
+  }
+}
+
+// Check ReadMeshBinary
+TEST_CASE("ReadMeshBinary is checked for 3D",
+          "[ReadMesh][ReadMeshBinary][3D]") {
+
+  // Dimension
+  const unsigned dim = 3;
+
+  // Nodal coordinates of a hexahedron
+  std::vector<Eigen::Matrix<double, dim, 1>> coordinates;
+  Eigen::Matrix<double, dim, 1> node;
+  for (unsigned k = 0; k < 2; ++k)
+    for (unsigned j = 0; j < 2; ++j)
+      for (unsigned i = 0; i < 2; ++i) {
+        node << i * 2., j * 2., k * 2.;
+        coordinates.emplace_back(node);
+      }
+  std::vector<std::vector<mpm::Index>> cells{{0, 1, 3, 2, 4, 5, 7, 6}};
+
+  mpm::binary::write_mesh<dim>("mesh-3d.bin", coordinates, cells);
+  mpm::binary::write_particles<dim>("particles-3d.bin", coordinates);
+
+  auto read_mesh = std::make_unique<mpm::ReadMeshBinary<dim>>();
+  REQUIRE(read_mesh->read_mesh_nodes("mesh-3d.bin") == coordinates);
+  REQUIRE(read_mesh->read_mesh_cells("mesh-3d.bin") == cells);
+  REQUIRE(read_mesh->read_particles("particles-3d.bin") == coordinates);
+  REQUIRE(read_mesh->read_velocity_constraints("mesh-3d.bin").size() == 0);
+}
@@ -72,6 +72,32 @@ bool write_json(unsigned dim, bool resume, const std::string& file_name) {
   return true;
 }
 
+// Write a variant of a JSON configuration file and return its IO
+std::unique_ptr<mpm::IO> write_json_variant(
+    const std::string& base, const std::string& uuid,
+    const std::string& analysis, const Json& patch,
+    const std::vector<std::string>& args) {
+  Json json_file;
+  std::ifstream input(base);
+  input >> json_file;
+  input.close();
+  json_file["analysis"]["uuid"] = uuid;
+  json_file.merge_patch(patch);
+
+  const std::string file_name = uuid + ".json";
+  std::ofstream output(file_name);
+  output << json_file.dump(2);
+  output.close();
+
+  // Arguments of the analysis, parsed when the IO is created
+  std::vector<std::string> arguments = {"./mpm", "-a", analysis, "-f",
+                                        "./",    "-i", file_name};
+  arguments.insert(arguments.end(), args.begin(), args.end());
+  std::vector<char*> argv;
+  for (auto& argument : arguments) argv.emplace_back(&argument[0]);
+  return std::make_unique<mpm::IO>(argv.size(), argv.data());
+}
+
 // Write Mesh file in 2D
 bool write_mesh_2d() {
   // Dimension